@@ -0,0 +1,130 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * benchmark of the bvh construction and traversal.
+ *
+ *  - build: construction time with one thread and with all threads.
+ *  - closest: primary rays from a camera above the scene, closest hit.
+ *  - occluded: the same rays as shadow rays, any hit.
+ *
+ * The scene is a height field with some randomly scattered small triangles above it.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+/* C++ headers */
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// include the bounding volume hierarchy.
+#define ML_INCLUDE_BVH
+
+/* user headers. */
+#include "ml/all.h"
+
+/** keep results alive. */
+static volatile unsigned sink;
+
+/** seconds taken by f. */
+template<typename F>
+double measure(F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+/** a height field of size x size quads and n random triangles. */
+std::vector<ml::vec3> make_scene(int size, std::size_t n)
+{
+    std::vector<ml::vec3> vertices;
+    vertices.reserve(6 * static_cast<std::size_t>(size) * size + 3 * n);
+
+    const auto height = [](float x, float z) -> float
+    { return 2.f * std::sin(x * 0.05f) * std::cos(z * 0.07f) + 0.5f * std::sin(x * 0.3f + z * 0.2f); };
+
+    for(int z = 0; z < size; ++z)
+    {
+        for(int x = 0; x < size; ++x)
+        {
+            const float x0 = static_cast<float>(x), x1 = x0 + 1, z0 = static_cast<float>(z), z1 = z0 + 1;
+            const ml::vec3 a{x0, height(x0, z0), z0}, b{x1, height(x1, z0), z0};
+            const ml::vec3 c{x0, height(x0, z1), z1}, d{x1, height(x1, z1), z1};
+            vertices.insert(vertices.end(), {a, b, c, b, d, c});
+        }
+    }
+
+    std::mt19937 engine{42};
+    std::uniform_real_distribution<float> position{0.f, static_cast<float>(size)}, offset{-0.5f, 0.5f};
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        const ml::vec3 c{position(engine), 3.f + offset(engine) * 4.f, position(engine)};
+        for(int k = 0; k < 3; ++k)
+        {
+            vertices.push_back(c + ml::vec3{offset(engine), offset(engine), offset(engine)});
+        }
+    }
+    return vertices;
+}
+
+int main()
+{
+    const int size = 512;
+    const std::vector<ml::vec3> vertices = make_scene(size, 100000);
+    const std::size_t triangles = vertices.size() / 3;
+
+    ml::bvh_build_options serial_options;
+    serial_options.threads = 1;
+    const double build_serial = measure([&]() { sink = static_cast<unsigned>(ml::bvh{vertices, serial_options}.get_nodes().size()); });
+
+    ml::bvh h;
+    const double build_parallel = measure([&]() { h = ml::bvh{vertices}; });
+
+    std::printf(
+      "build     %zu triangles, %zu nodes: 1 thread %7.1f ms, %u threads %7.1f ms (%.1f Mtriangles/s)\n",
+      triangles, h.get_nodes().size(), build_serial * 1e3, std::thread::hardware_concurrency(), build_parallel * 1e3,
+      static_cast<double>(triangles) / build_parallel * 1e-6);
+
+    // rays from a camera above the center of the scene.
+    const int resolution = 512;
+    std::vector<ml::line3> rays;
+    rays.reserve(static_cast<std::size_t>(resolution) * resolution);
+    const ml::vec3 eye{size * 0.5f, 40.f, -size * 0.25f};
+    for(int y = 0; y < resolution; ++y)
+    {
+        for(int x = 0; x < resolution; ++x)
+        {
+            const float u = (static_cast<float>(x) + 0.5f) / resolution - 0.5f, v = (static_cast<float>(y) + 0.5f) / resolution - 0.5f;
+            rays.push_back({eye, ml::vec3{u, -0.4f + v * 0.8f, 1.f}});
+        }
+    }
+
+    unsigned hits = 0;
+    const double closest = measure(
+      [&]()
+      {
+          for(const auto& r: rays)
+          {
+              ml::ray_hit hit;
+              hits += h.intersect(r, hit);
+          }
+      });
+    unsigned occluded = 0;
+    const double any = measure(
+      [&]()
+      {
+          for(const auto& r: rays)
+          {
+              occluded += h.occluded(r);
+          }
+      });
+    sink = hits + occluded;
+
+    std::printf("closest   %zu rays, %u hits: %6.2f Mrays/s\n", rays.size(), hits, static_cast<double>(rays.size()) / closest * 1e-6);
+    std::printf("occluded  %zu rays, %u hits: %6.2f Mrays/s\n", rays.size(), occluded, static_cast<double>(rays.size()) / any * 1e-6);
+}
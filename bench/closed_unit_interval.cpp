@@ -0,0 +1,185 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * benchmark of closed_unit_interval multiplication, interpolation and conversion from float.
+ *
+ *  - float: convert to float using to_float, compute and convert back.
+ *  - scalar: closed_unit_interval::operator* and lerp, and the constructor.
+ *  - sse, avx2: the packed kernels multiply, lerp and quantize.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+/* C++ headers */
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/* user headers. */
+#include "ml/all.h"
+
+#if !defined(ML_SIMD_X86)
+#    error This benchmark requires the SSE backend.
+#endif
+
+/** keep results alive. */
+static volatile unsigned sink;
+
+/** best time of a few repetitions of f, in nanoseconds per operation. */
+template<typename F>
+double measure(std::size_t ops, F&& f)
+{
+    double best = 0;
+    for(int rep = 0; rep < 7; ++rep)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto end = std::chrono::steady_clock::now();
+
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(ops);
+        if(rep == 0 || ns < best)
+        {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+template<typename T>
+void run(const char* name)
+{
+    using U = ml::closed_unit_interval<T>;
+
+    const std::size_t n = 1 << 16;
+    std::mt19937_64 engine{42};
+
+    std::vector<U> t(n), a(n), b(n), out(n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        t[i] = ml::wrap(static_cast<T>(engine()));
+        a[i] = ml::wrap(static_cast<T>(engine()));
+        b[i] = ml::wrap(static_cast<T>(engine()));
+    }
+
+    // noisy values around [0,1], which hit all cases of the conversion.
+    std::vector<float> f(n);
+    std::uniform_real_distribution<float> dist{-0.25f, 1.25f};
+    for(auto& it: f)
+    {
+        it = dist(engine);
+    }
+
+    const std::span<const U> ct{t}, ca{a}, cb{b};
+
+    const double mul_float = measure(
+      n, [&]()
+      {
+          for(std::size_t i = 0; i < n; ++i)
+          {
+              out[i] = U{ml::to_float(a[i]) * ml::to_float(b[i])};
+          }
+          sink = out[n - 1].data;
+      });
+    const double mul_scalar = measure(
+      n, [&]()
+      {
+          for(std::size_t i = 0; i < n; ++i)
+          {
+              out[i] = a[i] * b[i];
+          }
+          sink = out[n - 1].data;
+      });
+    const double mul_sse = measure(
+      n, [&]()
+      {
+          ml::simd::multiply(ca, cb, out);
+          sink = out[n - 1].data;
+      });
+
+    const double lerp_float = measure(
+      n, [&]()
+      {
+          for(std::size_t i = 0; i < n; ++i)
+          {
+              out[i] = U{ml::lerp(ml::to_float(t[i]), ml::to_float(a[i]), ml::to_float(b[i]))};
+          }
+          sink = out[n - 1].data;
+      });
+    const double lerp_scalar = measure(
+      n, [&]()
+      {
+          for(std::size_t i = 0; i < n; ++i)
+          {
+              out[i] = ml::lerp(t[i], a[i], b[i]);
+          }
+          sink = out[n - 1].data;
+      });
+    const double lerp_sse = measure(
+      n, [&]()
+      {
+          ml::simd::lerp(ct, ca, cb, out);
+          sink = out[n - 1].data;
+      });
+
+    const double convert_scalar = measure(
+      n, [&]()
+      {
+          for(std::size_t i = 0; i < n; ++i)
+          {
+              out[i] = U{f[i]};
+          }
+          sink = out[n - 1].data;
+      });
+    const double convert_sse = measure(
+      n, [&]()
+      {
+          ml::simd::quantize(f, out);
+          sink = out[n - 1].data;
+      });
+
+    std::printf("%-11s multiply  float %6.3f ns   scalar %6.3f ns   sse %6.3f ns", name, mul_float, mul_scalar, mul_sse);
+#if defined(ML_SIMD_AVX2)
+    const double mul_avx = measure(
+      n, [&]()
+      {
+          ml::avx::multiply(ca, cb, out);
+          sink = out[n - 1].data;
+      });
+    std::printf("   avx2 %6.3f ns", mul_avx);
+#endif
+    std::printf("\n");
+
+    std::printf("%-11s lerp      float %6.3f ns   scalar %6.3f ns   sse %6.3f ns", name, lerp_float, lerp_scalar, lerp_sse);
+#if defined(ML_SIMD_AVX2)
+    const double lerp_avx = measure(
+      n, [&]()
+      {
+          ml::avx::lerp(ct, ca, cb, out);
+          sink = out[n - 1].data;
+      });
+    std::printf("   avx2 %6.3f ns", lerp_avx);
+#endif
+    std::printf("\n");
+
+    std::printf("%-11s convert                 scalar %6.3f ns   sse %6.3f ns", name, convert_scalar, convert_sse);
+#if defined(ML_SIMD_AVX2)
+    const double convert_avx = measure(
+      n, [&]()
+      {
+          ml::avx::quantize(f, out);
+          sink = out[n - 1].data;
+      });
+    std::printf("   avx2 %6.3f ns", convert_avx);
+#endif
+    std::printf("\n");
+}
+
+int main()
+{
+    run<std::uint8_t>("fixed_8_t");
+    run<std::uint16_t>("fixed_16_t");
+    run<std::uint32_t>("fixed_32_t");
+}
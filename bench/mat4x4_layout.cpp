@@ -0,0 +1,200 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * benchmark of the row-major simd::mat4x4 against the column-major simd::mat4x4_cm.
+ *
+ *  - vector-heavy: transform many vectors by one matrix.
+ *  - matrix-heavy: multiply chains of matrices, transform one vector per chain.
+ *  - crossover: transform k vectors by each matrix of a stream of row-major matrices.
+ *    The column-major version has to convert each matrix first.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+/* C++ headers */
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/* user headers. */
+#include "ml/all.h"
+
+#if !defined(ML_SIMD_X86)
+#    error This benchmark requires the SSE backend.
+#endif
+
+/** keep results alive. */
+static volatile float sink;
+
+/** best time of a few repetitions of f, in nanoseconds per operation. */
+template<typename F>
+double measure(std::size_t ops, F&& f)
+{
+    double best = 0;
+    for(int rep = 0; rep < 7; ++rep)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto end = std::chrono::steady_clock::now();
+
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(ops);
+        if(rep == 0 || ns < best)
+        {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+static std::mt19937 engine{42};
+static std::uniform_real_distribution<float> dist{-1, 1};
+
+ml::simd::vec4 random_vec4()
+{
+    return {dist(engine), dist(engine), dist(engine), dist(engine)};
+}
+
+ml::simd::mat4x4 random_mat4x4()
+{
+    return {random_vec4(), random_vec4(), random_vec4(), random_vec4()};
+}
+
+void vector_heavy()
+{
+    const std::size_t n = 1 << 16;
+    std::vector<ml::simd::vec4> in(n), out(n);
+    for(auto& v: in)
+    {
+        v = random_vec4();
+    }
+
+    const ml::simd::mat4x4 m = random_mat4x4();
+    const ml::simd::mat4x4_cm m_cm{m};
+
+    const double t_rm = measure(
+      n, [&]()
+      {
+          for(std::size_t i = 0; i < n; ++i)
+          {
+              out[i] = m * in[i];
+          }
+          sink = out[n - 1].x;
+      });
+    const double t_cm = measure(
+      n, [&]()
+      {
+          for(std::size_t i = 0; i < n; ++i)
+          {
+              out[i] = m_cm * in[i];
+          }
+          sink = out[n - 1].x;
+      });
+
+    std::printf("vector-heavy (matrix * vector)      row-major %6.2f ns   column-major %6.2f ns\n", t_rm, t_cm);
+}
+
+void matrix_heavy()
+{
+    const std::size_t chains = 1 << 12, length = 8;
+    std::vector<ml::simd::mat4x4> m(chains * length);
+    for(auto& it: m)
+    {
+        it = random_mat4x4();
+    }
+    std::vector<ml::simd::mat4x4_cm> m_cm(m.begin(), m.end());
+
+    const ml::simd::vec4 v = random_vec4();
+
+    const double t_rm = measure(
+      chains * length, [&]()
+      {
+          float acc = 0;
+          for(std::size_t c = 0; c < chains; ++c)
+          {
+              ml::simd::mat4x4 p = m[c * length];
+              for(std::size_t i = 1; i < length; ++i)
+              {
+                  p *= m[c * length + i];
+              }
+              const ml::simd::vec4 r = p * v;
+              acc += r.x + r.y + r.z + r.w;
+          }
+          sink = acc;
+      });
+    const double t_cm = measure(
+      chains * length, [&]()
+      {
+          float acc = 0;
+          for(std::size_t c = 0; c < chains; ++c)
+          {
+              ml::simd::mat4x4_cm p = m_cm[c * length];
+              for(std::size_t i = 1; i < length; ++i)
+              {
+                  p *= m_cm[c * length + i];
+              }
+              const ml::simd::vec4 r = p * v;
+              acc += r.x + r.y + r.z + r.w;
+          }
+          sink = acc;
+      });
+
+    std::printf("matrix-heavy (matrix * matrix)      row-major %6.2f ns   column-major %6.2f ns\n", t_rm, t_cm);
+}
+
+void crossover()
+{
+    const std::size_t matrices = 1 << 10, max_k = 64;
+    std::vector<ml::simd::mat4x4> m(matrices);
+    for(auto& it: m)
+    {
+        it = random_mat4x4();
+    }
+    std::vector<ml::simd::vec4> in(max_k), out(max_k);
+    for(auto& v: in)
+    {
+        v = random_vec4();
+    }
+
+    // the results are accumulated, so that no matrix can be skipped.
+    std::printf("crossover (row-major matrices, k vectors per matrix, time per vector):\n");
+    for(std::size_t k = 1; k <= max_k; k *= 2)
+    {
+        const double t_rm = measure(
+          matrices * k, [&]()
+          {
+              for(std::size_t j = 0; j < matrices; ++j)
+              {
+                  for(std::size_t i = 0; i < k; ++i)
+                  {
+                      out[i] += m[j] * in[i];
+                  }
+              }
+              sink = out[k - 1].x;
+          });
+        const double t_cm = measure(
+          matrices * k, [&]()
+          {
+              for(std::size_t j = 0; j < matrices; ++j)
+              {
+                  const ml::simd::mat4x4_cm m_cm{m[j]};
+                  for(std::size_t i = 0; i < k; ++i)
+                  {
+                      out[i] += m_cm * in[i];
+                  }
+              }
+              sink = out[k - 1].x;
+          });
+
+        std::printf("  k = %2zu                             row-major %6.2f ns   column-major %6.2f ns\n", k, t_rm, t_cm);
+    }
+}
+
+int main()
+{
+    vector_heavy();
+    matrix_heavy();
+    crossover();
+}
@@ -0,0 +1,364 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * axis-aligned bounding boxes.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+/**
+ * 3-dimensional axis-aligned bounding box. A box is empty if min > max in any component,
+ * and a default-constructed box is empty and neutral for merge.
+ */
+struct aabb3
+{
+    vec3 min{std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()};
+    vec3 max{-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()};
+
+    aabb3() = default;
+
+    aabb3(const vec3& in_min, const vec3& in_max)
+    : min{in_min}
+    , max{in_max}
+    {
+    }
+
+    aabb3(const aabb3&) = default;
+    aabb3& operator=(const aabb3&) = default;
+
+    /** box from its center and its extent, i.e. half of its size. */
+    static aabb3 from_center_extent(const vec3& c, const vec3& e)
+    {
+        return {c - e, c + e};
+    }
+
+    bool empty() const
+    {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+
+    vec3 center() const
+    {
+        return (min + max) * 0.5f;
+    }
+
+    /** half of the size. */
+    vec3 extent() const
+    {
+        return (max - min) * 0.5f;
+    }
+
+    /** surface area, or 0 for empty boxes. */
+    float surface_area() const
+    {
+        if(empty())
+        {
+            return 0.f;
+        }
+        const vec3 d = max - min;
+        return 2.f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    /** extend the box to contain a point. */
+    void merge(const vec3& p)
+    {
+        min = {std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z)};
+        max = {std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z)};
+    }
+
+    /** extend the box to contain another box. */
+    void merge(const aabb3& b)
+    {
+        min = {std::min(min.x, b.min.x), std::min(min.y, b.min.y), std::min(min.z, b.min.z)};
+        max = {std::max(max.x, b.max.x), std::max(max.y, b.max.y), std::max(max.z, b.max.z)};
+    }
+
+    /** smallest box containing both boxes. */
+    aabb3 united(const aabb3& b) const
+    {
+        aabb3 r = *this;
+        r.merge(b);
+        return r;
+    }
+
+    /** intersection of both boxes. The result is empty if the boxes do not intersect. */
+    aabb3 intersection(const aabb3& b) const
+    {
+        return {
+          {std::max(min.x, b.min.x), std::max(min.y, b.min.y), std::max(min.z, b.min.z)},
+          {std::min(max.x, b.max.x), std::min(max.y, b.max.y), std::min(max.z, b.max.z)}};
+    }
+
+    /** whether the boxes intersect, including touching boundaries. */
+    bool intersects(const aabb3& b) const
+    {
+        return min.x <= b.max.x && b.min.x <= max.x
+               && min.y <= b.max.y && b.min.y <= max.y
+               && min.z <= b.max.z && b.min.z <= max.z;
+    }
+
+    /** whether the box contains a point, including the boundary. */
+    bool contains(const vec3& p) const
+    {
+        return min.x <= p.x && p.x <= max.x
+               && min.y <= p.y && p.y <= max.y
+               && min.z <= p.z && p.z <= max.z;
+    }
+
+    /** whether the box contains another box. */
+    bool contains(const aabb3& b) const
+    {
+        return min.x <= b.min.x && b.max.x <= max.x
+               && min.y <= b.min.y && b.max.y <= max.y
+               && min.z <= b.min.z && b.max.z <= max.z;
+    }
+
+    /**
+     * bounding box of the box transformed by an affine matrix (Arvo). The center is transformed
+     * as a point, and the extent by the component-wise absolute value of the linear part, which
+     * gives the same box as transforming all eight corners. The last row of m is ignored. Empty
+     * boxes are returned unchanged.
+     */
+    aabb3 transformed(const mat4x4& m) const
+    {
+        if(empty())
+        {
+            return *this;
+        }
+
+        const vec3 c = center(), e = extent();
+
+        vec3 tc, te;
+        for(int i = 0; i < 3; ++i)
+        {
+            const vec4& r = m.rows[i];
+            tc[i] = r.x * c.x + r.y * c.y + r.z * c.z + r.w;
+            te[i] = std::abs(r.x) * e.x + std::abs(r.y) * e.y + std::abs(r.z) * e.z;
+        }
+        return from_center_extent(tc, te);
+    }
+};
+
+/**
+ * axis-aligned bounding box padded to two 4d vectors, so that it can be loaded into SIMD
+ * registers directly. The w components are ignored.
+ */
+struct alignas(16) aligned_aabb3
+{
+    vec4 min{std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), 0.f};
+    vec4 max{-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), 0.f};
+
+    aligned_aabb3() = default;
+
+    aligned_aabb3(const vec4& in_min, const vec4& in_max)
+    : min{in_min}
+    , max{in_max}
+    {
+    }
+
+    explicit aligned_aabb3(const aabb3& b)
+    : min{b.min, 0.f}
+    , max{b.max, 0.f}
+    {
+    }
+
+    aligned_aabb3(const aligned_aabb3&) = default;
+    aligned_aabb3& operator=(const aligned_aabb3&) = default;
+
+    aabb3 unpadded() const
+    {
+        return {{min.x, min.y, min.z}, {max.x, max.y, max.z}};
+    }
+
+    bool empty() const
+    {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+
+    /** surface area, or 0 for empty boxes. */
+    float surface_area() const
+    {
+        return unpadded().surface_area();
+    }
+
+    /** extend the box to contain another box. */
+    void merge(const aligned_aabb3& b)
+    {
+#if defined(ML_USE_SIMD) && defined(ML_SIMD_X86)
+        min.data = _mm_min_ps(min.data, b.min.data);
+        max.data = _mm_max_ps(max.data, b.max.data);
+#else
+        min = {std::min(min.x, b.min.x), std::min(min.y, b.min.y), std::min(min.z, b.min.z), 0.f};
+        max = {std::max(max.x, b.max.x), std::max(max.y, b.max.y), std::max(max.z, b.max.z), 0.f};
+#endif
+    }
+
+    /** smallest box containing both boxes. */
+    aligned_aabb3 united(const aligned_aabb3& b) const
+    {
+        aligned_aabb3 r = *this;
+        r.merge(b);
+        return r;
+    }
+
+    /** intersection of both boxes. The result is empty if the boxes do not intersect. */
+    aligned_aabb3 intersection(const aligned_aabb3& b) const
+    {
+#if defined(ML_USE_SIMD) && defined(ML_SIMD_X86)
+        return {vec4{_mm_max_ps(min.data, b.min.data)}, vec4{_mm_min_ps(max.data, b.max.data)}};
+#else
+        return aligned_aabb3{unpadded().intersection(b.unpadded())};
+#endif
+    }
+
+    /** whether the boxes intersect, including touching boundaries. */
+    bool intersects(const aligned_aabb3& b) const
+    {
+#if defined(ML_USE_SIMD) && defined(ML_SIMD_X86)
+        const __m128 separated = _mm_or_ps(_mm_cmpgt_ps(min.data, b.max.data), _mm_cmpgt_ps(b.min.data, max.data));
+        return (_mm_movemask_ps(separated) & 0x7) == 0;
+#else
+        return unpadded().intersects(b.unpadded());
+#endif
+    }
+
+    /** whether the box contains another box. */
+    bool contains(const aligned_aabb3& b) const
+    {
+#if defined(ML_USE_SIMD) && defined(ML_SIMD_X86)
+        const __m128 outside = _mm_or_ps(_mm_cmpgt_ps(min.data, b.min.data), _mm_cmpgt_ps(b.max.data, max.data));
+        return (_mm_movemask_ps(outside) & 0x7) == 0;
+#else
+        return unpadded().contains(b.unpadded());
+#endif
+    }
+};
+
+#if defined(ML_SIMD_X86)
+namespace simd
+{
+
+/** transformation of axis-aligned boxes by an affine matrix. See aabb3::transformed. */
+struct aabb_transform
+{
+    /** the columns of the matrix, and the absolute values of the first three. */
+    __m128 columns[4], abs_columns[3];
+
+    explicit aabb_transform(const ml::mat4x4& m)
+    {
+        const __m128 sign = _mm_set_ps1(-0.0f);
+        for(int i = 0; i < 4; ++i)
+        {
+            columns[i] = _mm_setr_ps(m.rows[0][i], m.rows[1][i], m.rows[2][i], 0.f);
+        }
+        for(int i = 0; i < 3; ++i)
+        {
+            abs_columns[i] = _mm_andnot_ps(sign, columns[i]);
+        }
+    }
+
+    /** transform the box with the corners lo and hi in place. Empty boxes are left unchanged. */
+    void apply(__m128& lo, __m128& hi) const
+    {
+        // the center of an empty box would be inf + -inf = NaN.
+        if((_mm_movemask_ps(_mm_cmpgt_ps(lo, hi)) & 0x7) != 0)
+        {
+            return;
+        }
+
+        const __m128 half = _mm_set_ps1(0.5f);
+        const __m128 c = _mm_mul_ps(_mm_add_ps(lo, hi), half);
+        const __m128 e = _mm_mul_ps(_mm_sub_ps(hi, lo), half);
+
+        const __m128 cx = _mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m128 cy = _mm_shuffle_ps(c, c, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m128 cz = _mm_shuffle_ps(c, c, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m128 ex = _mm_shuffle_ps(e, e, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m128 ey = _mm_shuffle_ps(e, e, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m128 ez = _mm_shuffle_ps(e, e, _MM_SHUFFLE(2, 2, 2, 2));
+
+#    if defined(ML_USE_FMA)
+        const __m128 tc = _mm_fmadd_ps(columns[2], cz, _mm_fmadd_ps(columns[1], cy, _mm_fmadd_ps(columns[0], cx, columns[3])));
+        const __m128 te = _mm_fmadd_ps(abs_columns[2], ez, _mm_fmadd_ps(abs_columns[1], ey, _mm_mul_ps(abs_columns[0], ex)));
+#    else
+        const __m128 tc = _mm_add_ps(_mm_add_ps(_mm_mul_ps(columns[0], cx), _mm_mul_ps(columns[1], cy)), _mm_add_ps(_mm_mul_ps(columns[2], cz), columns[3]));
+        const __m128 te = _mm_add_ps(_mm_add_ps(_mm_mul_ps(abs_columns[0], ex), _mm_mul_ps(abs_columns[1], ey)), _mm_mul_ps(abs_columns[2], ez));
+#    endif
+
+        lo = _mm_sub_ps(tc, te);
+        hi = _mm_add_ps(tc, te);
+    }
+};
+
+} /* namespace simd */
+#endif /* defined(ML_SIMD_X86) */
+
+/** transform a padded box by an affine matrix. See aabb3::transformed. */
+inline aligned_aabb3 transformed(const aligned_aabb3& b, const mat4x4& m)
+{
+#if defined(ML_USE_SIMD) && defined(ML_SIMD_X86)
+    __m128 lo = b.min.data, hi = b.max.data;
+    simd::aabb_transform{m}.apply(lo, hi);
+    return {vec4{lo}, vec4{hi}};
+#else
+    return aligned_aabb3{b.unpadded().transformed(m)};
+#endif
+}
+
+/** transform an array of boxes by an affine matrix. in and out may be the same array. */
+inline void transform_aabbs(const mat4x4& m, std::span<const aabb3> in, std::span<aabb3> out)
+{
+    assert(in.size() <= out.size());
+
+#if defined(ML_SIMD_X86)
+    static_assert(sizeof(aabb3) == 6 * sizeof(float), "aabb3 needs to be packed");
+
+    const simd::aabb_transform t{m};
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        // the box is stored as six floats. load them as (min, max.x) and (min.z, max).
+        const float* src = &in[i].min.x;
+        __m128 lo = _mm_loadu_ps(src);
+        __m128 hi = _mm_castsi128_ps(_mm_srli_si128(_mm_castps_si128(_mm_loadu_ps(src + 2)), 4));
+        t.apply(lo, hi);
+
+        float* dst = &out[i].min.x;
+        _mm_storeu_ps(dst, lo);
+        _mm_storeu_ps(dst + 2, _mm_blend_ps(_mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(hi), 4)), _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(2, 2, 2, 2)), 0x1));
+    }
+#else
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = in[i].transformed(m);
+    }
+#endif
+}
+
+/** transform an array of padded boxes by an affine matrix. in and out may be the same array. */
+inline void transform_aabbs(const mat4x4& m, std::span<const aligned_aabb3> in, std::span<aligned_aabb3> out)
+{
+    assert(in.size() <= out.size());
+
+#if defined(ML_SIMD_X86)
+    const simd::aabb_transform t{m};
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        __m128 lo = _mm_load_ps(&in[i].min.x), hi = _mm_load_ps(&in[i].max.x);
+        t.apply(lo, hi);
+        _mm_store_ps(&out[i].min.x, lo);
+        _mm_store_ps(&out[i].max.x, hi);
+    }
+#else
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = transformed(in[i], m);
+    }
+#endif
+}
+
+} /* namespace ml */
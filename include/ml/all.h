@@ -16,6 +16,20 @@
  *   ML_NO_SIMD:      don't use SSE versions of vec4 and mat4x4
  *   ML_INCLUDE_SIMD: provide SSE and non-SSE versions of vec4 and mat4x4
  *   ML_NO_SWIZZLE:   don't define swizzle functions for vector component access.
+ *   ML_NO_FMA:       don't use fused multiply-add instructions, even if the compiler targets them.
+ *   ML_USE_AVX2:     use the AVX2/FMA versions of mat4x4 and the batch kernels.
+ *                    requires the compiler to target AVX2 and FMA (e.g. -mavx2 -mfma).
+ *   ML_USE_AVX512:   use the AVX-512 versions of the batch kernels.
+ *                    requires the compiler to target AVX-512F (e.g. -mavx512f).
+ *   ML_USE_DISPATCH: select the SSE4.1, AVX2 or AVX-512 batch kernels at runtime.
+ *                    requires GCC or Clang.
+ *   ML_USE_PORTABLE_SIMD: use the std::experimental::simd versions of vec4, mat4x4 and the
+ *                    batch kernels on x86, too. This is the default on other architectures.
+ *   ML_FAST_RCP:     use SSE estimates with one Newton-Raphson step for reciprocals and
+ *                    reciprocal square roots instead of divisions (see precision.h).
+ *   ML_FAST_RCP_ESTIMATE: use the SSE estimates without refinement.
+ *   ML_INCLUDE_BVH:  include the bounding volume hierarchy (bvh.h). Its construction uses
+ *                    std::async, so the program needs to link against the thread library.
  *
  * \author Felix Lubbe
  * \copyright Copyright (c) 2021
@@ -24,8 +38,8 @@
 
 #pragma once
 
-/* SIMD support is only available for x86 for now. */
-#if !defined(__x86_64__) && !defined(_M_X64)
+/* on other architectures than x86, SIMD support requires std::experimental::simd. */
+#if !defined(__x86_64__) && !defined(_M_X64) && !__has_include(<experimental/simd>)
 #    define ML_NO_SIMD
 #endif
 
@@ -41,7 +55,12 @@
 
 /* C++ headers */
 #    include <algorithm>
+#    include <atomic>
 #    include <cmath>
+#    include <cstdint>
+#    include <limits>
+#    include <span>
+#    include <vector>
 
 #endif /* ML_NO_CPP */
 
@@ -64,14 +83,16 @@
 
 #endif /* ML_NO_CNL */
 
-/* fixed-point unit interval. */
-#include "closed_unit_interval.h"
-
 /* enable SIMD (if not requested to disable or just include it) */
 #if !defined(ML_NO_SIMD) && !defined(ML_INCLUDE_SIMD)
 #    define ML_USE_SIMD
 #endif /* IML_INCLUDE_SIMD */
 
+/* use fused multiply-add instructions if the compiler targets them. */
+#if defined(__FMA__) && !defined(ML_NO_FMA)
+#    define ML_USE_FMA
+#endif
+
 /* check if we should include vector swizzle functions. */
 #if !defined(ML_NO_SWIZZLE)
 #    define ML_DEFINE_SWIZZLE_FUNCTIONS
@@ -82,7 +103,8 @@
  */
 #if defined(ML_USE_SIMD) || defined(ML_INCLUDE_SIMD)
 
-#    if defined(__x86_64__) || defined(_M_X64) || defined(__i386) || defined(_M_IX86)
+#    if (defined(__x86_64__) || defined(_M_X64) || defined(__i386) || defined(_M_IX86)) \
+      && !(defined(ML_USE_SIMD) && defined(ML_USE_PORTABLE_SIMD))
 
 #        define ML_SIMD_X86
 
@@ -102,9 +124,44 @@
 #include <nmmintrin.h> SSE4.2
 #include <ammintrin.h> SSE4A
 #include <wmmintrin.h> AES
-#include <immintrin.h> AVX, AVX2, FMA
 */
 
+/* AVX is used for 8-wide vector packets if enabled by the compiler. */
+#        if defined(__AVX__)
+#            define ML_USE_AVX
+#            include <immintrin.h> /* AVX, AVX2, FMA */
+#        endif
+
+/* FMA is used for products and sums if enabled by the compiler. */
+#        if defined(ML_USE_FMA)
+#            include <immintrin.h>
+#        endif
+
+/* AVX2/FMA backend. */
+#        if defined(ML_USE_AVX2)
+#            if !defined(__AVX2__) || !defined(__FMA__)
+#                error ML_USE_AVX2 requires compiler support for AVX2 and FMA.
+#            endif
+#            define ML_SIMD_AVX2
+#        endif
+
+/* AVX-512 batch kernels. */
+#        if defined(ML_USE_AVX512)
+#            if !defined(__AVX512F__)
+#                error ML_USE_AVX512 requires compiler support for AVX-512F.
+#            endif
+#            define ML_SIMD_AVX512
+#        endif
+
+/* runtime dispatch of the batch kernels. */
+#        if defined(ML_USE_DISPATCH)
+#            if !defined(__GNUC__)
+#                error ML_USE_DISPATCH requires GCC or Clang.
+#            endif
+#            define ML_SIMD_DISPATCH
+#            include <immintrin.h> /* AVX, AVX2, FMA, AVX-512 */
+#        endif
+
 #    elif defined(__aarch64__) || defined(_M_ARM64) || defined(__arm__) || defined(_M_ARM)
 
 #        define ML_SIMD_NEON
@@ -112,6 +169,12 @@
 
 #    endif
 
+/* portable backend. on x86, it is only included for verification or if requested. */
+#    if (defined(ML_INCLUDE_SIMD) || !defined(ML_SIMD_X86)) && __has_include(<experimental/simd>)
+#        define ML_SIMD_PORTABLE
+#        include <experimental/simd>
+#    endif
+
 #endif /* defined(ML_USE_SIMD) || defined(ML_INCLUDE_SIMD) */
 
 /*
@@ -121,12 +184,18 @@
 /* some mathematical constants. */
 #include "constants.h"
 
+/* fixed-point unit interval. */
+#include "closed_unit_interval.h"
+
 /* fixed point types */
 #include "fixed_point.h"
 
 /* mathematical functions that do not depend on the types included below. */
 #include "functions.h"
 
+/* precision policies for reciprocals and reciprocal square roots. */
+#include "precision.h"
+
 /* include forward declarations when using swizzle functions. */
 #if defined(ML_DEFINE_SWIZZLE_FUNCTIONS)
 #    include "forward_decl.h"
@@ -155,5 +224,48 @@
 /* mathematical functions. */
 #include "functions_vec4.h"
 
+/* batch kernels operating on arrays of vectors. */
+#include "batch.h"
+
 /* geometric objects and helper functions. */
 #include "geometry.h"
+#include "aabb.h"
+
+/* view frustum, culling and classification of points against planes. */
+#include "frustum.h"
+#if defined(ML_SIMD_X86)
+#    include "simd/plane.h"
+#    include "simd/frustum.h"
+#endif /* defined(ML_SIMD_X86) */
+#include "culling.h"
+#include "point_classification.h"
+
+/* ray intersection, and optionally the bounding volume hierarchy. */
+#include "ray.h"
+#if defined(ML_SIMD_X86)
+#    include "simd/ray.h"
+#endif /* defined(ML_SIMD_X86) */
+#if defined(ML_INCLUDE_BVH)
+#    if !defined(ML_NO_CPP)
+#        include <future>
+#        include <thread>
+#    endif /* !defined(ML_NO_CPP) */
+#    include "bvh.h"
+#endif /* defined(ML_INCLUDE_BVH) */
+
+/* triangle setup, edge functions and attribute interpolation for rasterization. */
+#include "triangle_setup.h"
+#include "interpolation.h"
+#if defined(ML_SIMD_X86)
+#    include "simd/edge_functions.h"
+#    include "simd/interpolation.h"
+#endif /* defined(ML_SIMD_X86) */
+#include "tile_coverage.h"
+
+/* depth test, tiled depth buffer and hierarchical depth pyramid. */
+#include "depth_test.h"
+#if defined(ML_SIMD_X86)
+#    include "simd/depth_test.h"
+#endif /* defined(ML_SIMD_X86) */
+#include "depth_buffer.h"
+#include "hiz_pyramid.h"
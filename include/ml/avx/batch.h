@@ -0,0 +1,575 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * batch kernels operating on arrays of vectors using AVX2 and FMA intrinsics.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+namespace avx
+{
+
+#if defined(ML_DISPATCH_TARGET_NAMESPACE)
+/* compiled for a runtime dispatch target, see dispatch/batch.h. */
+inline namespace ML_DISPATCH_TARGET_NAMESPACE
+{
+#endif
+
+/**
+ * Matrix columns for the batch transformations, broadcasted into both 128-bit
+ * lanes. This way, two vectors are transformed per instruction.
+ */
+struct mat4x4_columns
+{
+    __m256 c0, c1, c2, c3;
+
+    explicit mat4x4_columns(const mat4x4& m)
+    {
+        __m128 t0 = m.rows[0].data, t1 = m.rows[1].data, t2 = m.rows[2].data, t3 = m.rows[3].data;
+        _MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+
+        c0 = _mm256_broadcast_ps(&t0);
+        c1 = _mm256_broadcast_ps(&t1);
+        c2 = _mm256_broadcast_ps(&t2);
+        c3 = _mm256_broadcast_ps(&t3);
+    }
+
+    /** transform the two vectors stored in the lanes of v. */
+    __m256 transform(const __m256 v) const
+    {
+        const __m256 x = _mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m256 y = _mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m256 z = _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m256 w = _mm256_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3));
+
+        // same rounding as vec4::dot_product with FMA.
+        return _mm256_add_ps(
+          _mm256_fmadd_ps(c0, x, _mm256_mul_ps(c1, y)),
+          _mm256_fmadd_ps(c2, z, _mm256_mul_ps(c3, w)));
+    }
+
+    /** transform the points p0 and p1, i.e. vectors with w=1. */
+    __m256 transform_points(const vec3& p0, const vec3& p1) const
+    {
+        return _mm256_add_ps(
+          _mm256_fmadd_ps(c0, broadcast(p0.x, p1.x), _mm256_mul_ps(c1, broadcast(p0.y, p1.y))),
+          _mm256_fmadd_ps(c2, broadcast(p0.z, p1.z), c3));
+    }
+
+    /** transform the directions d0 and d1, i.e. vectors with w=0. */
+    __m256 transform_directions(const vec3& d0, const vec3& d1) const
+    {
+        return _mm256_add_ps(
+          _mm256_fmadd_ps(c0, broadcast(d0.x, d1.x), _mm256_mul_ps(c1, broadcast(d0.y, d1.y))),
+          _mm256_mul_ps(c2, broadcast(d0.z, d1.z)));
+    }
+
+    /** broadcast lo into the lower and hi into the upper 128-bit lane. */
+    static __m256 broadcast(float lo, float hi)
+    {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set_ps1(lo)), _mm_set_ps1(hi), 1);
+    }
+};
+
+/** store the first three components of v to out. */
+inline void store_xyz(vec3& out, const __m128 v)
+{
+    _mm_storel_pi(reinterpret_cast<__m64*>(&out.x), v);
+    _mm_store_ss(&out.z, _mm_movehl_ps(v, v));
+}
+
+/** transform homogeneous vectors, out[i] = m * in[i]. in and out may be the same array. */
+inline void transform(const mat4x4& m, std::span<const vec4> in, std::span<vec4> out)
+{
+    assert(out.size() >= in.size());
+
+    const mat4x4_columns cols{m};
+
+    std::size_t i = 0;
+    for(; i + 2 <= in.size(); i += 2)
+    {
+        _mm256_storeu_ps(&out[i].x, cols.transform(_mm256_loadu_ps(&in[i].x)));
+    }
+    if(i < in.size())
+    {
+        out[i].data = _mm256_castps256_ps128(cols.transform(_mm256_castps128_ps256(in[i].data)));
+    }
+}
+
+/** transform points, out[i] = m * vec4{in[i], 1}. */
+inline void transform_points(const mat4x4& m, std::span<const vec3> in, std::span<vec4> out)
+{
+    assert(out.size() >= in.size());
+
+    const mat4x4_columns cols{m};
+
+    std::size_t i = 0;
+    for(; i + 2 <= in.size(); i += 2)
+    {
+        _mm256_storeu_ps(&out[i].x, cols.transform_points(in[i], in[i + 1]));
+    }
+    if(i < in.size())
+    {
+        out[i].data = _mm256_castps256_ps128(cols.transform_points(in[i], in[i]));
+    }
+}
+
+/** transform directions, out[i] = (m * vec4{in[i], 0}).xyz(). in and out may be the same array. */
+inline void transform_directions(const mat4x4& m, std::span<const vec3> in, std::span<vec3> out)
+{
+    assert(out.size() >= in.size());
+
+    const mat4x4_columns cols{m};
+
+    std::size_t i = 0;
+    for(; i + 2 <= in.size(); i += 2)
+    {
+        const __m256 r = cols.transform_directions(in[i], in[i + 1]);
+        store_xyz(out[i], _mm256_castps256_ps128(r));
+        store_xyz(out[i + 1], _mm256_extractf128_ps(r, 1));
+    }
+    if(i < in.size())
+    {
+        store_xyz(out[i], _mm256_castps256_ps128(cols.transform_directions(in[i], in[i])));
+    }
+}
+
+/*
+ * 1/length is estimated as in the SSE kernels, see simd::rsqrt_newton.
+ */
+
+/** normalize vectors. Zero vectors are left unchanged. */
+inline void normalize(std::span<vec4> v)
+{
+    std::size_t i = 0;
+    for(; i + 8 <= v.size(); i += 8)
+    {
+        const simd::vec4x8 p = simd::vec4x8::load(v.subspan(i));
+        p.scale(simd::one_over_length_estimate(p.length_squared())).store(v.subspan(i));
+    }
+    simd::normalize(v.subspan(i));
+}
+
+/** normalize 3d vectors. Zero vectors are left unchanged. Uses the SSE kernel. */
+inline void normalize(std::span<vec3> v)
+{
+    simd::normalize(v);
+}
+
+/** vector lengths, out[i] = in[i].length(). */
+inline void lengths(std::span<const vec4> in, std::span<float> out)
+{
+    assert(out.size() >= in.size());
+
+    std::size_t i = 0;
+    for(; i + 8 <= in.size(); i += 8)
+    {
+        _mm256_storeu_ps(&out[i], simd::length_estimate(simd::vec4x8::load(in.subspan(i)).length_squared()));
+    }
+    simd::lengths(in.subspan(i), out.subspan(i));
+}
+
+/** 3d vector lengths, out[i] = in[i].length(). Uses the SSE kernel. */
+inline void lengths(std::span<const vec3> in, std::span<float> out)
+{
+    simd::lengths(in, out);
+}
+
+/** divide xyz by w and store 1/w in w. All w components have to be non-zero. */
+inline void divide_by_w(std::span<vec4> v)
+{
+    std::size_t i = 0;
+    for(; i + 2 <= v.size(); i += 2)
+    {
+        const __m256 r = _mm256_loadu_ps(&v[i].x);
+        const __m256 one_over_w = simd::rcp(_mm256_permute_ps(r, _MM_SHUFFLE(3, 3, 3, 3)));
+        _mm256_storeu_ps(&v[i].x, _mm256_blend_ps(_mm256_mul_ps(r, one_over_w), one_over_w, 0x88));
+    }
+    if(i < v.size())
+    {
+        const __m128 r = v[i].data;
+        const __m128 one_over_w = simd::rcp(_mm_permute_ps(r, _MM_SHUFFLE(3, 3, 3, 3)));
+        v[i].data = _mm_blend_ps(_mm_mul_ps(r, one_over_w), one_over_w, 0x8);
+    }
+}
+
+/**
+ * transform clip coordinates to screen coordinates: divide xyz by w, apply the viewport
+ * transformation xyz*scale + bias and store 1/w in w. All w components have to be non-zero.
+ */
+inline void clip_to_screen(std::span<vec4> v, const vec3& scale, const vec3& bias)
+{
+    const __m256 s = _mm256_setr_ps(scale.x, scale.y, scale.z, 0, scale.x, scale.y, scale.z, 0);
+    const __m256 b = _mm256_setr_ps(bias.x, bias.y, bias.z, 0, bias.x, bias.y, bias.z, 0);
+
+    std::size_t i = 0;
+    for(; i + 2 <= v.size(); i += 2)
+    {
+        const __m256 r = _mm256_loadu_ps(&v[i].x);
+        const __m256 one_over_w = simd::rcp(_mm256_permute_ps(r, _MM_SHUFFLE(3, 3, 3, 3)));
+        const __m256 screen = _mm256_fmadd_ps(_mm256_mul_ps(r, one_over_w), s, b);
+        _mm256_storeu_ps(&v[i].x, _mm256_blend_ps(screen, one_over_w, 0x88));
+    }
+    if(i < v.size())
+    {
+        const __m128 r = v[i].data;
+        const __m128 one_over_w = simd::rcp(_mm_permute_ps(r, _MM_SHUFFLE(3, 3, 3, 3)));
+        const __m128 screen = _mm_fmadd_ps(_mm_mul_ps(r, one_over_w), _mm256_castps256_ps128(s), _mm256_castps256_ps128(b));
+        v[i].data = _mm_blend_ps(screen, one_over_w, 0x8);
+    }
+}
+
+/** clamp all vector components to the interval [0,1]. */
+inline void clamp_to_unit_interval(std::span<vec4> v)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    std::size_t i = 0;
+    for(; i + 2 <= v.size(); i += 2)
+    {
+        _mm256_storeu_ps(&v[i].x, _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&v[i].x), zero), one));
+    }
+    if(i < v.size())
+    {
+        v[i].data = _mm_min_ps(_mm_max_ps(v[i].data, _mm256_castps256_ps128(zero)), _mm256_castps256_ps128(one));
+    }
+}
+
+/** clamp two colors to [0,1], scale them by 255 and round them to 32-bit integers. BGRA swaps red and blue. */
+template<bool bgra>
+inline __m256i quantize_color8(__m256 c)
+{
+    if constexpr(bgra)
+    {
+        c = _mm256_permute_ps(c, _MM_SHUFFLE(3, 0, 1, 2));
+    }
+    c = _mm256_min_ps(_mm256_max_ps(c, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+    return _mm256_cvtps_epi32(_mm256_mul_ps(c, _mm256_set1_ps(255.0f)));
+}
+
+/** pack colors into RGBA8 or BGRA8. */
+template<bool bgra>
+inline void pack_color8(std::span<const vec4> in, std::span<std::uint32_t> out)
+{
+    assert(out.size() >= in.size());
+
+    // the packs operate on 128-bit lanes, which yields the colors in the order 0, 2, 4, 6, 1, 3, 5, 7.
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    std::size_t i = 0;
+    for(; i + 8 <= in.size(); i += 8)
+    {
+        const __m256i c01 = quantize_color8<bgra>(_mm256_loadu_ps(&in[i].x));
+        const __m256i c23 = quantize_color8<bgra>(_mm256_loadu_ps(&in[i + 2].x));
+        const __m256i c45 = quantize_color8<bgra>(_mm256_loadu_ps(&in[i + 4].x));
+        const __m256i c67 = quantize_color8<bgra>(_mm256_loadu_ps(&in[i + 6].x));
+
+        const __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(c01, c23), _mm256_packs_epi32(c45, c67));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out[i]), _mm256_permutevar8x32_epi32(packed, order));
+    }
+    simd::pack_color8<bgra>(in.subspan(i), out.subspan(i));
+}
+
+/** unpack RGBA8 or BGRA8 colors. */
+template<bool bgra>
+inline void unpack_color8(std::span<const std::uint32_t> in, std::span<vec4> out)
+{
+    assert(out.size() >= in.size());
+
+    const __m256 scale = _mm256_set1_ps(1.0f / 255.0f);
+
+    std::size_t i = 0;
+    for(; i + 2 <= in.size(); i += 2)
+    {
+        const __m128i c = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&in[i]));
+        __m256 r = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(c)), scale);
+        if constexpr(bgra)
+        {
+            r = _mm256_permute_ps(r, _MM_SHUFFLE(3, 0, 1, 2));
+        }
+        _mm256_storeu_ps(&out[i].x, r);
+    }
+    simd::unpack_color8<bgra>(in.subspan(i), out.subspan(i));
+}
+
+/** pack colors into RGBA8, out[i] = pack_rgba8(in[i]). */
+inline void pack_rgba8(std::span<const vec4> in, std::span<std::uint32_t> out)
+{
+    avx::pack_color8<false>(in, out);
+}
+
+/** pack colors into BGRA8, out[i] = pack_bgra8(in[i]). */
+inline void pack_bgra8(std::span<const vec4> in, std::span<std::uint32_t> out)
+{
+    avx::pack_color8<true>(in, out);
+}
+
+/** unpack RGBA8 colors, out[i] = unpack_rgba8(in[i]). */
+inline void unpack_rgba8(std::span<const std::uint32_t> in, std::span<vec4> out)
+{
+    avx::unpack_color8<false>(in, out);
+}
+
+/** unpack BGRA8 colors, out[i] = unpack_bgra8(in[i]). */
+inline void unpack_bgra8(std::span<const std::uint32_t> in, std::span<vec4> out)
+{
+    avx::unpack_color8<true>(in, out);
+}
+
+/*
+ * closed_unit_interval arithmetic, 32 bytes at a time. See the SSE versions.
+ */
+
+/** multiply packed representations of closed_unit_interval<T>. */
+template<typename T>
+inline __m256i multiply_unit_interval(const __m256i a, const __m256i b)
+{
+    if constexpr(sizeof(T) == 1)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i half = _mm256_set1_epi16(0x80);
+
+        // unpacking and packing operate on 128-bit lanes, so the order is preserved.
+        __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero)), half);
+        __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero)), half);
+        lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8);
+        hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+        return _mm256_packus_epi16(lo, hi);
+    }
+    else if constexpr(sizeof(T) == 2)
+    {
+        const __m256i lo = _mm256_mullo_epi16(a, b);
+        const __m256i t_hi = _mm256_add_epi16(_mm256_mulhi_epu16(a, b), _mm256_srli_epi16(lo, 15));
+        const __m256i t_lo = _mm256_xor_si256(lo, _mm256_set1_epi16(static_cast<short>(0x8000)));
+
+        const __m256i overflow = _mm256_sub_epi16(_mm256_adds_epu16(t_lo, t_hi), _mm256_add_epi16(t_lo, t_hi));
+        return _mm256_add_epi16(t_hi, _mm256_min_epu16(overflow, _mm256_set1_epi16(1)));
+    }
+    else
+    {
+        const __m256i half = _mm256_set1_epi64x(0x80000000);
+        __m256i even = _mm256_add_epi64(_mm256_mul_epu32(a, b), half);
+        __m256i odd = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)), half);
+
+        even = _mm256_srli_epi64(_mm256_add_epi64(even, _mm256_srli_epi64(even, 32)), 32);
+        odd = _mm256_add_epi64(odd, _mm256_srli_epi64(odd, 32));
+        return _mm256_blend_epi32(even, odd, 0xAA);
+    }
+}
+
+/** interpolate packed representations of closed_unit_interval<T>, a*(1-t) + b*t. */
+template<typename T>
+inline __m256i lerp_unit_interval(const __m256i t, const __m256i a, const __m256i b)
+{
+    const __m256i nt = _mm256_xor_si256(t, _mm256_set1_epi32(-1));
+
+    if constexpr(sizeof(T) == 1)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i half = _mm256_set1_epi16(0x80);
+
+        __m256i lo = _mm256_add_epi16(
+          _mm256_mullo_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(nt, zero)),
+          _mm256_mullo_epi16(_mm256_unpacklo_epi8(b, zero), _mm256_unpacklo_epi8(t, zero)));
+        __m256i hi = _mm256_add_epi16(
+          _mm256_mullo_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(nt, zero)),
+          _mm256_mullo_epi16(_mm256_unpackhi_epi8(b, zero), _mm256_unpackhi_epi8(t, zero)));
+        lo = _mm256_add_epi16(lo, half);
+        hi = _mm256_add_epi16(hi, half);
+        lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8);
+        hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+        return _mm256_packus_epi16(lo, hi);
+    }
+    else if constexpr(sizeof(T) == 2)
+    {
+        const __m256i a_lo = _mm256_mullo_epi16(a, nt), a_hi = _mm256_mulhi_epu16(a, nt);
+        const __m256i b_lo = _mm256_mullo_epi16(b, t), b_hi = _mm256_mulhi_epu16(b, t);
+        const __m256i half = _mm256_set1_epi32(0x8000);
+
+        __m256i lo = _mm256_add_epi32(_mm256_add_epi32(_mm256_unpacklo_epi16(a_lo, a_hi), _mm256_unpacklo_epi16(b_lo, b_hi)), half);
+        __m256i hi = _mm256_add_epi32(_mm256_add_epi32(_mm256_unpackhi_epi16(a_lo, a_hi), _mm256_unpackhi_epi16(b_lo, b_hi)), half);
+        lo = _mm256_srli_epi32(_mm256_add_epi32(lo, _mm256_srli_epi32(lo, 16)), 16);
+        hi = _mm256_srli_epi32(_mm256_add_epi32(hi, _mm256_srli_epi32(hi, 16)), 16);
+        return _mm256_packus_epi32(lo, hi);
+    }
+    else
+    {
+        const __m256i half = _mm256_set1_epi64x(0x80000000);
+        __m256i even = _mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a, nt), _mm256_mul_epu32(b, t)), half);
+        __m256i odd = _mm256_add_epi64(
+          _mm256_add_epi64(
+            _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(nt, 32)),
+            _mm256_mul_epu32(_mm256_srli_epi64(b, 32), _mm256_srli_epi64(t, 32))),
+          half);
+
+        even = _mm256_srli_epi64(_mm256_add_epi64(even, _mm256_srli_epi64(even, 32)), 32);
+        odd = _mm256_add_epi64(odd, _mm256_srli_epi64(odd, 32));
+        return _mm256_blend_epi32(even, odd, 0xAA);
+    }
+}
+
+/** out[i] = a[i] * b[i] for closed_unit_interval<T>, 32 bytes at a time. */
+template<typename T>
+inline void multiply_unit_interval(std::span<const closed_unit_interval<T>> a, std::span<const closed_unit_interval<T>> b, std::span<closed_unit_interval<T>> out)
+{
+    assert(b.size() >= a.size() && out.size() >= a.size());
+
+    constexpr std::size_t lanes = 32 / sizeof(T);
+
+    std::size_t i = 0;
+    for(; i + lanes <= a.size(); i += lanes)
+    {
+        const __m256i r = multiply_unit_interval<T>(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&a[i])),
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b[i])));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out[i]), r);
+    }
+    simd::multiply_unit_interval(a.subspan(i), b.subspan(i), out.subspan(i));
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]) for closed_unit_interval<T>, 32 bytes at a time. */
+template<typename T>
+inline void lerp_unit_interval(std::span<const closed_unit_interval<T>> t, std::span<const closed_unit_interval<T>> a, std::span<const closed_unit_interval<T>> b, std::span<closed_unit_interval<T>> out)
+{
+    assert(a.size() >= t.size() && b.size() >= t.size() && out.size() >= t.size());
+
+    constexpr std::size_t lanes = 32 / sizeof(T);
+
+    std::size_t i = 0;
+    for(; i + lanes <= t.size(); i += lanes)
+    {
+        const __m256i r = lerp_unit_interval<T>(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&t[i])),
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&a[i])),
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b[i])));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out[i]), r);
+    }
+    simd::lerp_unit_interval(t.subspan(i), a.subspan(i), b.subspan(i), out.subspan(i));
+}
+
+/** out[i] = a[i] * b[i]. */
+inline void multiply(std::span<const fixed_8_t> a, std::span<const fixed_8_t> b, std::span<fixed_8_t> out)
+{
+    avx::multiply_unit_interval(a, b, out);
+}
+
+/** out[i] = a[i] * b[i]. */
+inline void multiply(std::span<const fixed_16_t> a, std::span<const fixed_16_t> b, std::span<fixed_16_t> out)
+{
+    avx::multiply_unit_interval(a, b, out);
+}
+
+/** out[i] = a[i] * b[i]. */
+inline void multiply(std::span<const fixed_32_t> a, std::span<const fixed_32_t> b, std::span<fixed_32_t> out)
+{
+    avx::multiply_unit_interval(a, b, out);
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]). */
+inline void lerp(std::span<const fixed_8_t> t, std::span<const fixed_8_t> a, std::span<const fixed_8_t> b, std::span<fixed_8_t> out)
+{
+    avx::lerp_unit_interval(t, a, b, out);
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]). */
+inline void lerp(std::span<const fixed_16_t> t, std::span<const fixed_16_t> a, std::span<const fixed_16_t> b, std::span<fixed_16_t> out)
+{
+    avx::lerp_unit_interval(t, a, b, out);
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]). */
+inline void lerp(std::span<const fixed_32_t> t, std::span<const fixed_32_t> a, std::span<const fixed_32_t> b, std::span<fixed_32_t> out)
+{
+    avx::lerp_unit_interval(t, a, b, out);
+}
+
+/** convert 8 floats to the representations of closed_unit_interval<T> in 32-bit lanes. See simd::quantize_unit_interval. */
+template<typename T>
+inline __m256i quantize_unit_interval(const __m256 x)
+{
+    const __m256 c = _mm256_min_ps(_mm256_max_ps(x, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+    const __m256 s = _mm256_mul_ps(c, _mm256_set1_ps(closed_unit_interval<T>::scale));
+
+    if constexpr(sizeof(T) < 4)
+    {
+        return _mm256_cvttps_epi32(s);
+    }
+    else
+    {
+        const __m256 top = _mm256_set1_ps(2147483648.0f);
+        const __m256 upper = _mm256_cmp_ps(s, top, _CMP_GE_OQ);
+        const __m256i r = _mm256_cvttps_epi32(_mm256_sub_ps(s, _mm256_and_ps(upper, top)));
+        const __m256i sign = _mm256_slli_epi32(_mm256_castps_si256(upper), 31);
+        return _mm256_or_si256(_mm256_xor_si256(r, sign), _mm256_castps_si256(_mm256_cmp_ps(c, _mm256_set1_ps(1.0f), _CMP_GE_OQ)));
+    }
+}
+
+/** out[i] = closed_unit_interval<T>{in[i]}, 32 bytes of output at a time. */
+template<typename T>
+inline void quantize_unit_interval(std::span<const float> in, std::span<closed_unit_interval<T>> out)
+{
+    assert(out.size() >= in.size());
+
+    constexpr std::size_t lanes = 32 / sizeof(T);
+
+    std::size_t i = 0;
+    for(; i + lanes <= in.size(); i += lanes)
+    {
+        const __m256i a = quantize_unit_interval<T>(_mm256_loadu_ps(&in[i]));
+        __m256i r;
+        if constexpr(sizeof(T) == 1)
+        {
+            const __m256i b = quantize_unit_interval<T>(_mm256_loadu_ps(&in[i + 8]));
+            const __m256i c = quantize_unit_interval<T>(_mm256_loadu_ps(&in[i + 16]));
+            const __m256i d = quantize_unit_interval<T>(_mm256_loadu_ps(&in[i + 24]));
+
+            // the packs work on 128-bit lanes, which leaves the 32-bit groups in the order a0 b0 c0 d0 a1 b1 c1 d1.
+            r = _mm256_packus_epi16(_mm256_packus_epi32(a, b), _mm256_packus_epi32(c, d));
+            r = _mm256_permutevar8x32_epi32(r, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+        }
+        else if constexpr(sizeof(T) == 2)
+        {
+            // the 64-bit groups are in the order a0 b0 a1 b1.
+            r = _mm256_packus_epi32(a, quantize_unit_interval<T>(_mm256_loadu_ps(&in[i + 8])));
+            r = _mm256_permute4x64_epi64(r, _MM_SHUFFLE(3, 1, 2, 0));
+        }
+        else
+        {
+            r = a;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out[i]), r);
+    }
+    simd::quantize_unit_interval(in.subspan(i), out.subspan(i));
+}
+
+/** out[i] = fixed_8_t{in[i]}. */
+inline void quantize(std::span<const float> in, std::span<fixed_8_t> out)
+{
+    avx::quantize_unit_interval(in, out);
+}
+
+/** out[i] = fixed_16_t{in[i]}. */
+inline void quantize(std::span<const float> in, std::span<fixed_16_t> out)
+{
+    avx::quantize_unit_interval(in, out);
+}
+
+/** out[i] = fixed_32_t{in[i]}. */
+inline void quantize(std::span<const float> in, std::span<fixed_32_t> out)
+{
+    avx::quantize_unit_interval(in, out);
+}
+
+#if defined(ML_DISPATCH_TARGET_NAMESPACE)
+} /* inline namespace ML_DISPATCH_TARGET_NAMESPACE */
+#endif
+
+} /* namespace avx */
+
+} /* namespace ml */
@@ -0,0 +1,218 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * 4d matrix implementation using AVX2 and FMA intrinsics.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+namespace avx
+{
+
+/** the rows are SSE vectors. */
+using vec4 = simd::vec4;
+
+/**
+ * 4x4 matrix. Same layout as simd::mat4x4, but operates on two rows at once
+ * using 256-bit registers.
+ */
+struct alignas(32) mat4x4
+{
+    vec4 rows[4];
+
+    mat4x4()
+    {
+        *this = zero();
+    }
+    mat4x4(const vec4& row0, const vec4& row1, const vec4& row2, const vec4& row3)
+    : rows{row0, row1, row2, row3}
+    {
+    }
+
+    explicit mat4x4(const simd::mat4x4& m)
+    : rows{m.rows[0], m.rows[1], m.rows[2], m.rows[3]}
+    {
+    }
+
+    /** convert to the SSE matrix, which has the same layout. */
+    operator simd::mat4x4() const
+    {
+        return {rows[0], rows[1], rows[2], rows[3]};
+    }
+
+    mat4x4(const mat4x4&) = default;
+    mat4x4(mat4x4&&) = default;
+
+    mat4x4& operator=(const mat4x4&) = default;
+
+    /* matrix-matrix operations. */
+    mat4x4 operator+(const mat4x4& m) const
+    {
+        return from_halves(_mm256_add_ps(rows01(), m.rows01()), _mm256_add_ps(rows23(), m.rows23()));
+    }
+    mat4x4 operator-(const mat4x4& m) const
+    {
+        return from_halves(_mm256_sub_ps(rows01(), m.rows01()), _mm256_sub_ps(rows23(), m.rows23()));
+    }
+    mat4x4 operator-() const
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        return from_halves(_mm256_sub_ps(zero, rows01()), _mm256_sub_ps(zero, rows23()));
+    }
+    mat4x4 operator*(const mat4x4& m) const
+    {
+        // broadcast the rows of m into both 128-bit lanes.
+        const __m256 b0 = _mm256_broadcast_ps(&m.rows[0].data);
+        const __m256 b1 = _mm256_broadcast_ps(&m.rows[1].data);
+        const __m256 b2 = _mm256_broadcast_ps(&m.rows[2].data);
+        const __m256 b3 = _mm256_broadcast_ps(&m.rows[3].data);
+
+        return from_halves(multiply_rows(rows01(), b0, b1, b2, b3), multiply_rows(rows23(), b0, b1, b2, b3));
+    }
+
+    /* matrix-vector multiplication. */
+    vec4 operator*(const vec4& v) const
+    {
+        const __m256 v2 = _mm256_broadcast_ps(&v.data);
+        const __m256 v2_swapped = _mm256_permute_ps(v2, _MM_SHUFFLE(2, 3, 0, 1));
+
+        // pairwise sums x+y and z+w of rows 0/1 and rows 2/3, rounded once as in vec4::dot_product.
+        const __m256 s01 = _mm256_fmadd_ps(rows01(), v2, _mm256_mul_ps(_mm256_permute_ps(rows01(), _MM_SHUFFLE(2, 3, 0, 1)), v2_swapped));
+        const __m256 s23 = _mm256_fmadd_ps(rows23(), v2, _mm256_mul_ps(_mm256_permute_ps(rows23(), _MM_SHUFFLE(2, 3, 0, 1)), v2_swapped));
+
+        // gather the pairwise sums (A_i = x+y, B_i = z+w of row i) into [A0, B0, A2, B2 | A1, B1, A3, B3],
+        // and add them to [r0, r2, r0, r2 | r1, r3, r1, r3].
+        __m256 sums = _mm256_shuffle_ps(s01, s23, _MM_SHUFFLE(2, 0, 2, 0));
+        sums = _mm256_hadd_ps(sums, sums);
+
+        return {_mm_unpacklo_ps(_mm256_castps256_ps128(sums), _mm256_extractf128_ps(sums, 1))};
+    }
+
+    /* scaling */
+    mat4x4 operator*(float s) const
+    {
+        const __m256 t = _mm256_set1_ps(s);
+        return from_halves(_mm256_mul_ps(rows01(), t), _mm256_mul_ps(rows23(), t));
+    }
+
+    /* assignments */
+    mat4x4& operator*=(const mat4x4 m)
+    {
+        *this = *this * m;
+        return *this;
+    }
+
+    mat4x4 operator*=(float s)
+    {
+        *this = *this * s;
+        return *this;
+    }
+    mat4x4 operator/=(float s)
+    {
+        *this = *this * (1.0f / s);
+        return *this;
+    }
+
+    /* exact comparisons */
+    bool operator==(const mat4x4& m) const
+    {
+        const __m256 eq = _mm256_and_ps(
+          _mm256_cmp_ps(rows01(), m.rows01(), _CMP_EQ_OQ),
+          _mm256_cmp_ps(rows23(), m.rows23(), _CMP_EQ_OQ));
+        return _mm256_movemask_ps(eq) == 0xFF;
+    }
+    bool operator!=(const mat4x4& m) const
+    {
+        return !(*this == m);
+    }
+
+    /* matrix transformations */
+    void transpose()
+    {
+        _MM_TRANSPOSE4_PS(rows[0].data, rows[1].data, rows[2].data, rows[3].data);
+    }
+
+    mat4x4 transposed() const
+    {
+        mat4x4 m{*this};
+        m.transpose();
+        return m;
+    }
+
+    /* access. */
+    vec4& operator[](int c)
+    {
+        assert(c >= 0 && c < 4);
+        return rows[c];
+    }
+    vec4 operator[](int c) const
+    {
+        assert(c >= 0 && c < 4);
+        return rows[c];
+    }
+
+    /* special matrices. */
+    static mat4x4 identity()
+    {
+        return {
+          {1.0f, 0.0f, 0.0f, 0.0f},
+          {0.0f, 1.0f, 0.0f, 0.0f},
+          {0.0f, 0.0f, 1.0f, 0.0f},
+          {0.0f, 0.0f, 0.0f, 1.0f},
+        };
+    }
+
+    static mat4x4 one()
+    {
+        return mat4x4{vec4::one(), vec4::one(), vec4::one(), vec4::one()};
+    }
+
+    static mat4x4 zero()
+    {
+        return mat4x4{vec4::zero(), vec4::zero(), vec4::zero(), vec4::zero()};
+    }
+
+private:
+    /** rows 0 and 1. */
+    __m256 rows01() const
+    {
+        return _mm256_load_ps(&rows[0].x);
+    }
+
+    /** rows 2 and 3. */
+    __m256 rows23() const
+    {
+        return _mm256_load_ps(&rows[2].x);
+    }
+
+    static mat4x4 from_halves(const __m256 r01, const __m256 r23)
+    {
+        mat4x4 m{vec4::zero(), vec4::zero(), vec4::zero(), vec4::zero()};
+        _mm256_store_ps(&m.rows[0].x, r01);
+        _mm256_store_ps(&m.rows[2].x, r23);
+        return m;
+    }
+
+    /** multiply two rows by the matrix with (broadcasted) rows b0, b1, b2, b3. */
+    static __m256 multiply_rows(const __m256 a, const __m256 b0, const __m256 b1, const __m256 b2, const __m256 b3)
+    {
+        const __m256 x = _mm256_permute_ps(a, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m256 y = _mm256_permute_ps(a, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m256 z = _mm256_permute_ps(a, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m256 w = _mm256_permute_ps(a, _MM_SHUFFLE(3, 3, 3, 3));
+
+        // binary add to reduce cumulative errors. same rounding as vec4::dot_product with FMA.
+        return _mm256_add_ps(
+          _mm256_fmadd_ps(x, b0, _mm256_mul_ps(y, b1)),
+          _mm256_fmadd_ps(z, b2, _mm256_mul_ps(w, b3)));
+    }
+};
+
+} /* namespace avx */
+
+} /* namespace ml */
@@ -0,0 +1,387 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * batch kernels operating on arrays of vectors using AVX-512 intrinsics.
+ *
+ * The kernels process 16 floats, i.e. four vec4 or four vec3 (padded to vec4),
+ * per iteration. The remaining elements are handled by masked loads and stores,
+ * so there is no scalar epilogue.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+/* the AVX-512 intrinsics of GCC 12 trigger false positives (GCC bug 105593). */
+#if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#    pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+namespace ml
+{
+
+namespace avx512
+{
+
+#if defined(ML_DISPATCH_TARGET_NAMESPACE)
+/* compiled for a runtime dispatch target, see dispatch/batch.h. */
+inline namespace ML_DISPATCH_TARGET_NAMESPACE
+{
+#endif
+
+/** the kernels operate on the SSE types. */
+using vec4 = simd::vec4;
+using mat4x4 = simd::mat4x4;
+
+/** mask selecting the first min(n,16) lanes. */
+inline __mmask16 first_lanes(std::size_t n)
+{
+    return n >= 16 ? __mmask16(0xFFFF) : static_cast<__mmask16>((1u << n) - 1);
+}
+
+/**
+ * Matrix columns for the batch transformations, broadcasted into all four 128-bit
+ * lanes. This way, four vectors are transformed per instruction.
+ */
+struct mat4x4_columns
+{
+    __m512 c0, c1, c2, c3;
+
+    explicit mat4x4_columns(const mat4x4& m)
+    {
+        __m128 t0 = m.rows[0].data, t1 = m.rows[1].data, t2 = m.rows[2].data, t3 = m.rows[3].data;
+        _MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+
+        c0 = _mm512_broadcast_f32x4(t0);
+        c1 = _mm512_broadcast_f32x4(t1);
+        c2 = _mm512_broadcast_f32x4(t2);
+        c3 = _mm512_broadcast_f32x4(t3);
+    }
+
+    /** transform the four vectors stored in the lanes of v. */
+    __m512 transform(const __m512 v) const
+    {
+        const __m512 x = _mm512_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m512 y = _mm512_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m512 z = _mm512_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m512 w = _mm512_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3));
+
+        // same rounding as vec4::dot_product with FMA.
+        return _mm512_add_ps(
+          _mm512_fmadd_ps(c0, x, _mm512_mul_ps(c1, y)),
+          _mm512_fmadd_ps(c2, z, _mm512_mul_ps(c3, w)));
+    }
+};
+
+/** spread four packed vec3 (12 floats) into the 128-bit lanes. the w components are undefined. */
+inline __m512 expand_vec3(const __m512 v)
+{
+    const __m512i idx = _mm512_set_epi32(11, 11, 10, 9, 8, 8, 7, 6, 5, 5, 4, 3, 2, 2, 1, 0);
+    return _mm512_permutexvar_ps(idx, v);
+}
+
+/** inverse of expand_vec3. the upper four floats are undefined. */
+inline __m512 compress_vec3(const __m512 v)
+{
+    const __m512i idx = _mm512_set_epi32(15, 15, 15, 15, 14, 13, 12, 10, 9, 8, 6, 5, 4, 2, 1, 0);
+    return _mm512_permutexvar_ps(idx, v);
+}
+
+/** transform homogeneous vectors, out[i] = m * in[i]. in and out may be the same array. */
+inline void transform(const mat4x4& m, std::span<const vec4> in, std::span<vec4> out)
+{
+    assert(out.size() >= in.size());
+
+    const mat4x4_columns cols{m};
+    const float* src = reinterpret_cast<const float*>(in.data());
+    float* dst = reinterpret_cast<float*>(out.data());
+
+    const std::size_t n = 4 * in.size();
+    for(std::size_t i = 0; i < n; i += 16)
+    {
+        const __mmask16 mask = first_lanes(n - i);
+        _mm512_mask_storeu_ps(dst + i, mask, cols.transform(_mm512_maskz_loadu_ps(mask, src + i)));
+    }
+}
+
+/** transform points, out[i] = m * vec4{in[i], 1}. */
+inline void transform_points(const mat4x4& m, std::span<const vec3> in, std::span<vec4> out)
+{
+    assert(out.size() >= in.size());
+
+    const mat4x4_columns cols{m};
+    const __m512 one = _mm512_set1_ps(1.0f);
+    const float* src = reinterpret_cast<const float*>(in.data());
+    float* dst = reinterpret_cast<float*>(out.data());
+
+    for(std::size_t i = 0; i < in.size(); i += 4)
+    {
+        const std::size_t k = std::min<std::size_t>(in.size() - i, 4);
+        const __m512 v = _mm512_mask_blend_ps(0x8888, expand_vec3(_mm512_maskz_loadu_ps(first_lanes(3 * k), src + 3 * i)), one);
+        _mm512_mask_storeu_ps(dst + 4 * i, first_lanes(4 * k), cols.transform(v));
+    }
+}
+
+/** transform directions, out[i] = (m * vec4{in[i], 0}).xyz(). in and out may be the same array. */
+inline void transform_directions(const mat4x4& m, std::span<const vec3> in, std::span<vec3> out)
+{
+    assert(out.size() >= in.size());
+
+    const mat4x4_columns cols{m};
+    const float* src = reinterpret_cast<const float*>(in.data());
+    float* dst = reinterpret_cast<float*>(out.data());
+
+    for(std::size_t i = 0; i < in.size(); i += 4)
+    {
+        const __mmask16 mask = first_lanes(3 * std::min<std::size_t>(in.size() - i, 4));
+        const __m512 v = _mm512_maskz_mov_ps(0x7777, expand_vec3(_mm512_maskz_loadu_ps(mask, src + 3 * i)));
+        _mm512_mask_storeu_ps(dst + 3 * i, mask, compress_vec3(cols.transform(v)));
+    }
+}
+
+/**
+ * 1/sqrt(x), estimated by _mm512_rsqrt14_ps and refined by one Newton-Raphson step. The estimate
+ * is more accurate than the SSE one (relative error 2^-14), so the error is dominated by rounding.
+ */
+inline __m512 rsqrt_newton(const __m512 x)
+{
+    const __m512 y = _mm512_rsqrt14_ps(x);
+    const __m512 half_x_y = _mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(0.5f), x), y);
+    return _mm512_mul_ps(y, _mm512_fnmadd_ps(half_x_y, y, _mm512_set1_ps(1.5f)));
+}
+
+/** 1/x for all lanes, using the precision policy P. The estimate is _mm512_rcp14_ps. */
+template<typename P = precision::default_policy>
+inline __m512 rcp(const __m512 x)
+{
+    if constexpr(std::is_same_v<P, precision::estimate>)
+    {
+        return _mm512_rcp14_ps(x);
+    }
+    else if constexpr(std::is_same_v<P, precision::refined>)
+    {
+        // y + y * (1 - x*y)
+        const __m512 y = _mm512_rcp14_ps(x);
+        return _mm512_fmadd_ps(y, _mm512_fnmadd_ps(x, y, _mm512_set1_ps(1.0f)), y);
+    }
+    else
+    {
+        return _mm512_div_ps(_mm512_set1_ps(1.0f), x);
+    }
+}
+
+/** squared lengths of the four vectors in r, broadcasted into the lanes of each vector. */
+inline __m512 length_squared(const __m512 r)
+{
+    // rounded as in vec4::dot_product with FMA. the pairwise sums are in components 0 and 2.
+    const __m512 r_swapped = _mm512_permute_ps(r, _MM_SHUFFLE(2, 3, 0, 1));
+    const __m512 sums = _mm512_fmadd_ps(r, r, _mm512_mul_ps(r_swapped, r_swapped));
+    return _mm512_add_ps(_mm512_permute_ps(sums, _MM_SHUFFLE(0, 0, 0, 0)), _mm512_permute_ps(sums, _MM_SHUFFLE(2, 2, 2, 2)));
+}
+
+/** normalize vectors. Zero vectors are left unchanged. Squared lengths below FLT_MIN are treated as zero. */
+inline void normalize(std::span<vec4> v)
+{
+    const __m512 one = _mm512_set1_ps(1.0f);
+    const __m512 min_len_sqr = _mm512_set1_ps(std::numeric_limits<float>::min());
+    float* p = reinterpret_cast<float*>(v.data());
+
+    const std::size_t n = 4 * v.size();
+    for(std::size_t i = 0; i < n; i += 16)
+    {
+        const __mmask16 mask = first_lanes(n - i);
+        const __m512 r = _mm512_maskz_loadu_ps(mask, p + i);
+        const __m512 len_sqr = length_squared(r);
+
+        const __mmask16 tiny = _mm512_cmp_ps_mask(len_sqr, min_len_sqr, _CMP_LT_OQ);
+        const __m512 one_over_length = _mm512_mask_blend_ps(tiny, rsqrt_newton(len_sqr), one);
+
+        _mm512_mask_storeu_ps(p + i, mask, _mm512_mul_ps(r, one_over_length));
+    }
+}
+
+/** normalize 3d vectors. Zero vectors are left unchanged. Uses the SSE kernel. */
+inline void normalize(std::span<vec3> v)
+{
+    simd::normalize(v);
+}
+
+/** vector lengths, out[i] = in[i].length(). Squared lengths below FLT_MIN yield zero. */
+inline void lengths(std::span<const vec4> in, std::span<float> out)
+{
+    assert(out.size() >= in.size());
+
+    const __m512 min_len_sqr = _mm512_set1_ps(std::numeric_limits<float>::min());
+    const float* p = reinterpret_cast<const float*>(in.data());
+
+    const std::size_t n = 4 * in.size();
+    for(std::size_t i = 0; i < n; i += 16)
+    {
+        const __mmask16 mask = first_lanes(n - i);
+        const __m512 len_sqr = length_squared(_mm512_maskz_loadu_ps(mask, p + i));
+
+        const __mmask16 tiny = _mm512_cmp_ps_mask(len_sqr, min_len_sqr, _CMP_LT_OQ);
+        const __m512 len = _mm512_maskz_mul_ps(static_cast<__mmask16>(~tiny), len_sqr, rsqrt_newton(len_sqr));
+
+        // store the first lane of each vector.
+        _mm512_mask_compressstoreu_ps(&out[i / 4], mask & 0x1111, len);
+    }
+}
+
+/** 3d vector lengths, out[i] = in[i].length(). Uses the SSE kernel. */
+inline void lengths(std::span<const vec3> in, std::span<float> out)
+{
+    simd::lengths(in, out);
+}
+
+/** divide xyz by w and store 1/w in w. All w components have to be non-zero. */
+inline void divide_by_w(std::span<vec4> v)
+{
+    const __m512 one = _mm512_set1_ps(1.0f);
+    float* p = reinterpret_cast<float*>(v.data());
+
+    const std::size_t n = 4 * v.size();
+    for(std::size_t i = 0; i < n; i += 16)
+    {
+        const __mmask16 mask = first_lanes(n - i);
+
+        // load masked-off lanes as one to avoid divisions by zero.
+        const __m512 r = _mm512_mask_loadu_ps(one, mask, p + i);
+        const __m512 one_over_w = rcp(_mm512_permute_ps(r, _MM_SHUFFLE(3, 3, 3, 3)));
+
+        _mm512_mask_storeu_ps(p + i, mask, _mm512_mask_blend_ps(0x8888, _mm512_mul_ps(r, one_over_w), one_over_w));
+    }
+}
+
+/**
+ * transform clip coordinates to screen coordinates: divide xyz by w, apply the viewport
+ * transformation xyz*scale + bias and store 1/w in w. All w components have to be non-zero.
+ */
+inline void clip_to_screen(std::span<vec4> v, const vec3& scale, const vec3& bias)
+{
+    const __m512 one = _mm512_set1_ps(1.0f);
+    const __m512 s = _mm512_setr4_ps(scale.x, scale.y, scale.z, 0);
+    const __m512 b = _mm512_setr4_ps(bias.x, bias.y, bias.z, 0);
+    float* p = reinterpret_cast<float*>(v.data());
+
+    const std::size_t n = 4 * v.size();
+    for(std::size_t i = 0; i < n; i += 16)
+    {
+        const __mmask16 mask = first_lanes(n - i);
+
+        // load masked-off lanes as one to avoid divisions by zero.
+        const __m512 r = _mm512_mask_loadu_ps(one, mask, p + i);
+        const __m512 one_over_w = rcp(_mm512_permute_ps(r, _MM_SHUFFLE(3, 3, 3, 3)));
+        const __m512 screen = _mm512_fmadd_ps(_mm512_mul_ps(r, one_over_w), s, b);
+
+        _mm512_mask_storeu_ps(p + i, mask, _mm512_mask_blend_ps(0x8888, screen, one_over_w));
+    }
+}
+
+/** clamp all vector components to the interval [0,1]. */
+inline void clamp_to_unit_interval(std::span<vec4> v)
+{
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 one = _mm512_set1_ps(1.0f);
+    float* p = reinterpret_cast<float*>(v.data());
+
+    const std::size_t n = 4 * v.size();
+    for(std::size_t i = 0; i < n; i += 16)
+    {
+        const __mmask16 mask = first_lanes(n - i);
+        _mm512_mask_storeu_ps(p + i, mask, _mm512_min_ps(_mm512_max_ps(_mm512_maskz_loadu_ps(mask, p + i), zero), one));
+    }
+}
+
+/** clamp four colors to [0,1], scale them by 255 and round them to 32-bit integers. BGRA swaps red and blue. */
+template<bool bgra>
+inline __m512i quantize_color8(__m512 c)
+{
+    if constexpr(bgra)
+    {
+        c = _mm512_permute_ps(c, _MM_SHUFFLE(3, 0, 1, 2));
+    }
+    c = _mm512_min_ps(_mm512_max_ps(c, _mm512_setzero_ps()), _mm512_set1_ps(1.0f));
+    return _mm512_cvtps_epi32(_mm512_mul_ps(c, _mm512_set1_ps(255.0f)));
+}
+
+/** pack colors into RGBA8 or BGRA8. */
+template<bool bgra>
+inline void pack_color8(std::span<const vec4> in, std::span<std::uint32_t> out)
+{
+    assert(out.size() >= in.size());
+
+    const float* p = reinterpret_cast<const float*>(in.data());
+    std::uint8_t* q = reinterpret_cast<std::uint8_t*>(out.data());
+
+    // each float component becomes one byte, so the offsets into both arrays are the same.
+    const std::size_t n = 4 * in.size();
+    for(std::size_t i = 0; i < n; i += 16)
+    {
+        const __mmask16 mask = first_lanes(n - i);
+        _mm512_mask_cvtepi32_storeu_epi8(q + i, mask, quantize_color8<bgra>(_mm512_maskz_loadu_ps(mask, p + i)));
+    }
+}
+
+/** unpack RGBA8 or BGRA8 colors. */
+template<bool bgra>
+inline void unpack_color8(std::span<const std::uint32_t> in, std::span<vec4> out)
+{
+    assert(out.size() >= in.size());
+
+    const __m512 scale = _mm512_set1_ps(1.0f / 255.0f);
+    float* p = reinterpret_cast<float*>(out.data());
+
+    const std::size_t n = 4 * in.size();
+    for(std::size_t i = 0; i < n; i += 16)
+    {
+        const __mmask16 mask = first_lanes(n - i);
+
+        // load the (up to) four colors into the lowest 128 bits.
+        const __m128i c = _mm512_castsi512_si128(_mm512_maskz_loadu_epi32(first_lanes((n - i) / 4) & 0xF, &in[i / 4]));
+        __m512 r = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(c)), scale);
+        if constexpr(bgra)
+        {
+            r = _mm512_permute_ps(r, _MM_SHUFFLE(3, 0, 1, 2));
+        }
+        _mm512_mask_storeu_ps(p + i, mask, r);
+    }
+}
+
+/** pack colors into RGBA8, out[i] = pack_rgba8(in[i]). */
+inline void pack_rgba8(std::span<const vec4> in, std::span<std::uint32_t> out)
+{
+    avx512::pack_color8<false>(in, out);
+}
+
+/** pack colors into BGRA8, out[i] = pack_bgra8(in[i]). */
+inline void pack_bgra8(std::span<const vec4> in, std::span<std::uint32_t> out)
+{
+    avx512::pack_color8<true>(in, out);
+}
+
+/** unpack RGBA8 colors, out[i] = unpack_rgba8(in[i]). */
+inline void unpack_rgba8(std::span<const std::uint32_t> in, std::span<vec4> out)
+{
+    avx512::unpack_color8<false>(in, out);
+}
+
+/** unpack BGRA8 colors, out[i] = unpack_bgra8(in[i]). */
+inline void unpack_bgra8(std::span<const std::uint32_t> in, std::span<vec4> out)
+{
+    avx512::unpack_color8<true>(in, out);
+}
+
+#if defined(ML_DISPATCH_TARGET_NAMESPACE)
+} /* inline namespace ML_DISPATCH_TARGET_NAMESPACE */
+#endif
+
+} /* namespace avx512 */
+
+} /* namespace ml */
+
+#if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,140 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * dummy header to include the correct batch kernel implementation.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+#if defined(ML_USE_SIMD)
+
+#    if defined(ML_SIMD_X86)
+#        include "simd/batch.h"
+#        if defined(ML_SIMD_AVX2)
+#            include "avx/batch.h"
+#        endif
+#        if defined(ML_SIMD_AVX512)
+#            include "avx512/batch.h"
+#        endif
+#        if defined(ML_SIMD_DISPATCH)
+#            include "dispatch/batch.h"
+#        endif
+namespace ml
+{
+#        if defined(ML_SIMD_DISPATCH)
+using dispatch::transform;
+using dispatch::transform_points;
+using dispatch::transform_directions;
+using dispatch::normalize;
+using dispatch::lengths;
+using dispatch::divide_by_w;
+using dispatch::clip_to_screen;
+using dispatch::clamp_to_unit_interval;
+using dispatch::pack_rgba8;
+using dispatch::pack_bgra8;
+using dispatch::unpack_rgba8;
+using dispatch::unpack_bgra8;
+using dispatch::multiply;
+using dispatch::lerp;
+using dispatch::quantize;
+#        elif defined(ML_SIMD_AVX512)
+using avx512::transform;
+using avx512::transform_points;
+using avx512::transform_directions;
+using avx512::normalize;
+using avx512::lengths;
+using avx512::divide_by_w;
+using avx512::clip_to_screen;
+using avx512::clamp_to_unit_interval;
+using avx512::pack_rgba8;
+using avx512::pack_bgra8;
+using avx512::unpack_rgba8;
+using avx512::unpack_bgra8;
+/* closed_unit_interval arithmetic and conversion have no AVX-512 kernels. */
+using simd::multiply;
+using simd::lerp;
+using simd::quantize;
+#        elif defined(ML_SIMD_AVX2)
+using avx::transform;
+using avx::transform_points;
+using avx::transform_directions;
+using avx::normalize;
+using avx::lengths;
+using avx::divide_by_w;
+using avx::clip_to_screen;
+using avx::clamp_to_unit_interval;
+using avx::pack_rgba8;
+using avx::pack_bgra8;
+using avx::unpack_rgba8;
+using avx::unpack_bgra8;
+using avx::multiply;
+using avx::lerp;
+using avx::quantize;
+#        else
+using simd::transform;
+using simd::transform_points;
+using simd::transform_directions;
+using simd::normalize;
+using simd::lengths;
+using simd::divide_by_w;
+using simd::clip_to_screen;
+using simd::clamp_to_unit_interval;
+using simd::pack_rgba8;
+using simd::pack_bgra8;
+using simd::unpack_rgba8;
+using simd::unpack_bgra8;
+using simd::multiply;
+using simd::lerp;
+using simd::quantize;
+#        endif
+}; /* namespace ml */
+#    elif defined(ML_SIMD_PORTABLE)
+#        include "portable/batch.h"
+namespace ml
+{
+using portable::transform;
+using portable::transform_points;
+using portable::transform_directions;
+using portable::normalize;
+using portable::lengths;
+using portable::divide_by_w;
+using portable::clip_to_screen;
+using portable::clamp_to_unit_interval;
+using portable::pack_rgba8;
+using portable::pack_bgra8;
+using portable::unpack_rgba8;
+using portable::unpack_bgra8;
+using portable::multiply;
+using portable::lerp;
+using portable::quantize;
+}; /* namespace ml */
+#    else /* defined(ML_SIMD_X86) */
+#        include "x86/batch.h"
+#    endif
+
+#elif defined(ML_INCLUDE_SIMD)
+
+#    if defined(ML_SIMD_X86)
+#        include "x86/batch.h"
+#        include "simd/batch.h"
+#        if defined(ML_SIMD_AVX2)
+#            include "avx/batch.h"
+#        endif
+#        if defined(ML_SIMD_AVX512)
+#            include "avx512/batch.h"
+#        endif
+#        if defined(ML_SIMD_DISPATCH)
+#            include "dispatch/batch.h"
+#        endif
+#    else
+#        include "x86/batch.h"
+#    endif /* defined(ML_INCLUDE_SIMD) */
+#    if defined(ML_SIMD_PORTABLE)
+#        include "portable/batch.h"
+#    endif
+
+#else
+#    include "x86/batch.h"
+#endif
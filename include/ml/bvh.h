@@ -0,0 +1,460 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * bounding volume hierarchy over triangles, built with the binned surface area heuristic.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+/**
+ * node of a bounding volume hierarchy. The nodes are stored in depth-first order, so the
+ * first child of an interior node directly follows it.
+ */
+struct alignas(32) bvh_node
+{
+    /** bounds of the triangles below the node. */
+    aabb3 bounds;
+
+    /** interior nodes: index of the second child. leaves: index of the first triangle. */
+    std::uint32_t offset{0};
+
+    /** number of triangles of a leaf, 0 for interior nodes. */
+    std::uint32_t count{0};
+
+    bool is_leaf() const
+    {
+        return count != 0;
+    }
+};
+
+static_assert(sizeof(bvh_node) == 32, "bvh_node should fill half a cache line");
+
+/** parameters of the bvh construction. */
+struct bvh_build_options
+{
+    /** maximum number of triangles in a leaf. */
+    std::uint32_t max_leaf_size{4};
+
+    /** number of threads. 0 uses std::thread::hardware_concurrency. */
+    unsigned int threads{0};
+
+    /** cost of traversing an interior node, relative to a triangle intersection. */
+    float traversal_cost{1.f};
+};
+
+/**
+ * Bounding volume hierarchy over a triangle soup.
+ *
+ * The triangles are given as three consecutive vertices each. Each node is split by the
+ * binned surface area heuristic, with the centroids of the triangles sorted into 16 bins
+ * along each axis. The subtrees of the upper levels are built in parallel. The triangles are
+ * copied in the order of the leaves, and triangle_index maps them back to the input order.
+ */
+class bvh
+{
+public:
+    /** number of bins for the surface area heuristic. */
+    static constexpr int bin_count = 16;
+
+    /** maximum depth of the tree, which bounds the traversal stack. */
+    static constexpr int max_depth = 64;
+
+private:
+    /** nodes in depth-first order. The root is nodes[0]. */
+    std::vector<bvh_node> nodes;
+
+    /** vertices of the triangles, in leaf order. */
+    std::vector<vec3> vertices;
+
+    /** input index of the triangles, in leaf order. */
+    std::vector<std::uint32_t> indices;
+
+    /** state of the construction. */
+    struct builder
+    {
+        const bvh_build_options& options;
+
+        /** bounds and centroids of the input triangles. */
+        std::vector<aligned_aabb3> bounds;
+        std::vector<vec3> centroids;
+
+        /** triangle references, partitioned during the construction. */
+        std::vector<std::uint32_t>& refs;
+
+        /** depth up to which subtrees are built in parallel. */
+        int parallel_depth{0};
+
+        /** result of the split search. */
+        struct split
+        {
+            int axis{-1};
+            int bin{0};
+            float cost{std::numeric_limits<float>::infinity()};
+            aligned_aabb3 left, right;
+        };
+
+        builder(const bvh_build_options& in_options, std::span<const vec3> in_vertices, std::vector<std::uint32_t>& in_refs)
+        : options{in_options}
+        , refs{in_refs}
+        {
+            const std::size_t n = in_vertices.size() / 3;
+            bounds.resize(n);
+            centroids.resize(n);
+            refs.resize(n);
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                aabb3 b;
+                b.merge(in_vertices[3 * i]);
+                b.merge(in_vertices[3 * i + 1]);
+                b.merge(in_vertices[3 * i + 2]);
+                bounds[i] = aligned_aabb3{b};
+                centroids[i] = b.center();
+                refs[i] = static_cast<std::uint32_t>(i);
+            }
+
+            const unsigned int threads = options.threads != 0 ? options.threads : std::max(std::thread::hardware_concurrency(), 1u);
+            while((1u << parallel_depth) < threads)
+            {
+                ++parallel_depth;
+            }
+            // more tasks than threads balance uneven splits.
+            parallel_depth += threads > 1 ? 2 : 0;
+        }
+
+        /** bin of a centroid coordinate. */
+        static int bin_of(float c, float c_min, float scale)
+        {
+            return std::min(static_cast<int>((c - c_min) * scale), bin_count - 1);
+        }
+
+        /** find the split with the lowest surface area heuristic. */
+        split find_split(std::uint32_t begin, std::uint32_t end, const aabb3& centroid_bounds) const
+        {
+            // bin the triangles along all axes in one pass.
+            float scale[3];
+            for(int axis = 0; axis < 3; ++axis)
+            {
+                const float extent = centroid_bounds.max[axis] - centroid_bounds.min[axis];
+                scale[axis] = extent > 0.f ? bin_count / extent : 0.f;
+            }
+
+            aligned_aabb3 bin_bounds[3][bin_count];
+            std::uint32_t bin_sizes[3][bin_count] = {};
+            for(std::uint32_t i = begin; i < end; ++i)
+            {
+                const aligned_aabb3& b = bounds[refs[i]];
+                const vec3& c = centroids[refs[i]];
+                for(int axis = 0; axis < 3; ++axis)
+                {
+                    const int bin = bin_of(c[axis], centroid_bounds.min[axis], scale[axis]);
+                    bin_bounds[axis][bin].merge(b);
+                    ++bin_sizes[axis][bin];
+                }
+            }
+
+            split best;
+            for(int axis = 0; axis < 3; ++axis)
+            {
+                if(scale[axis] == 0.f)
+                {
+                    continue;
+                }
+
+                // sweep from the right, then from the left.
+                float right_cost[bin_count];
+                aligned_aabb3 right_bounds[bin_count];
+                aligned_aabb3 acc;
+                std::uint32_t count = 0;
+                for(int b = bin_count - 1; b > 0; --b)
+                {
+                    acc.merge(bin_bounds[axis][b]);
+                    count += bin_sizes[axis][b];
+                    right_bounds[b] = acc;
+                    right_cost[b] = acc.surface_area() * static_cast<float>(count);
+                }
+
+                acc = aligned_aabb3{};
+                count = 0;
+                for(int b = 0; b < bin_count - 1; ++b)
+                {
+                    acc.merge(bin_bounds[axis][b]);
+                    count += bin_sizes[axis][b];
+                    const float cost = acc.surface_area() * static_cast<float>(count) + right_cost[b + 1];
+                    if(count > 0 && count < end - begin && cost < best.cost)
+                    {
+                        best = {axis, b + 1, cost, acc, right_bounds[b + 1]};
+                    }
+                }
+            }
+            return best;
+        }
+
+        /** build the subtree of the triangles refs[begin, end) into nodes. */
+        void build(std::uint32_t begin, std::uint32_t end, const aligned_aabb3& node_bounds, std::vector<bvh_node>& nodes, int depth)
+        {
+            const std::size_t index = nodes.size();
+            nodes.push_back({node_bounds.unpadded(), begin, end - begin});
+
+            const std::uint32_t n = end - begin;
+            if(n <= 1)
+            {
+                return;
+            }
+
+            aabb3 centroid_bounds;
+            for(std::uint32_t i = begin; i < end; ++i)
+            {
+                centroid_bounds.merge(centroids[refs[i]]);
+            }
+
+            // costs relative to the surface area of the node.
+            split s = depth < max_depth / 2 ? find_split(begin, end, centroid_bounds) : split{};
+            const float leaf_cost = static_cast<float>(n);
+            const float area = node_bounds.surface_area();
+            const float split_cost = area > 0.f ? options.traversal_cost + s.cost / area : std::numeric_limits<float>::infinity();
+            if(n <= options.max_leaf_size && (s.axis < 0 || leaf_cost <= split_cost))
+            {
+                return;
+            }
+
+            std::uint32_t mid = 0;
+            if(s.axis >= 0)
+            {
+                const float c_min = centroid_bounds.min[s.axis];
+                const float scale = bin_count / (centroid_bounds.max[s.axis] - c_min);
+                mid = static_cast<std::uint32_t>(
+                  std::partition(
+                    refs.begin() + begin, refs.begin() + end,
+                    [&](std::uint32_t r)
+                    { return bin_of(centroids[r][s.axis], c_min, scale) < s.bin; })
+                  - refs.begin());
+            }
+            else
+            {
+                // no split separates the centroids, or the tree is too deep. split at the median.
+                const vec3 d = centroid_bounds.empty() ? vec3{} : centroid_bounds.max - centroid_bounds.min;
+                const int axis = d.x >= d.y && d.x >= d.z ? 0 : (d.y >= d.z ? 1 : 2);
+                mid = begin + n / 2;
+                std::nth_element(
+                  refs.begin() + begin, refs.begin() + mid, refs.begin() + end,
+                  [&](std::uint32_t a, std::uint32_t b)
+                  { return centroids[a][axis] < centroids[b][axis]; });
+
+                s.left = s.right = aligned_aabb3{};
+                for(std::uint32_t i = begin; i < mid; ++i)
+                {
+                    s.left.merge(bounds[refs[i]]);
+                }
+                for(std::uint32_t i = mid; i < end; ++i)
+                {
+                    s.right.merge(bounds[refs[i]]);
+                }
+            }
+
+            nodes[index].count = 0;
+            if(depth < parallel_depth && n > 4096)
+            {
+                // build the second subtree into its own array and append it.
+                std::vector<bvh_node> right_nodes;
+                auto task = std::async(std::launch::async, [&]()
+                                       { build(mid, end, s.right, right_nodes, depth + 1); });
+                build(begin, mid, s.left, nodes, depth + 1);
+                task.get();
+
+                const std::uint32_t right = static_cast<std::uint32_t>(nodes.size());
+                for(bvh_node node: right_nodes)
+                {
+                    if(!node.is_leaf())
+                    {
+                        node.offset += right;
+                    }
+                    nodes.push_back(node);
+                }
+                nodes[index].offset = right;
+            }
+            else
+            {
+                build(begin, mid, s.left, nodes, depth + 1);
+                nodes[index].offset = static_cast<std::uint32_t>(nodes.size());
+                build(mid, end, s.right, nodes, depth + 1);
+            }
+        }
+    };
+
+public:
+    bvh() = default;
+
+    /** build the hierarchy over the triangles (vertices[3i], vertices[3i+1], vertices[3i+2]). */
+    explicit bvh(std::span<const vec3> in_vertices, const bvh_build_options& options = {})
+    {
+        assert(in_vertices.size() % 3 == 0);
+        if(in_vertices.empty())
+        {
+            return;
+        }
+
+        builder b{options, in_vertices, indices};
+        aligned_aabb3 root;
+        for(const auto& it: b.bounds)
+        {
+            root.merge(it);
+        }
+
+        nodes.reserve(2 * indices.size() / std::max(options.max_leaf_size, 1u) + 1);
+        b.build(0, static_cast<std::uint32_t>(indices.size()), root, nodes, 0);
+
+        vertices.resize(in_vertices.size());
+        for(std::size_t i = 0; i < indices.size(); ++i)
+        {
+            vertices[3 * i] = in_vertices[3 * indices[i]];
+            vertices[3 * i + 1] = in_vertices[3 * indices[i] + 1];
+            vertices[3 * i + 2] = in_vertices[3 * indices[i] + 2];
+        }
+    }
+
+    bool empty() const
+    {
+        return nodes.empty();
+    }
+
+    /** nodes in depth-first order, starting with the root. */
+    std::span<const bvh_node> get_nodes() const
+    {
+        return nodes;
+    }
+
+    /** vertices of the triangles in leaf order. */
+    std::span<const vec3> get_vertices() const
+    {
+        return vertices;
+    }
+
+    /** input index of the i-th triangle in leaf order. */
+    std::uint32_t triangle_index(std::uint32_t i) const
+    {
+        return indices[i];
+    }
+
+    /**
+     * find the closest intersection of a ray with ray parameter less than hit.t. On a hit, hit
+     * is updated, with the input index of the triangle, and true is returned.
+     */
+    bool intersect(const line3& ray, ray_hit& hit) const
+    {
+        if(nodes.empty())
+        {
+            return false;
+        }
+
+        const vec3 inv_dir{1.0f / ray.dir.x, 1.0f / ray.dir.y, 1.0f / ray.dir.z};
+        std::uint32_t leaf_hit = ray_hit::no_triangle;
+
+        std::uint32_t stack[max_depth];
+        int top = 0;
+        std::uint32_t current = 0;
+        if(intersect_aabb(ray, inv_dir, nodes[0].bounds, hit.t) == std::numeric_limits<float>::infinity())
+        {
+            return false;
+        }
+
+        while(true)
+        {
+            const bvh_node& node = nodes[current];
+            if(node.is_leaf())
+            {
+                for(std::uint32_t i = node.offset; i < node.offset + node.count; ++i)
+                {
+                    if(intersect_triangle(ray, vertices[3 * i], vertices[3 * i + 1], vertices[3 * i + 2], hit))
+                    {
+                        leaf_hit = i;
+                    }
+                }
+            }
+            else
+            {
+                // visit the closer child first, and skip children behind the closest hit.
+                std::uint32_t first = current + 1, second = node.offset;
+                float t_first = intersect_aabb(ray, inv_dir, nodes[first].bounds, hit.t);
+                float t_second = intersect_aabb(ray, inv_dir, nodes[second].bounds, hit.t);
+                if(t_second < t_first)
+                {
+                    std::swap(first, second);
+                    std::swap(t_first, t_second);
+                }
+
+                if(t_first != std::numeric_limits<float>::infinity())
+                {
+                    if(t_second != std::numeric_limits<float>::infinity())
+                    {
+                        assert(top < max_depth);
+                        stack[top++] = second;
+                    }
+                    current = first;
+                    continue;
+                }
+            }
+
+            if(top == 0)
+            {
+                break;
+            }
+            current = stack[--top];
+        }
+
+        if(leaf_hit == ray_hit::no_triangle)
+        {
+            return false;
+        }
+        hit.triangle = indices[leaf_hit];
+        return true;
+    }
+
+    /** whether the ray intersects any triangle with ray parameter less than t_max. */
+    bool occluded(const line3& ray, float t_max = std::numeric_limits<float>::infinity()) const
+    {
+        if(nodes.empty())
+        {
+            return false;
+        }
+
+        const vec3 inv_dir{1.0f / ray.dir.x, 1.0f / ray.dir.y, 1.0f / ray.dir.z};
+        ray_hit hit{t_max};
+
+        std::uint32_t stack[max_depth];
+        int top = 0;
+        stack[top++] = 0;
+        while(top > 0)
+        {
+            const bvh_node& node = nodes[stack[--top]];
+            if(intersect_aabb(ray, inv_dir, node.bounds, t_max) == std::numeric_limits<float>::infinity())
+            {
+                continue;
+            }
+
+            if(node.is_leaf())
+            {
+                for(std::uint32_t i = node.offset; i < node.offset + node.count; ++i)
+                {
+                    if(intersect_triangle(ray, vertices[3 * i], vertices[3 * i + 1], vertices[3 * i + 2], hit))
+                    {
+                        return true;
+                    }
+                }
+            }
+            else
+            {
+                assert(top + 2 <= max_depth);
+                stack[top++] = node.offset;
+                stack[top++] = static_cast<std::uint32_t>(&node - nodes.data()) + 1;
+            }
+        }
+        return false;
+    }
+};
+
+} /* namespace ml */
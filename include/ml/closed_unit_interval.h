@@ -39,28 +39,19 @@ struct closed_unit_interval
     /** default copy constructor. */
     closed_unit_interval(const closed_unit_interval&) noexcept = default;
 
-    /** Constructor. Clamps incoming numbers to the range [0,1]. */
+    /** Constructor. Clamps incoming numbers to the range [0,1]. NaN yields zero. */
     closed_unit_interval(float in) noexcept
     {
-        // clamp and circumvent precision issue when near one.
-        if(in <= 0.f)
-        {
-            data = 0;
-        }
-        else if(in >= 1.f)
-        {
-            data = one;
-        }
-        else if(in <= 0.5f)
-        {
-            // convert to fixed-point.
-            data = static_cast<T>(in * scale);
-        }
-        else
-        {
-            in -= 0.5f;
-            data = static_cast<T>(in * scale) + half;
-        }
+        // branchless. the product with scale is exact and at most 2^bits, so truncating it
+        // gives the same results as converting the halves [0,0.5] and (0.5,1) separately.
+#if defined(ML_SIMD_X86)
+        // maxss and minss return the second operand for NaN.
+        in = _mm_cvtss_f32(_mm_min_ss(_mm_max_ss(_mm_set_ss(in), _mm_setzero_ps()), _mm_set_ss(1.f)));
+#else
+        in = in > 0.f ? in : 0.f;
+        in = in < 1.f ? in : 1.f;
+#endif
+        data = static_cast<T>(std::min(static_cast<std::int64_t>(in * scale), static_cast<std::int64_t>(one)));
     }
 
     struct no_clamp
@@ -88,7 +79,7 @@ struct closed_unit_interval
     };
 
     /** Construct from base representation. */
-    closed_unit_interval(T n, const no_scale&) noexcept
+    constexpr closed_unit_interval(T n, const no_scale&) noexcept
     : data(n)
     {
     }
@@ -108,7 +99,7 @@ struct closed_unit_interval
          *
          * assert( data < std::numeric_limits<T>::max() - Other.data )
          */
-        return closed_unit_interval{data + Other.data, no_scale()};
+        return closed_unit_interval{static_cast<T>(data + Other.data), no_scale()};
     }
     constexpr closed_unit_interval operator-(const closed_unit_interval& Other) const noexcept
     {
@@ -117,7 +108,23 @@ struct closed_unit_interval
          *
          * assert( data > Other.data )
          */
-        return closed_unit_interval{data - Other.data, no_scale()};
+        return closed_unit_interval{static_cast<T>(data - Other.data), no_scale()};
+    }
+
+    /**
+     * Divide by the representation of one, rounding to nearest (ties up). Exact for
+     * 0 <= x <= one*one, i.e. for products of two representations.
+     */
+    static constexpr std::uint64_t round_div_one(std::uint64_t x) noexcept
+    {
+        const std::uint64_t t = x + half;
+        return (t + (t >> bits)) >> bits;
+    }
+
+    /** Correctly rounded product. */
+    constexpr closed_unit_interval operator*(const closed_unit_interval& Other) const noexcept
+    {
+        return closed_unit_interval{static_cast<T>(round_div_one(static_cast<std::uint64_t>(data) * Other.data)), no_scale()};
     }
 
     /*
@@ -134,8 +141,24 @@ struct closed_unit_interval
         data -= Other.data;
         return *this;
     }
+    constexpr closed_unit_interval& operator*=(const closed_unit_interval& Other) noexcept
+    {
+        *this = *this * Other;
+        return *this;
+    }
 };
 
+/** Linear interpolation a*(1-t) + b*t, correctly rounded. */
+template<typename T>
+constexpr closed_unit_interval<T> lerp(const closed_unit_interval<T>& t, const closed_unit_interval<T>& a, const closed_unit_interval<T>& b) noexcept
+{
+    using U = closed_unit_interval<T>;
+
+    // the sum is at most one*one.
+    const std::uint64_t x = static_cast<std::uint64_t>(a.data) * (U::one - t.data) + static_cast<std::uint64_t>(b.data) * t.data;
+    return U{static_cast<T>(U::round_div_one(x)), typename U::no_scale()};
+}
+
 template<typename T>
 T unwrap(const closed_unit_interval<T>& i)
 {
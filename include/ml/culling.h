@@ -0,0 +1,103 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * frustum culling of arrays of spheres and axis-aligned boxes.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+/*
+ * The culling functions write visibility bit masks. Bit i % 64 of visible[i / 64] is set if
+ * object i intersects the frustum (conservatively, see frustum), and the bits past the last
+ * object are cleared. visible needs to hold at least (size + 63) / 64 words.
+ */
+
+/** frustum test of an array of spheres. */
+inline void cull_spheres(const frustum& f, const sphere_array& spheres, std::span<std::uint64_t> visible)
+{
+    const std::size_t n = spheres.size();
+    assert(spheres.y.size() == n && spheres.z.size() == n && spheres.radius.size() == n);
+    assert(visible.size() >= (n + 63) / 64);
+
+    std::fill(visible.begin(), visible.begin() + (n + 63) / 64, 0);
+
+    std::size_t i = 0;
+#if defined(ML_SIMD_X86)
+#    if defined(ML_USE_AVX)
+    const simd::frustum_x8 planes{f};
+    for(; i + 8 <= n; i += 8)
+    {
+        const int bits = planes.spheres(
+          _mm256_loadu_ps(&spheres.x[i]), _mm256_loadu_ps(&spheres.y[i]),
+          _mm256_loadu_ps(&spheres.z[i]), _mm256_loadu_ps(&spheres.radius[i]));
+        visible[i / 64] |= static_cast<std::uint64_t>(bits) << (i % 64);
+    }
+#    else
+    const simd::frustum_x4 planes{f};
+    for(; i + 4 <= n; i += 4)
+    {
+        const int bits = planes.spheres(
+          _mm_loadu_ps(&spheres.x[i]), _mm_loadu_ps(&spheres.y[i]),
+          _mm_loadu_ps(&spheres.z[i]), _mm_loadu_ps(&spheres.radius[i]));
+        visible[i / 64] |= static_cast<std::uint64_t>(bits) << (i % 64);
+    }
+#    endif
+#endif
+
+    for(; i < n; ++i)
+    {
+        if(f.intersects_sphere({spheres.x[i], spheres.y[i], spheres.z[i]}, spheres.radius[i]))
+        {
+            visible[i / 64] |= std::uint64_t{1} << (i % 64);
+        }
+    }
+}
+
+/** frustum test of an array of axis-aligned boxes. */
+inline void cull_aabbs(const frustum& f, const aabb_array& boxes, std::span<std::uint64_t> visible)
+{
+    const std::size_t n = boxes.size();
+    assert(boxes.min_y.size() == n && boxes.min_z.size() == n);
+    assert(boxes.max_x.size() == n && boxes.max_y.size() == n && boxes.max_z.size() == n);
+    assert(visible.size() >= (n + 63) / 64);
+
+    std::fill(visible.begin(), visible.begin() + (n + 63) / 64, 0);
+
+    std::size_t i = 0;
+#if defined(ML_SIMD_X86)
+#    if defined(ML_USE_AVX)
+    const simd::frustum_x8 planes{f};
+    for(; i + 8 <= n; i += 8)
+    {
+        const int bits = planes.aabbs(
+          _mm256_loadu_ps(&boxes.min_x[i]), _mm256_loadu_ps(&boxes.min_y[i]), _mm256_loadu_ps(&boxes.min_z[i]),
+          _mm256_loadu_ps(&boxes.max_x[i]), _mm256_loadu_ps(&boxes.max_y[i]), _mm256_loadu_ps(&boxes.max_z[i]));
+        visible[i / 64] |= static_cast<std::uint64_t>(bits) << (i % 64);
+    }
+#    else
+    const simd::frustum_x4 planes{f};
+    for(; i + 4 <= n; i += 4)
+    {
+        const int bits = planes.aabbs(
+          _mm_loadu_ps(&boxes.min_x[i]), _mm_loadu_ps(&boxes.min_y[i]), _mm_loadu_ps(&boxes.min_z[i]),
+          _mm_loadu_ps(&boxes.max_x[i]), _mm_loadu_ps(&boxes.max_y[i]), _mm_loadu_ps(&boxes.max_z[i]));
+        visible[i / 64] |= static_cast<std::uint64_t>(bits) << (i % 64);
+    }
+#    endif
+#endif
+
+    for(; i < n; ++i)
+    {
+        if(f.intersects_aabb({boxes.min_x[i], boxes.min_y[i], boxes.min_z[i]}, {boxes.max_x[i], boxes.max_y[i], boxes.max_z[i]}))
+        {
+            visible[i / 64] |= std::uint64_t{1} << (i % 64);
+        }
+    }
+}
+
+} /* namespace ml */
@@ -0,0 +1,201 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * tiled depth buffer of fixed_32_t samples.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+/**
+ * Depth buffer with fixed_32_t samples.
+ *
+ * The samples are stored in 8x8 tiles, row-major inside each tile, and the tiles are stored
+ * in row-major order. Each tile occupies four cache lines and is aligned to them. The tile
+ * masks use the layout of coverage_mask and for_each_tile, i.e. bit row*8 + column refers
+ * to the sample (x + column, y + row).
+ */
+class depth_buffer
+{
+public:
+    /** width and height of a tile. */
+    static constexpr int tile_size = 8;
+
+    /** the samples of a tile, in row-major order. */
+    struct alignas(64) tile
+    {
+        fixed_32_t samples[tile_size * tile_size];
+    };
+
+private:
+    /** size in samples. */
+    int w{0}, h{0};
+
+    /** size in tiles. */
+    int tiles_x{0}, tiles_y{0};
+
+    /** tile storage. */
+    std::vector<tile> tiles;
+
+    /** test and update the tile with the top-left sample (x,y) for a fixed comparison function. */
+    template<depth_compare F>
+    std::uint64_t test_and_update_tile(int x, int y, std::span<const fixed_32_t, tile_size * tile_size> z, std::uint64_t mask, bool write)
+    {
+        fixed_32_t* d = get_tile(x / tile_size, y / tile_size).samples;
+        std::uint64_t pass = 0;
+
+        for(int r = 0; r < tile_size; ++r, d += tile_size)
+        {
+            const unsigned int row_mask = static_cast<unsigned int>(mask >> (tile_size * r)) & 0xff;
+            if(row_mask == 0)
+            {
+                continue;
+            }
+
+            const fixed_32_t* row_z = z.data() + tile_size * r;
+#if defined(ML_SIMD_AVX2)
+            const unsigned int row_pass = simd::depth_test_and_update_x8<F>(
+              d, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row_z)), row_mask, write);
+#elif defined(ML_SIMD_X86)
+            const unsigned int row_pass =
+              simd::depth_test_and_update_x4<F>(
+                d, _mm_loadu_si128(reinterpret_cast<const __m128i*>(row_z)), row_mask & 0xf, write)
+              | (simd::depth_test_and_update_x4<F>(
+                   d + 4, _mm_loadu_si128(reinterpret_cast<const __m128i*>(row_z + 4)), row_mask >> 4, write)
+                 << 4);
+#else
+            unsigned int row_pass = 0;
+            for(int c = 0; c < tile_size; ++c)
+            {
+                if(((row_mask >> c) & 1) != 0 && depth_test(F, row_z[c], d[c]))
+                {
+                    row_pass |= 1u << c;
+                    if(write)
+                    {
+                        d[c] = row_z[c];
+                    }
+                }
+            }
+#endif
+            pass |= static_cast<std::uint64_t>(row_pass) << (tile_size * r);
+        }
+        return pass;
+    }
+
+public:
+    depth_buffer() = default;
+
+    /** create a depth buffer of the given size and set all samples to the clear value. */
+    depth_buffer(int width, int height, fixed_32_t clear_value = fixed_32_t{1.0f})
+    : w{width}
+    , h{height}
+    , tiles_x{(width + tile_size - 1) / tile_size}
+    , tiles_y{(height + tile_size - 1) / tile_size}
+    , tiles(static_cast<std::size_t>(tiles_x) * static_cast<std::size_t>(tiles_y))
+    {
+        clear(clear_value);
+    }
+
+    int width() const
+    {
+        return w;
+    }
+    int height() const
+    {
+        return h;
+    }
+
+    /** number of tiles in x and y direction. */
+    int tile_count_x() const
+    {
+        return tiles_x;
+    }
+    int tile_count_y() const
+    {
+        return tiles_y;
+    }
+
+    /** access the tile (tx,ty), counted in tiles. */
+    tile& get_tile(int tx, int ty)
+    {
+        assert(tx >= 0 && tx < tiles_x && ty >= 0 && ty < tiles_y);
+        return tiles[static_cast<std::size_t>(ty) * tiles_x + tx];
+    }
+    const tile& get_tile(int tx, int ty) const
+    {
+        assert(tx >= 0 && tx < tiles_x && ty >= 0 && ty < tiles_y);
+        return tiles[static_cast<std::size_t>(ty) * tiles_x + tx];
+    }
+
+    /** set all samples, including the padding of the border tiles, to a value. */
+    void clear(fixed_32_t value)
+    {
+        for(auto& t: tiles)
+        {
+            std::fill(std::begin(t.samples), std::end(t.samples), value);
+        }
+    }
+
+    /** access the sample (x,y). */
+    fixed_32_t& at(int x, int y)
+    {
+        return get_tile(x / tile_size, y / tile_size).samples[(y % tile_size) * tile_size + x % tile_size];
+    }
+    const fixed_32_t& at(int x, int y) const
+    {
+        return get_tile(x / tile_size, y / tile_size).samples[(y % tile_size) * tile_size + x % tile_size];
+    }
+
+    /** depth test of the sample (x,y). If the test passes and write is set, z is stored. */
+    bool test_and_update(int x, int y, fixed_32_t z, depth_compare f, bool write = true)
+    {
+        fixed_32_t& d = at(x, y);
+        if(!depth_test(f, z, d))
+        {
+            return false;
+        }
+        if(write)
+        {
+            d = z;
+        }
+        return true;
+    }
+
+    /**
+     * depth test of the samples of the tile with the top-left sample (x,y), which has to be
+     * aligned to the tile size. z holds the depths in the layout of the tile, and only the
+     * samples in mask are tested. If write is set, the samples that pass are stored. Returns
+     * the mask of the samples that passed.
+     */
+    std::uint64_t test_and_update(int x, int y, std::span<const fixed_32_t, tile_size * tile_size> z, std::uint64_t mask, depth_compare f, bool write = true)
+    {
+        assert(x % tile_size == 0 && y % tile_size == 0);
+
+        switch(f)
+        {
+        case depth_compare::never:
+            return 0;
+        case depth_compare::less:
+            return test_and_update_tile<depth_compare::less>(x, y, z, mask, write);
+        case depth_compare::less_equal:
+            return test_and_update_tile<depth_compare::less_equal>(x, y, z, mask, write);
+        case depth_compare::equal:
+            return test_and_update_tile<depth_compare::equal>(x, y, z, mask, write);
+        case depth_compare::greater:
+            return test_and_update_tile<depth_compare::greater>(x, y, z, mask, write);
+        case depth_compare::greater_equal:
+            return test_and_update_tile<depth_compare::greater_equal>(x, y, z, mask, write);
+        case depth_compare::not_equal:
+            return test_and_update_tile<depth_compare::not_equal>(x, y, z, mask, write);
+        case depth_compare::always:
+            return test_and_update_tile<depth_compare::always>(x, y, z, mask, write);
+        }
+        return 0;
+    }
+};
+
+} /* namespace ml */
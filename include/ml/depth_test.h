@@ -0,0 +1,106 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * depth comparison functions and depth ranges.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+/** comparison functions for the depth test. A sample with depth z passes if "z compare d" holds for the stored depth d. */
+enum class depth_compare
+{
+    never,
+    less,
+    less_equal,
+    equal,
+    greater,
+    greater_equal,
+    not_equal,
+    always
+};
+
+/** depth test of a single sample. */
+inline bool depth_test(depth_compare f, const fixed_32_t& z, const fixed_32_t& d)
+{
+    switch(f)
+    {
+    case depth_compare::never:
+        return false;
+    case depth_compare::less:
+        return z < d;
+    case depth_compare::less_equal:
+        return z <= d;
+    case depth_compare::equal:
+        return z == d;
+    case depth_compare::greater:
+        return z > d;
+    case depth_compare::greater_equal:
+        return z >= d;
+    case depth_compare::not_equal:
+        return z != d;
+    case depth_compare::always:
+        return true;
+    }
+    return false;
+}
+
+/** range of depth values. */
+struct depth_range
+{
+    fixed_32_t min_z{1.0f}, max_z{0.0f};
+
+    depth_range() = default;
+    depth_range(fixed_32_t in_min, fixed_32_t in_max)
+    : min_z{in_min}
+    , max_z{in_max}
+    {
+    }
+
+    /** whether the range contains no values. */
+    bool empty() const
+    {
+        return min_z > max_z;
+    }
+
+    /** extend the range to contain another range. */
+    void merge(const depth_range& other)
+    {
+        min_z = std::min(min_z, other.min_z);
+        max_z = std::max(max_z, other.max_z);
+    }
+
+    /**
+     * conservative depth test. Returns false only if no sample with depth z can pass the test
+     * against any stored depth in the range.
+     */
+    bool may_pass(depth_compare f, const fixed_32_t& z) const
+    {
+        switch(f)
+        {
+        case depth_compare::never:
+            return false;
+        case depth_compare::less:
+            return z < max_z;
+        case depth_compare::less_equal:
+            return z <= max_z;
+        case depth_compare::equal:
+            return min_z <= z && z <= max_z;
+        case depth_compare::greater:
+            return z > min_z;
+        case depth_compare::greater_equal:
+            return z >= min_z;
+        case depth_compare::not_equal:
+            return !(min_z == z && max_z == z);
+        case depth_compare::always:
+            return true;
+        }
+        return true;
+    }
+};
+
+} /* namespace ml */
@@ -0,0 +1,414 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * runtime selection of the batch kernels.
+ *
+ * The SSE4.1, AVX2 and AVX-512 kernels are compiled into the same binary using
+ * function target attributes. On first use, the highest instruction set supported
+ * by the CPU is determined and the corresponding function pointers are cached.
+ *
+ * The kernels compiled for a target, and the vec4x8 helpers they use, are placed into
+ * the inline namespaces dispatch_avx2 and dispatch_avx512. Lookup is unchanged, but their
+ * symbols differ from those of translation units that include the same headers with other
+ * compiler flags (e.g. -mavx), so the linker cannot mix the two versions.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+/*
+ * AVX2/FMA kernels. If the backend is enabled at compile time, they are already included.
+ */
+#if !defined(ML_SIMD_AVX2)
+
+#    if defined(__clang__)
+#        pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#    else
+#        pragma GCC push_options
+#        pragma GCC target("avx2,fma")
+#    endif
+#    define ML_DISPATCH_TARGET_NAMESPACE dispatch_avx2
+
+#    if !defined(ML_USE_AVX)
+#        include "../simd/vec4x8.h"
+#    endif
+
+namespace ml
+{
+
+namespace avx
+{
+
+/** without the AVX2 backend, the kernels operate on the SSE types. */
+using vec4 = simd::vec4;
+using mat4x4 = simd::mat4x4;
+
+} /* namespace avx */
+
+} /* namespace ml */
+
+#    include "../avx/batch.h"
+
+#    undef ML_DISPATCH_TARGET_NAMESPACE
+#    if defined(__clang__)
+#        pragma clang attribute pop
+#    else
+#        pragma GCC pop_options
+#    endif
+
+#endif /* !defined(ML_SIMD_AVX2) */
+
+/*
+ * AVX-512 kernels.
+ */
+#if !defined(ML_SIMD_AVX512)
+
+#    if defined(__clang__)
+#        pragma clang attribute push(__attribute__((target("avx512f,avx2,fma"))), apply_to = function)
+#    else
+#        pragma GCC push_options
+#        pragma GCC target("avx512f,avx2,fma")
+#    endif
+#    define ML_DISPATCH_TARGET_NAMESPACE dispatch_avx512
+
+#    include "../avx512/batch.h"
+
+#    undef ML_DISPATCH_TARGET_NAMESPACE
+#    if defined(__clang__)
+#        pragma clang attribute pop
+#    else
+#        pragma GCC pop_options
+#    endif
+
+#endif /* !defined(ML_SIMD_AVX512) */
+
+namespace ml
+{
+
+namespace dispatch
+{
+
+/** instruction set levels, ordered by capability. */
+enum class isa
+{
+    sse41,
+    avx2,
+    avx512
+};
+
+/** function pointers to the batch kernels of one instruction set. */
+struct batch_kernels
+{
+    isa level;
+
+    void (*transform)(const simd::mat4x4&, std::span<const simd::vec4>, std::span<simd::vec4>);
+    void (*transform_points)(const simd::mat4x4&, std::span<const vec3>, std::span<simd::vec4>);
+    void (*transform_directions)(const simd::mat4x4&, std::span<const vec3>, std::span<vec3>);
+    void (*normalize)(std::span<simd::vec4>);
+    void (*lengths)(std::span<const simd::vec4>, std::span<float>);
+    void (*divide_by_w)(std::span<simd::vec4>);
+    void (*clip_to_screen)(std::span<simd::vec4>, const vec3&, const vec3&);
+    void (*clamp_to_unit_interval)(std::span<simd::vec4>);
+    void (*pack_rgba8)(std::span<const simd::vec4>, std::span<std::uint32_t>);
+    void (*pack_bgra8)(std::span<const simd::vec4>, std::span<std::uint32_t>);
+    void (*unpack_rgba8)(std::span<const std::uint32_t>, std::span<simd::vec4>);
+    void (*unpack_bgra8)(std::span<const std::uint32_t>, std::span<simd::vec4>);
+    void (*multiply8)(std::span<const fixed_8_t>, std::span<const fixed_8_t>, std::span<fixed_8_t>);
+    void (*multiply16)(std::span<const fixed_16_t>, std::span<const fixed_16_t>, std::span<fixed_16_t>);
+    void (*multiply32)(std::span<const fixed_32_t>, std::span<const fixed_32_t>, std::span<fixed_32_t>);
+    void (*lerp8)(std::span<const fixed_8_t>, std::span<const fixed_8_t>, std::span<const fixed_8_t>, std::span<fixed_8_t>);
+    void (*lerp16)(std::span<const fixed_16_t>, std::span<const fixed_16_t>, std::span<const fixed_16_t>, std::span<fixed_16_t>);
+    void (*lerp32)(std::span<const fixed_32_t>, std::span<const fixed_32_t>, std::span<const fixed_32_t>, std::span<fixed_32_t>);
+    void (*quantize8)(std::span<const float>, std::span<fixed_8_t>);
+    void (*quantize16)(std::span<const float>, std::span<fixed_16_t>);
+    void (*quantize32)(std::span<const float>, std::span<fixed_32_t>);
+};
+
+/** kernels for the given instruction set. */
+inline const batch_kernels& kernels_for(isa level)
+{
+    static const batch_kernels sse41{
+      isa::sse41,
+      simd::transform,
+      simd::transform_points,
+      simd::transform_directions,
+      simd::normalize,
+      simd::lengths,
+      simd::divide_by_w,
+      simd::clip_to_screen,
+      simd::clamp_to_unit_interval,
+      simd::pack_rgba8,
+      simd::pack_bgra8,
+      simd::unpack_rgba8,
+      simd::unpack_bgra8,
+      simd::multiply,
+      simd::multiply,
+      simd::multiply,
+      simd::lerp,
+      simd::lerp,
+      simd::lerp,
+      simd::quantize,
+      simd::quantize,
+      simd::quantize};
+
+    // the AVX2 backend has its own matrix type.
+    static const batch_kernels avx2{
+      isa::avx2,
+      [](const simd::mat4x4& m, std::span<const simd::vec4> in, std::span<simd::vec4> out)
+      { avx::transform(avx::mat4x4{m}, in, out); },
+      [](const simd::mat4x4& m, std::span<const vec3> in, std::span<simd::vec4> out)
+      { avx::transform_points(avx::mat4x4{m}, in, out); },
+      [](const simd::mat4x4& m, std::span<const vec3> in, std::span<vec3> out)
+      { avx::transform_directions(avx::mat4x4{m}, in, out); },
+      avx::normalize,
+      avx::lengths,
+      avx::divide_by_w,
+      avx::clip_to_screen,
+      avx::clamp_to_unit_interval,
+      avx::pack_rgba8,
+      avx::pack_bgra8,
+      avx::unpack_rgba8,
+      avx::unpack_bgra8,
+      avx::multiply,
+      avx::multiply,
+      avx::multiply,
+      avx::lerp,
+      avx::lerp,
+      avx::lerp,
+      avx::quantize,
+      avx::quantize,
+      avx::quantize};
+
+    static const batch_kernels avx512{
+      isa::avx512,
+      avx512::transform,
+      avx512::transform_points,
+      avx512::transform_directions,
+      avx512::normalize,
+      avx512::lengths,
+      avx512::divide_by_w,
+      avx512::clip_to_screen,
+      avx512::clamp_to_unit_interval,
+      avx512::pack_rgba8,
+      avx512::pack_bgra8,
+      avx512::unpack_rgba8,
+      avx512::unpack_bgra8,
+      // closed_unit_interval arithmetic and conversion have no AVX-512 kernels.
+      avx::multiply,
+      avx::multiply,
+      avx::multiply,
+      avx::lerp,
+      avx::lerp,
+      avx::lerp,
+      avx::quantize,
+      avx::quantize,
+      avx::quantize};
+
+    switch(level)
+    {
+    case isa::avx512:
+        return avx512;
+    case isa::avx2:
+        return avx2;
+    default:
+        return sse41;
+    }
+}
+
+/** highest instruction set supported by the CPU and the operating system. determined once. */
+inline isa supported()
+{
+    static const isa level = []() -> isa
+    {
+        __builtin_cpu_init();
+
+        const bool has_avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        if(has_avx2 && __builtin_cpu_supports("avx512f"))
+        {
+            return isa::avx512;
+        }
+        return has_avx2 ? isa::avx2 : isa::sse41;
+    }();
+
+    return level;
+}
+
+/** the currently selected kernels. */
+inline std::atomic<const batch_kernels*>& active_kernels()
+{
+    static std::atomic<const batch_kernels*> kernels{&kernels_for(supported())};
+    return kernels;
+}
+
+/** the instruction set of the currently selected kernels. */
+inline isa active()
+{
+    return active_kernels().load(std::memory_order_relaxed)->level;
+}
+
+/**
+ * force the kernels of a specific instruction set, e.g. for benchmarking.
+ * returns false and leaves the selection unchanged if the CPU does not support it.
+ */
+inline bool force(isa level)
+{
+    if(level > supported())
+    {
+        return false;
+    }
+
+    active_kernels().store(&kernels_for(level), std::memory_order_relaxed);
+    return true;
+}
+
+/** restore the automatic selection. */
+inline void reset()
+{
+    force(supported());
+}
+
+/** transform homogeneous vectors, out[i] = m * in[i]. in and out may be the same array. */
+inline void transform(const simd::mat4x4& m, std::span<const simd::vec4> in, std::span<simd::vec4> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->transform(m, in, out);
+}
+
+/** transform points, out[i] = m * vec4{in[i], 1}. */
+inline void transform_points(const simd::mat4x4& m, std::span<const vec3> in, std::span<simd::vec4> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->transform_points(m, in, out);
+}
+
+/** transform directions, out[i] = (m * vec4{in[i], 0}).xyz(). in and out may be the same array. */
+inline void transform_directions(const simd::mat4x4& m, std::span<const vec3> in, std::span<vec3> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->transform_directions(m, in, out);
+}
+
+/** normalize vectors. Zero vectors are left unchanged. */
+inline void normalize(std::span<simd::vec4> v)
+{
+    active_kernels().load(std::memory_order_relaxed)->normalize(v);
+}
+
+/** normalize 3d vectors. Zero vectors are left unchanged. The SSE kernel is used for all instruction sets. */
+inline void normalize(std::span<vec3> v)
+{
+    simd::normalize(v);
+}
+
+/** vector lengths, out[i] = in[i].length(). */
+inline void lengths(std::span<const simd::vec4> in, std::span<float> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->lengths(in, out);
+}
+
+/** 3d vector lengths, out[i] = in[i].length(). The SSE kernel is used for all instruction sets. */
+inline void lengths(std::span<const vec3> in, std::span<float> out)
+{
+    simd::lengths(in, out);
+}
+
+/** divide xyz by w and store 1/w in w. All w components have to be non-zero. */
+inline void divide_by_w(std::span<simd::vec4> v)
+{
+    active_kernels().load(std::memory_order_relaxed)->divide_by_w(v);
+}
+
+/**
+ * transform clip coordinates to screen coordinates: divide xyz by w, apply the viewport
+ * transformation xyz*scale + bias and store 1/w in w. All w components have to be non-zero.
+ */
+inline void clip_to_screen(std::span<simd::vec4> v, const vec3& scale, const vec3& bias)
+{
+    active_kernels().load(std::memory_order_relaxed)->clip_to_screen(v, scale, bias);
+}
+
+/** clamp all vector components to the interval [0,1]. */
+inline void clamp_to_unit_interval(std::span<simd::vec4> v)
+{
+    active_kernels().load(std::memory_order_relaxed)->clamp_to_unit_interval(v);
+}
+
+/** pack colors into RGBA8, out[i] = pack_rgba8(in[i]). */
+inline void pack_rgba8(std::span<const simd::vec4> in, std::span<std::uint32_t> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->pack_rgba8(in, out);
+}
+
+/** pack colors into BGRA8, out[i] = pack_bgra8(in[i]). */
+inline void pack_bgra8(std::span<const simd::vec4> in, std::span<std::uint32_t> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->pack_bgra8(in, out);
+}
+
+/** unpack RGBA8 colors, out[i] = unpack_rgba8(in[i]). */
+inline void unpack_rgba8(std::span<const std::uint32_t> in, std::span<simd::vec4> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->unpack_rgba8(in, out);
+}
+
+/** unpack BGRA8 colors, out[i] = unpack_bgra8(in[i]). */
+inline void unpack_bgra8(std::span<const std::uint32_t> in, std::span<simd::vec4> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->unpack_bgra8(in, out);
+}
+
+/** out[i] = a[i] * b[i]. */
+inline void multiply(std::span<const fixed_8_t> a, std::span<const fixed_8_t> b, std::span<fixed_8_t> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->multiply8(a, b, out);
+}
+
+/** out[i] = a[i] * b[i]. */
+inline void multiply(std::span<const fixed_16_t> a, std::span<const fixed_16_t> b, std::span<fixed_16_t> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->multiply16(a, b, out);
+}
+
+/** out[i] = a[i] * b[i]. */
+inline void multiply(std::span<const fixed_32_t> a, std::span<const fixed_32_t> b, std::span<fixed_32_t> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->multiply32(a, b, out);
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]). */
+inline void lerp(std::span<const fixed_8_t> t, std::span<const fixed_8_t> a, std::span<const fixed_8_t> b, std::span<fixed_8_t> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->lerp8(t, a, b, out);
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]). */
+inline void lerp(std::span<const fixed_16_t> t, std::span<const fixed_16_t> a, std::span<const fixed_16_t> b, std::span<fixed_16_t> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->lerp16(t, a, b, out);
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]). */
+inline void lerp(std::span<const fixed_32_t> t, std::span<const fixed_32_t> a, std::span<const fixed_32_t> b, std::span<fixed_32_t> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->lerp32(t, a, b, out);
+}
+
+/** out[i] = fixed_8_t{in[i]}. */
+inline void quantize(std::span<const float> in, std::span<fixed_8_t> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->quantize8(in, out);
+}
+
+/** out[i] = fixed_16_t{in[i]}. */
+inline void quantize(std::span<const float> in, std::span<fixed_16_t> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->quantize16(in, out);
+}
+
+/** out[i] = fixed_32_t{in[i]}. */
+inline void quantize(std::span<const float> in, std::span<fixed_32_t> out)
+{
+    active_kernels().load(std::memory_order_relaxed)->quantize32(in, out);
+}
+
+} /* namespace dispatch */
+
+} /* namespace ml */
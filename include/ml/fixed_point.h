@@ -27,4 +27,10 @@ typedef cnl::static_number<31, -8> fixed_24_8_t;
 /** unsigned 32 bit unsigned fixed point type with one represented as ~0. */
 typedef closed_unit_interval<std::uint32_t> fixed_32_t;
 
+/** unsigned 16 bit unsigned fixed point type with one represented as ~0. */
+typedef closed_unit_interval<std::uint16_t> fixed_16_t;
+
+/** unsigned 8 bit unsigned fixed point type with one represented as ~0. */
+typedef closed_unit_interval<std::uint8_t> fixed_8_t;
+
 } /* namespace ml */
\ No newline at end of file
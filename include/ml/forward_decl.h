@@ -13,17 +13,27 @@ namespace ml
 
 struct vec2;
 struct vec3;
-#if defined(ML_USE_SIMD)
+#if defined(ML_USE_SIMD) && defined(ML_SIMD_X86)
 namespace simd
 {
 struct vec4;
 } /* namespace simd */
 using vec4 = simd::vec4;
+#elif defined(ML_USE_SIMD) && defined(ML_SIMD_PORTABLE)
+namespace portable
+{
+struct vec4;
+} /* namespace portable */
+using vec4 = portable::vec4;
 #elif defined(ML_INCLUDE_SIMD)
 namespace simd
 {
 struct vec4;
 } /* namespace simd */
+namespace portable
+{
+struct vec4;
+} /* namespace portable */
 struct vec4;
 #else
 struct vec4;
@@ -0,0 +1,116 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * view frustum planes and bounding volumes in structure-of-arrays layout.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+/**
+ * The six planes of a view frustum, with unit normals pointing into the frustum. A point p
+ * is inside if all plane distances dot(n,p) + d are non-negative.
+ */
+struct frustum
+{
+    /** plane indices. */
+    enum plane_index
+    {
+        left_plane,
+        right_plane,
+        bottom_plane,
+        top_plane,
+        near_plane,
+        far_plane
+    };
+
+    normalized_plane planes[6];
+
+    frustum() = default;
+
+    /**
+     * extract the planes of the clip volume -w <= x, y, z <= w of a (row-major) view-projection
+     * matrix, as produced by matrices::perspective_projection and matrices::orthographic_projection
+     * (Gribb/Hartmann). For a model-view-projection matrix, the planes are in model space.
+     */
+    explicit frustum(const mat4x4& m)
+    {
+        const vec4& r0 = m.rows[0];
+        const vec4& r1 = m.rows[1];
+        const vec4& r2 = m.rows[2];
+        const vec4& r3 = m.rows[3];
+
+        const vec4 p[6] = {r3 + r0, r3 - r0, r3 + r1, r3 - r1, r3 + r2, r3 - r2};
+        for(int i = 0; i < 6; ++i)
+        {
+            planes[i] = normalized_plane{plane{p[i].x, p[i].y, p[i].z, p[i].w}};
+        }
+    }
+
+    /** whether a sphere intersects the frustum. Spheres close to the edges may be accepted although they are outside. */
+    bool intersects_sphere(const vec3& center, float radius) const
+    {
+        for(const normalized_plane& p: planes)
+        {
+            if(p.distance(center) < -radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * whether an axis-aligned box intersects the frustum, by testing the corner farthest along
+     * each plane normal. Boxes close to the edges may be accepted although they are outside.
+     */
+    bool intersects_aabb(const vec3& min, const vec3& max) const
+    {
+        for(const normalized_plane& p: planes)
+        {
+            const vec3 corner{
+              p.normal.x >= 0 ? max.x : min.x,
+              p.normal.y >= 0 ? max.y : min.y,
+              p.normal.z >= 0 ? max.z : min.z};
+            if(p.distance(corner) < 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** whether a box intersects the frustum. */
+    bool intersects_aabb(const aabb3& b) const
+    {
+        return intersects_aabb(b.min, b.max);
+    }
+};
+
+/** spheres in structure-of-arrays layout. All arrays have the same size. */
+struct sphere_array
+{
+    std::span<const float> x, y, z, radius;
+
+    std::size_t size() const
+    {
+        return x.size();
+    }
+};
+
+/** axis-aligned boxes in structure-of-arrays layout. All arrays have the same size. */
+struct aabb_array
+{
+    std::span<const float> min_x, min_y, min_z, max_x, max_y, max_z;
+
+    std::size_t size() const
+    {
+        return min_x.size();
+    }
+};
+
+} /* namespace ml */
@@ -11,17 +11,47 @@
 namespace ml
 {
 
+#if defined(ML_SIMD_X86)
+namespace simd
+{
+
 /** Linear vector interpolation. */
 inline vec4 lerp(float t, vec4 v1, vec4 v2)
 {
+#    if defined(ML_USE_FMA)
+    // same as lerp(float, float, float).
+    const __m128 t4 = _mm_set_ps1(t);
+    return {_mm_fmadd_ps(t4, v2.data, _mm_fnmadd_ps(t4, v1.data, v1.data))};
+#    else
     return v1 * (1 - t) + v2 * t;
+#    endif
 }
 
+} /* namespace simd */
+#endif /* defined(ML_SIMD_X86) */
+
+#if defined(ML_USE_SIMD) && defined(ML_SIMD_X86)
+using simd::lerp;
+#else
+/** Linear vector interpolation. */
+inline vec4 lerp(float t, vec4 v1, vec4 v2)
+{
+#    if defined(ML_USE_FMA)
+    // same as lerp(float, float, float).
+    return {lerp(t, v1.x, v2.x), lerp(t, v1.y, v2.y), lerp(t, v1.z, v2.z), lerp(t, v1.w, v2.w)};
+#    else
+    return v1 * (1 - t) + v2 * t;
+#    endif
+}
+#endif
+
 /** clamp a vector to the interval [0,1]. */
 inline vec4 clamp_to_unit_interval(vec4 v)
 {
-#if defined(ML_USE_SIMD)
+#if defined(ML_USE_SIMD) && defined(ML_SIMD_X86)
     return {_mm_min_ps(_mm_max_ps(v.data, _mm_set_ps1(0.0f)), _mm_set_ps1(1.0f))};
+#elif defined(ML_USE_SIMD) && defined(ML_SIMD_PORTABLE)
+    return vec4{portable::stdx::min(portable::stdx::max(v.data(), portable::float4{0.0f}), portable::float4{1.0f})};
 #elif !defined(ML_NO_BOOST)
     return {
       boost::algorithm::clamp(v.x, 0, 1),
@@ -37,4 +67,45 @@ inline vec4 clamp_to_unit_interval(vec4 v)
 #endif
 }
 
+/*
+ * 8-bit color packing. The color components are clamped to [0,1], scaled by 255 and rounded
+ * to nearest (as the current rounding mode of the SSE conversions). RGBA8 stores the bytes
+ * in the order R, G, B, A, i.e. red is the least significant byte, and BGRA8 in the order
+ * B, G, R, A.
+ */
+
+/** pack a color into RGBA8. */
+inline std::uint32_t pack_rgba8(const vec4& c)
+{
+    const vec4 v = clamp_to_unit_interval(c) * 255.0f;
+    return static_cast<std::uint32_t>(std::lrint(v.x))
+           | (static_cast<std::uint32_t>(std::lrint(v.y)) << 8)
+           | (static_cast<std::uint32_t>(std::lrint(v.z)) << 16)
+           | (static_cast<std::uint32_t>(std::lrint(v.w)) << 24);
+}
+
+/** pack a color into BGRA8. */
+inline std::uint32_t pack_bgra8(const vec4& c)
+{
+    return pack_rgba8({c.z, c.y, c.x, c.w});
+}
+
+/** unpack a RGBA8 color. */
+inline vec4 unpack_rgba8(std::uint32_t c)
+{
+    return vec4{
+             static_cast<float>(c & 0xff),
+             static_cast<float>((c >> 8) & 0xff),
+             static_cast<float>((c >> 16) & 0xff),
+             static_cast<float>(c >> 24)}
+           * (1.0f / 255.0f);
+}
+
+/** unpack a BGRA8 color. */
+inline vec4 unpack_bgra8(std::uint32_t c)
+{
+    const vec4 v = unpack_rgba8(c);
+    return {v.z, v.y, v.x, v.w};
+}
+
 } /* namespace ml */
\ No newline at end of file
@@ -34,10 +34,77 @@ struct plane : public vec4
     {
     }
 
+    plane& operator=(const plane&) = default;
+
+    /** signed distance of a point. The normal is normalized on every call, see normalized_plane. */
     float distance(vec3 p) const
     {
         const auto proj = xyz();
-        return (proj.dot_product(p) + w) / proj.length();
+        if constexpr(std::is_same_v<precision::default_policy, precision::exact>)
+        {
+            return (proj.dot_product(p) + w) / proj.length();
+        }
+        else
+        {
+            return (proj.dot_product(p) + w) * rsqrt(proj.length_squared());
+        }
+    }
+};
+
+/** side of a plane on which a point lies. */
+enum class plane_side
+{
+    back = -1,
+    on = 0,
+    front = 1
+};
+
+/**
+ * A plane with unit normal, so that the signed distance of a point is a single dot product.
+ * The normal points to the front side.
+ */
+struct normalized_plane
+{
+    vec3 normal{0, 0, 1};
+    float d{0};
+
+    normalized_plane() = default;
+
+    /** normalize a plane. The normal of p must not be zero. */
+    explicit normalized_plane(const plane& p)
+    {
+        const float s = 1.0f / p.xyz().length();
+        normal = p.xyz() * s;
+        d = p.w * s;
+    }
+
+    /** plane from a unit normal and the offset d, without normalization. */
+    static normalized_plane from_unit_normal(const vec3& n, float d)
+    {
+        normalized_plane p;
+        p.normal = n;
+        p.d = d;
+        return p;
+    }
+
+    /** plane through a point, with normal n. */
+    static normalized_plane from_point_normal(const vec3& point, const vec3& n)
+    {
+        const vec3 u = n.normalized();
+        return from_unit_normal(u, -u.dot_product(point));
+    }
+
+    /** signed distance of a point. */
+    float distance(const vec3& p) const
+    {
+        return normal.dot_product(p) + d;
+    }
+
+    /** side of a point. Points within epsilon of the plane are on it. */
+    plane_side classify(const vec3& p, float epsilon) const
+    {
+        const float dist = distance(p);
+        return dist > epsilon ? plane_side::front : (dist < -epsilon ? plane_side::back : plane_side::on);
     }
 };
 
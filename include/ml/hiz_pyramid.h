@@ -0,0 +1,257 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * hierarchical min/max depth pyramid for conservative occlusion queries.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+/**
+ * Hierarchical depth pyramid over a depth_buffer.
+ *
+ * Level 0 holds the depth range of each 8x8 tile of the depth buffer, and each further level
+ * holds the ranges of 2x2 cells of the level below, down to a single cell. Only the samples
+ * inside the depth buffer are included, i.e. the padding of the border tiles is ignored.
+ *
+ * The pyramid is updated incrementally: tiles that were written to are marked as dirty, and
+ * update recomputes the dirty tiles and their ancestors.
+ */
+class hiz_pyramid
+{
+public:
+    /** a level of the pyramid. */
+    struct level
+    {
+        /** size in cells. */
+        int width{0}, height{0};
+
+        /** depth ranges of the cells, in row-major order. */
+        std::vector<depth_range> cells;
+
+        /** dirty flags of the cells. */
+        std::vector<std::uint8_t> dirty;
+
+        depth_range& at(int x, int y)
+        {
+            return cells[static_cast<std::size_t>(y) * width + x];
+        }
+        const depth_range& at(int x, int y) const
+        {
+            return cells[static_cast<std::size_t>(y) * width + x];
+        }
+    };
+
+private:
+    /** size of the depth buffer in samples. */
+    int w{0}, h{0};
+
+    /** levels, starting at the tile level. */
+    std::vector<level> levels;
+
+    /** depth range of the samples of a tile that are inside the depth buffer. */
+    depth_range tile_range(const depth_buffer& buffer, int tx, int ty) const
+    {
+        constexpr int size = depth_buffer::tile_size;
+        const fixed_32_t* samples = buffer.get_tile(tx, ty).samples;
+
+        const int columns = std::min(w - tx * size, size), rows = std::min(h - ty * size, size);
+#if defined(ML_SIMD_X86)
+        if(columns == size && rows == size)
+        {
+            return simd::depth_range_x64(samples);
+        }
+#endif
+
+        depth_range r;
+        for(int y = 0; y < rows; ++y)
+        {
+            for(int x = 0; x < columns; ++x)
+            {
+                r.merge({samples[y * size + x], samples[y * size + x]});
+            }
+        }
+        return r;
+    }
+
+public:
+    hiz_pyramid() = default;
+
+    /** create the pyramid for a depth buffer and build all levels. */
+    explicit hiz_pyramid(const depth_buffer& buffer)
+    : w{buffer.width()}
+    , h{buffer.height()}
+    {
+        int lw = buffer.tile_count_x(), lh = buffer.tile_count_y();
+        while(true)
+        {
+            level l;
+            l.width = lw;
+            l.height = lh;
+            l.cells.resize(static_cast<std::size_t>(lw) * lh);
+            l.dirty.resize(l.cells.size(), 1);
+            levels.push_back(std::move(l));
+
+            if(lw <= 1 && lh <= 1)
+            {
+                break;
+            }
+            lw = (lw + 1) / 2;
+            lh = (lh + 1) / 2;
+        }
+
+        update(buffer);
+    }
+
+    /** number of levels. */
+    int level_count() const
+    {
+        return static_cast<int>(levels.size());
+    }
+
+    /** access a level. level 0 has one cell per tile of the depth buffer. */
+    const level& get_level(int i) const
+    {
+        return levels[i];
+    }
+
+    /** mark the tile (tx,ty) as dirty, e.g. after depth_buffer::test_and_update wrote to it. */
+    void mark_dirty(int tx, int ty)
+    {
+        levels[0].dirty[static_cast<std::size_t>(ty) * levels[0].width + tx] = 1;
+    }
+
+    /** mark the tiles overlapping the pixel rectangle [x0,x1) x [y0,y1) as dirty. */
+    void mark_dirty(int x0, int y0, int x1, int y1)
+    {
+        constexpr int size = depth_buffer::tile_size;
+        x0 = std::max(x0, 0);
+        y0 = std::max(y0, 0);
+        x1 = std::min(x1, w);
+        y1 = std::min(y1, h);
+        for(int ty = y0 / size; ty * size < y1; ++ty)
+        {
+            for(int tx = x0 / size; tx * size < x1; ++tx)
+            {
+                mark_dirty(tx, ty);
+            }
+        }
+    }
+
+    /** mark all tiles as dirty, e.g. after clearing the depth buffer. */
+    void mark_all_dirty()
+    {
+        std::fill(levels[0].dirty.begin(), levels[0].dirty.end(), 1);
+    }
+
+    /** recompute the dirty tiles from the depth buffer and propagate them through the pyramid. */
+    void update(const depth_buffer& buffer)
+    {
+        assert(buffer.width() == w && buffer.height() == h);
+
+        level& base = levels[0];
+        for(int ty = 0; ty < base.height; ++ty)
+        {
+            for(int tx = 0; tx < base.width; ++tx)
+            {
+                std::uint8_t& dirty = base.dirty[static_cast<std::size_t>(ty) * base.width + tx];
+                if(dirty)
+                {
+                    base.at(tx, ty) = tile_range(buffer, tx, ty);
+                    dirty = 0;
+                    if(levels.size() > 1)
+                    {
+                        levels[1].dirty[static_cast<std::size_t>(ty / 2) * levels[1].width + tx / 2] = 1;
+                    }
+                }
+            }
+        }
+
+        for(std::size_t i = 1; i < levels.size(); ++i)
+        {
+            const level& child = levels[i - 1];
+            level& l = levels[i];
+            for(int y = 0; y < l.height; ++y)
+            {
+                for(int x = 0; x < l.width; ++x)
+                {
+                    std::uint8_t& dirty = l.dirty[static_cast<std::size_t>(y) * l.width + x];
+                    if(!dirty)
+                    {
+                        continue;
+                    }
+
+                    depth_range r;
+                    for(int cy = 2 * y; cy < std::min(2 * y + 2, child.height); ++cy)
+                    {
+                        for(int cx = 2 * x; cx < std::min(2 * x + 2, child.width); ++cx)
+                        {
+                            r.merge(child.at(cx, cy));
+                        }
+                    }
+                    l.at(x, y) = r;
+                    dirty = 0;
+                    if(i + 1 < levels.size())
+                    {
+                        levels[i + 1].dirty[static_cast<std::size_t>(y / 2) * levels[i + 1].width + x / 2] = 1;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * conservative range of the depths in the pixel rectangle [x0,x1) x [y0,y1), clipped to the
+     * depth buffer. It is read from the finest level on which the rectangle overlaps at most
+     * 2x2 cells, so the result may include depths from outside of the rectangle.
+     */
+    depth_range query(int x0, int y0, int x1, int y1) const
+    {
+        x0 = std::max(x0, 0);
+        y0 = std::max(y0, 0);
+        x1 = std::min(x1, w);
+        y1 = std::min(y1, h);
+        if(x0 >= x1 || y0 >= y1)
+        {
+            return {};
+        }
+
+        // cell coordinates on level 0.
+        int cx0 = x0 / depth_buffer::tile_size, cy0 = y0 / depth_buffer::tile_size;
+        int cx1 = (x1 - 1) / depth_buffer::tile_size, cy1 = (y1 - 1) / depth_buffer::tile_size;
+
+        std::size_t i = 0;
+        while(i + 1 < levels.size() && (cx1 - cx0 > 1 || cy1 - cy0 > 1))
+        {
+            cx0 >>= 1;
+            cy0 >>= 1;
+            cx1 >>= 1;
+            cy1 >>= 1;
+            ++i;
+        }
+
+        const level& l = levels[i];
+        depth_range r = l.at(cx0, cy0);
+        r.merge(l.at(cx1, cy0));
+        r.merge(l.at(cx0, cy1));
+        r.merge(l.at(cx1, cy1));
+        return r;
+    }
+
+    /**
+     * conservative visibility test of the pixel rectangle [x0,x1) x [y0,y1) at depth z. Returns
+     * false only if no sample of the rectangle can pass the depth test, e.g. for an object whose
+     * bounding rectangle on the screen is occluded at its nearest depth z.
+     */
+    bool maybe_visible(int x0, int y0, int x1, int y1, fixed_32_t z, depth_compare f = depth_compare::less) const
+    {
+        const depth_range r = query(x0, y0, x1, y1);
+        return !r.empty() && r.may_pass(f, z);
+    }
+};
+
+} /* namespace ml */
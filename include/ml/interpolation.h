@@ -0,0 +1,99 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * perspective-correct interpolation of vertex attributes over a triangle.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+/**
+ * plane equation of a value over the screen, v(x,y) = v0 + dvdx*(x - x0) + dvdy*(y - y0),
+ * where (x0, y0) is the first vertex of the triangle.
+ */
+struct screen_plane
+{
+    float v0{0}, dvdx{0}, dvdy{0};
+
+    /** value at the offset (dx, dy) from the first vertex. */
+    float evaluate(float dx, float dy) const
+    {
+        return v0 + dvdx * dx + dvdy * dy;
+    }
+};
+
+/**
+ * Perspective-correct interpolation of N attributes over a triangle.
+ *
+ * The vertices are expected after the perspective divide (e.g. by divide_by_w or
+ * clip_to_screen), i.e. x and y are screen coordinates, z is the depth and w is 1/w.
+ * Since 1/w and a/w are affine functions of the screen coordinates, their plane equations
+ * are computed once per triangle, and an attribute is interpolated as (a/w)(x,y) / (1/w)(x,y).
+ * The depth is interpolated without correction.
+ *
+ * The triangle must not be degenerate, i.e. its screen area must not be zero.
+ */
+template<std::size_t N>
+struct triangle_interpolator
+{
+    /** screen position of the first vertex, which is the origin of the plane equations. */
+    float x0{0}, y0{0};
+
+    /** plane equations of the depth and of 1/w. */
+    screen_plane depth, one_over_w;
+
+    /** plane equations of the attributes, divided by w. */
+    screen_plane attributes[N];
+
+    /** set up the plane equations. a0, a1 and a2 are the attributes of the vertices. */
+    triangle_interpolator(
+      const vec4& v0, const vec4& v1, const vec4& v2,
+      std::span<const float, N> a0, std::span<const float, N> a1, std::span<const float, N> a2)
+    : x0{v0.x}
+    , y0{v0.y}
+    {
+        const float e1x = v1.x - v0.x, e1y = v1.y - v0.y;
+        const float e2x = v2.x - v0.x, e2y = v2.y - v0.y;
+        const float inv_area = 1.0f / (e1x * e2y - e2x * e1y);
+
+        // gradients of the barycentric coordinates of v1 and v2.
+        const float b1x = e2y * inv_area, b1y = -e2x * inv_area;
+        const float b2x = -e1y * inv_area, b2y = e1x * inv_area;
+
+        const auto plane = [=](float f0, float f1, float f2) -> screen_plane
+        {
+            const float d1 = f1 - f0, d2 = f2 - f0;
+            return {f0, d1 * b1x + d2 * b2x, d1 * b1y + d2 * b2y};
+        };
+
+        depth = plane(v0.z, v1.z, v2.z);
+        one_over_w = plane(v0.w, v1.w, v2.w);
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            attributes[i] = plane(a0[i] * v0.w, a1[i] * v1.w, a2[i] * v2.w);
+        }
+    }
+
+    /** depth at the screen position (x,y). */
+    float depth_at(float x, float y) const
+    {
+        return depth.evaluate(x - x0, y - y0);
+    }
+
+    /** interpolate the attributes at the screen position (x,y). */
+    void interpolate(float x, float y, std::span<float, N> out) const
+    {
+        const float dx = x - x0, dy = y - y0;
+        const float w = ml::rcp(one_over_w.evaluate(dx, dy));
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            out[i] = attributes[i].evaluate(dx, dy) * w;
+        }
+    }
+};
+
+} /* namespace ml */
@@ -9,19 +9,45 @@
  */
 
 #if defined(ML_USE_SIMD)
-#    include "simd/mat4x4.h"
+#    if defined(ML_SIMD_X86)
+#        include "simd/mat4x4.h"
+#        include "simd/mat4x4_cm.h"
+#        if defined(ML_SIMD_AVX2)
+#            include "avx/mat4x4.h"
+namespace ml
+{
+using mat4x4 = avx::mat4x4;
+}; /* namespace ml */
+#        else /* defined(ML_SIMD_AVX2) */
 namespace ml
 {
 using mat4x4 = simd::mat4x4;
 }; /* namespace ml */
+#        endif
+#    elif defined(ML_SIMD_PORTABLE)
+#        include "portable/mat4x4.h"
+namespace ml
+{
+using mat4x4 = portable::mat4x4;
+}; /* namespace ml */
+#    else /* defined(ML_SIMD_X86) */
+#        include "x86/mat4x4.h"
+#    endif
 #elif defined(ML_INCLUDE_SIMD)
 
 #    if defined(ML_SIMD_X86)
 #        include "x86/mat4x4.h"
 #        include "simd/mat4x4.h"
+#        include "simd/mat4x4_cm.h"
+#        if defined(ML_SIMD_AVX2)
+#            include "avx/mat4x4.h"
+#        endif
 #    else
 #        include "x86/mat4x4.h"
 #    endif /* defined(ML_INCLUDE_SIMD) */
+#    if defined(ML_SIMD_PORTABLE)
+#        include "portable/mat4x4.h"
+#    endif
 
 #else
 #    include "x86/mat4x4.h"
@@ -147,6 +147,89 @@ inline mat4x4 look_at(const vec3& eye, const vec3& target, const vec3& up)
            * translation(-eye.x, -eye.y, -eye.z);
 }
 
+#if defined(ML_SIMD_X86)
+
+/**
+ * The special matrices with column-major storage. They are generated in row-major storage
+ * and then converted, so the entries are the same.
+ */
+namespace column_major
+{
+
+/** store a row-major matrix as columns. */
+inline simd::mat4x4_cm from_rows(const mat4x4& m)
+{
+    return {
+      {m[0][0], m[1][0], m[2][0], m[3][0]},
+      {m[0][1], m[1][1], m[2][1], m[3][1]},
+      {m[0][2], m[1][2], m[2][2], m[3][2]},
+      {m[0][3], m[1][3], m[2][3], m[3][3]}};
+}
+
+/** Generate a perspective projection matrix (for a symmetric frustum). */
+inline simd::mat4x4_cm perspective_projection(float aspect, float fov, float znear, float zfar)
+{
+    return from_rows(matrices::perspective_projection(aspect, fov, znear, zfar));
+}
+
+/** Generate an orthographic projection matrix. */
+inline simd::mat4x4_cm orthographic_projection(float left, float right, float bottom, float top, float near, float far)
+{
+    return from_rows(matrices::orthographic_projection(left, right, bottom, top, near, far));
+}
+
+/** Generate a translation matrix. */
+inline simd::mat4x4_cm translation(float x, float y, float z)
+{
+    return from_rows(matrices::translation(x, y, z));
+}
+
+/** Generate a 4-dimensional diagonal matrix. */
+inline simd::mat4x4_cm diagonal(float x, float y, float z, float w)
+{
+    return from_rows(matrices::diagonal(x, y, z, w));
+}
+
+/** Generate a scaling matrix. */
+inline simd::mat4x4_cm scaling(float s)
+{
+    return from_rows(matrices::scaling(s));
+}
+
+/** Generate a right-handed rotation matrix w.r.t. x-axis. */
+inline simd::mat4x4_cm rotation_x(float angle)
+{
+    return from_rows(matrices::rotation_x(angle));
+}
+
+/** Generate a right-handed rotation matrix w.r.t. y-axis. */
+inline simd::mat4x4_cm rotation_y(float angle)
+{
+    return from_rows(matrices::rotation_y(angle));
+}
+
+/** Generate a right-handed rotation matrix w.r.t. z-axis. */
+inline simd::mat4x4_cm rotation_z(float angle)
+{
+    return from_rows(matrices::rotation_z(angle));
+}
+
+/** Generate a right-handed rotation matrix w.r.t. the given axis. */
+inline simd::mat4x4_cm rotation(ml::vec3 axis, float angle)
+{
+    return from_rows(matrices::rotation(axis, angle));
+}
+
+/** Define a viewing transformation. */
+inline simd::mat4x4_cm look_at(const vec3& eye, const vec3& target, const vec3& up)
+{
+    return from_rows(matrices::look_at(eye, target, up));
+}
+
+} /* namespace column_major */
+
+#endif /* defined(ML_SIMD_X86) */
+
 } /* namespace matrices */
 
 } /* namespace ml */
@@ -0,0 +1,156 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * classification of arrays of points against planes and plane sets.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+/** points in structure-of-arrays layout. All arrays have the same size. */
+struct point_array
+{
+    std::span<const float> x, y, z;
+
+    std::size_t size() const
+    {
+        return x.size();
+    }
+};
+
+/*
+ * The classification functions write bit masks like the culling functions: bit i % 64 of
+ * word i / 64 refers to point i, and the bits past the last point are cleared. Each mask needs
+ * to hold at least (size + 63) / 64 words. Points within epsilon of a plane are on it.
+ */
+
+/** classify an array of points as in front of, behind or on a plane. */
+inline void classify_points(
+  const normalized_plane& p, const point_array& points, float epsilon,
+  std::span<std::uint64_t> front, std::span<std::uint64_t> back, std::span<std::uint64_t> on)
+{
+    const std::size_t n = points.size();
+    const std::size_t words = (n + 63) / 64;
+    assert(points.y.size() == n && points.z.size() == n);
+    assert(front.size() >= words && back.size() >= words && on.size() >= words);
+
+    std::fill(front.begin(), front.begin() + words, 0);
+    std::fill(back.begin(), back.begin() + words, 0);
+    std::fill(on.begin(), on.begin() + words, 0);
+
+    std::size_t i = 0;
+#if defined(ML_SIMD_X86)
+#    if defined(ML_USE_AVX)
+    const simd::plane_x8 plane{p};
+    const __m256 eps = _mm256_set1_ps(epsilon);
+    for(; i + 8 <= n; i += 8)
+    {
+        const __m256 dist = plane.distance(_mm256_loadu_ps(&points.x[i]), _mm256_loadu_ps(&points.y[i]), _mm256_loadu_ps(&points.z[i]));
+        const int f = _mm256_movemask_ps(simd::front_of(dist, eps));
+        const int b = _mm256_movemask_ps(simd::back_of(dist, eps));
+        front[i / 64] |= static_cast<std::uint64_t>(f) << (i % 64);
+        back[i / 64] |= static_cast<std::uint64_t>(b) << (i % 64);
+        on[i / 64] |= static_cast<std::uint64_t>(~(f | b) & 0xff) << (i % 64);
+    }
+#    else
+    const simd::plane_x4 plane{p};
+    const __m128 eps = _mm_set_ps1(epsilon);
+    for(; i + 4 <= n; i += 4)
+    {
+        const __m128 dist = plane.distance(_mm_loadu_ps(&points.x[i]), _mm_loadu_ps(&points.y[i]), _mm_loadu_ps(&points.z[i]));
+        const int f = _mm_movemask_ps(simd::front_of(dist, eps));
+        const int b = _mm_movemask_ps(simd::back_of(dist, eps));
+        front[i / 64] |= static_cast<std::uint64_t>(f) << (i % 64);
+        back[i / 64] |= static_cast<std::uint64_t>(b) << (i % 64);
+        on[i / 64] |= static_cast<std::uint64_t>(~(f | b) & 0xf) << (i % 64);
+    }
+#    endif
+#endif
+
+    for(; i < n; ++i)
+    {
+        const plane_side side = p.classify({points.x[i], points.y[i], points.z[i]}, epsilon);
+        auto& mask = (side == plane_side::front) ? front : (side == plane_side::back ? back : on);
+        mask[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+}
+
+/**
+ * classify an array of points against a set of planes bounding a convex region. A point is
+ * in front if it is in front of all planes (inside the region), behind if it is behind at least
+ * one plane (outside), and on the boundary otherwise. For an empty set, all points are in front.
+ */
+inline void classify_points(
+  std::span<const normalized_plane> planes, const point_array& points, float epsilon,
+  std::span<std::uint64_t> front, std::span<std::uint64_t> back, std::span<std::uint64_t> on)
+{
+    const std::size_t n = points.size();
+    const std::size_t words = (n + 63) / 64;
+    assert(points.y.size() == n && points.z.size() == n);
+    assert(front.size() >= words && back.size() >= words && on.size() >= words);
+
+    std::fill(front.begin(), front.begin() + words, 0);
+    std::fill(back.begin(), back.begin() + words, 0);
+    std::fill(on.begin(), on.begin() + words, 0);
+
+    std::size_t i = 0;
+#if defined(ML_SIMD_X86)
+#    if defined(ML_USE_AVX)
+    const __m256 eps = _mm256_set1_ps(epsilon);
+    for(; i + 8 <= n; i += 8)
+    {
+        const __m256 x = _mm256_loadu_ps(&points.x[i]), y = _mm256_loadu_ps(&points.y[i]), z = _mm256_loadu_ps(&points.z[i]);
+        __m256 all_front = _mm256_castsi256_ps(_mm256_set1_epi32(-1)), any_back = _mm256_setzero_ps();
+        for(const normalized_plane& p: planes)
+        {
+            const __m256 dist = simd::plane_x8{p}.distance(x, y, z);
+            all_front = _mm256_and_ps(all_front, simd::front_of(dist, eps));
+            any_back = _mm256_or_ps(any_back, simd::back_of(dist, eps));
+        }
+        const int f = _mm256_movemask_ps(all_front);
+        const int b = _mm256_movemask_ps(any_back);
+        front[i / 64] |= static_cast<std::uint64_t>(f) << (i % 64);
+        back[i / 64] |= static_cast<std::uint64_t>(b) << (i % 64);
+        on[i / 64] |= static_cast<std::uint64_t>(~(f | b) & 0xff) << (i % 64);
+    }
+#    else
+    const __m128 eps = _mm_set_ps1(epsilon);
+    for(; i + 4 <= n; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(&points.x[i]), y = _mm_loadu_ps(&points.y[i]), z = _mm_loadu_ps(&points.z[i]);
+        __m128 all_front = _mm_castsi128_ps(_mm_set1_epi32(-1)), any_back = _mm_setzero_ps();
+        for(const normalized_plane& p: planes)
+        {
+            const __m128 dist = simd::plane_x4{p}.distance(x, y, z);
+            all_front = _mm_and_ps(all_front, simd::front_of(dist, eps));
+            any_back = _mm_or_ps(any_back, simd::back_of(dist, eps));
+        }
+        const int f = _mm_movemask_ps(all_front);
+        const int b = _mm_movemask_ps(any_back);
+        front[i / 64] |= static_cast<std::uint64_t>(f) << (i % 64);
+        back[i / 64] |= static_cast<std::uint64_t>(b) << (i % 64);
+        on[i / 64] |= static_cast<std::uint64_t>(~(f | b) & 0xf) << (i % 64);
+    }
+#    endif
+#endif
+
+    for(; i < n; ++i)
+    {
+        const vec3 point{points.x[i], points.y[i], points.z[i]};
+        bool all_front = true, any_back = false;
+        for(const normalized_plane& plane: planes)
+        {
+            const plane_side side = plane.classify(point, epsilon);
+            all_front = all_front && side == plane_side::front;
+            any_back = any_back || side == plane_side::back;
+        }
+        auto& mask = all_front ? front : (any_back ? back : on);
+        mask[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+}
+
+} /* namespace ml */
@@ -0,0 +1,410 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * batch kernels operating on arrays of vectors using std::experimental::simd.
+ *
+ * The transformations work on one vector per register. The other kernels use the
+ * native register width of the target, so they do not depend on a specific instruction set.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+/* with AVX-512, the intrinsics of GCC 12 trigger false positives (GCC bug 105593). */
+#if defined(__GNUC__) && !defined(__clang__) && defined(__AVX512F__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace ml
+{
+
+namespace portable
+{
+
+/** native float register. */
+using floatn = stdx::native_simd<float>;
+
+/**
+ * Matrix columns for the batch transformations. A matrix-vector product then is
+ * c0*x + c1*y + c2*z + c3*w, which needs no horizontal operations.
+ */
+struct mat4x4_columns
+{
+    float4 c0, c1, c2, c3;
+
+    explicit mat4x4_columns(const mat4x4& m)
+    {
+        const mat4x4 t = m.transposed();
+        c0 = t.rows[0].data();
+        c1 = t.rows[1].data();
+        c2 = t.rows[2].data();
+        c3 = t.rows[3].data();
+    }
+
+    /* same summation order as the SSE backend. */
+
+    float4 transform(const vec4& v) const
+    {
+        return (c0 * v.x + c1 * v.y) + (c2 * v.z + c3 * v.w);
+    }
+
+    /** transform a point, i.e. a vector with w=1. */
+    float4 transform_point(const vec3& p) const
+    {
+        return (c0 * p.x + c1 * p.y) + (c2 * p.z + c3);
+    }
+
+    /** transform a direction, i.e. a vector with w=0. */
+    float4 transform_direction(const vec3& d) const
+    {
+        return (c0 * d.x + c1 * d.y) + c2 * d.z;
+    }
+};
+
+/** gather component c of the next floatn::size() vectors. */
+inline floatn gather(const vec4* v, int c)
+{
+    return floatn([v, c](auto i) { return v[i][c]; });
+}
+
+/** transform homogeneous vectors, out[i] = m * in[i]. in and out may be the same array. */
+inline void transform(const mat4x4& m, std::span<const vec4> in, std::span<vec4> out)
+{
+    assert(out.size() >= in.size());
+
+    const mat4x4_columns cols{m};
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = vec4{cols.transform(in[i])};
+    }
+}
+
+/** transform points, out[i] = m * vec4{in[i], 1}. */
+inline void transform_points(const mat4x4& m, std::span<const vec3> in, std::span<vec4> out)
+{
+    assert(out.size() >= in.size());
+
+    const mat4x4_columns cols{m};
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = vec4{cols.transform_point(in[i])};
+    }
+}
+
+/** transform directions, out[i] = (m * vec4{in[i], 0}).xyz(). in and out may be the same array. */
+inline void transform_directions(const mat4x4& m, std::span<const vec3> in, std::span<vec3> out)
+{
+    assert(out.size() >= in.size());
+
+    const mat4x4_columns cols{m};
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        const float4 r = cols.transform_direction(in[i]);
+        out[i] = {r[0], r[1], r[2]};
+    }
+}
+
+/*
+ * std::experimental::simd has no reciprocal square root estimate, so the normalization and
+ * length kernels use exact square roots, independently of precision::default_policy. This
+ * includes the vectors after the last full register.
+ */
+
+/** 1/sqrt(len_sqr), and 1 for zero vectors. */
+inline float one_over_length_exact(float len_sqr)
+{
+    return len_sqr != 0.0f ? 1.0f / std::sqrt(len_sqr) : 1.0f;
+}
+
+/** normalize vectors. Zero vectors are left unchanged. */
+inline void normalize(std::span<vec4> v)
+{
+    constexpr std::size_t n = floatn::size();
+
+    std::size_t i = 0;
+    for(; i + n <= v.size(); i += n)
+    {
+        // same summation order as vec4::dot_product.
+        const floatn len_sqr([p = &v[i]](auto j) { return p[j].length_squared(); });
+
+        floatn one_over_length = 1.0f / stdx::sqrt(len_sqr);
+        stdx::where(len_sqr == 0.0f, one_over_length) = 1.0f;
+
+        // scale all four components by the broadcast factor.
+        for(std::size_t j = 0; j < n; ++j)
+        {
+            (v[i + j].data() * float4{one_over_length[j]}).copy_to(&v[i + j].x, stdx::vector_aligned);
+        }
+    }
+    for(; i < v.size(); ++i)
+    {
+        (v[i].data() * float4{one_over_length_exact(v[i].length_squared())}).copy_to(&v[i].x, stdx::vector_aligned);
+    }
+}
+
+/** normalize 3d vectors. Zero vectors are left unchanged. */
+inline void normalize(std::span<vec3> v)
+{
+    for(auto& it: v)
+    {
+        it = it.scale(one_over_length_exact(it.length_squared()));
+    }
+}
+
+/** vector lengths, out[i] = in[i].length(). */
+inline void lengths(std::span<const vec4> in, std::span<float> out)
+{
+    assert(out.size() >= in.size());
+
+    constexpr std::size_t n = floatn::size();
+
+    std::size_t i = 0;
+    for(; i + n <= in.size(); i += n)
+    {
+        const floatn x = gather(&in[i], 0), y = gather(&in[i], 1), z = gather(&in[i], 2), w = gather(&in[i], 3);
+
+        // same summation order as vec4::dot_product.
+        stdx::sqrt((x * x + y * y) + (z * z + w * w)).copy_to(&out[i], stdx::element_aligned);
+    }
+    for(; i < in.size(); ++i)
+    {
+        out[i] = in[i].length();
+    }
+}
+
+/** 3d vector lengths, out[i] = in[i].length(). */
+inline void lengths(std::span<const vec3> in, std::span<float> out)
+{
+    assert(out.size() >= in.size());
+
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = in[i].length();
+    }
+}
+
+/** divide xyz by w and store 1/w in w. All w components have to be non-zero. */
+inline void divide_by_w(std::span<vec4> v)
+{
+    constexpr std::size_t n = floatn::size();
+
+    std::size_t i = 0;
+    for(; i + n <= v.size(); i += n)
+    {
+        const floatn one_over_w = 1.0f / gather(&v[i], 3);
+        for(std::size_t j = 0; j < n; ++j)
+        {
+            v[i + j] = v[i + j].scale(one_over_w[j]);
+            v[i + j].w = one_over_w[j];
+        }
+    }
+    for(; i < v.size(); ++i)
+    {
+        v[i].divide_by_w();
+    }
+}
+
+/**
+ * transform clip coordinates to screen coordinates: divide xyz by w, apply the viewport
+ * transformation xyz*scale + bias and store 1/w in w. All w components have to be non-zero.
+ */
+inline void clip_to_screen(std::span<vec4> v, const vec3& scale, const vec3& bias)
+{
+    constexpr std::size_t n = floatn::size();
+
+    std::size_t i = 0;
+    for(; i + n <= v.size(); i += n)
+    {
+        const floatn one_over_w = 1.0f / gather(&v[i], 3);
+        const floatn x = gather(&v[i], 0) * one_over_w * scale.x + bias.x;
+        const floatn y = gather(&v[i], 1) * one_over_w * scale.y + bias.y;
+        const floatn z = gather(&v[i], 2) * one_over_w * scale.z + bias.z;
+        for(std::size_t j = 0; j < n; ++j)
+        {
+            v[i + j] = {x[j], y[j], z[j], one_over_w[j]};
+        }
+    }
+    for(; i < v.size(); ++i)
+    {
+        v[i].divide_by_w();
+        v[i].x = v[i].x * scale.x + bias.x;
+        v[i].y = v[i].y * scale.y + bias.y;
+        v[i].z = v[i].z * scale.z + bias.z;
+    }
+}
+
+/** clamp all vector components to the interval [0,1]. */
+inline void clamp_to_unit_interval(std::span<vec4> v)
+{
+    constexpr std::size_t n = floatn::size();
+    float* p = &v.data()->x;
+
+    // the array is processed as a flat array of floats.
+    std::size_t i = 0;
+    for(; i + n <= 4 * v.size(); i += n)
+    {
+        floatn r{p + i, stdx::element_aligned};
+        r = stdx::min(stdx::max(r, floatn{0.0f}), floatn{1.0f});
+        r.copy_to(p + i, stdx::element_aligned);
+    }
+    for(; i < 4 * v.size(); i += 4)
+    {
+        float4 r{p + i, stdx::vector_aligned};
+        r = stdx::min(stdx::max(r, float4{0.0f}), float4{1.0f});
+        r.copy_to(p + i, stdx::vector_aligned);
+    }
+}
+
+/** pack colors into RGBA8 or BGRA8. See pack_rgba8(const vec4&). */
+template<bool bgra>
+inline void pack_color8(std::span<const vec4> in, std::span<std::uint32_t> out)
+{
+    assert(out.size() >= in.size());
+
+    // byte positions of the components.
+    constexpr int red = bgra ? 16 : 0, blue = bgra ? 0 : 16;
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        const float4 c = stdx::min(stdx::max(in[i].data(), float4{0.0f}), float4{1.0f}) * 255.0f;
+        out[i] = (static_cast<std::uint32_t>(std::lrint(c[0])) << red)
+                 | (static_cast<std::uint32_t>(std::lrint(c[1])) << 8)
+                 | (static_cast<std::uint32_t>(std::lrint(c[2])) << blue)
+                 | (static_cast<std::uint32_t>(std::lrint(c[3])) << 24);
+    }
+}
+
+/** unpack RGBA8 or BGRA8 colors. See unpack_rgba8(std::uint32_t). */
+template<bool bgra>
+inline void unpack_color8(std::span<const std::uint32_t> in, std::span<vec4> out)
+{
+    assert(out.size() >= in.size());
+
+    constexpr int red = bgra ? 16 : 0, blue = bgra ? 0 : 16;
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        const float4 c{[c = in[i]](auto j)
+                       { return static_cast<float>((c >> (j == 0 ? red : (j == 2 ? blue : 8 * j))) & 0xff); }};
+        out[i] = vec4{c * (1.0f / 255.0f)};
+    }
+}
+
+/** pack colors into RGBA8, out[i] = pack_rgba8(in[i]). */
+inline void pack_rgba8(std::span<const vec4> in, std::span<std::uint32_t> out)
+{
+    portable::pack_color8<false>(in, out);
+}
+
+/** pack colors into BGRA8, out[i] = pack_bgra8(in[i]). */
+inline void pack_bgra8(std::span<const vec4> in, std::span<std::uint32_t> out)
+{
+    portable::pack_color8<true>(in, out);
+}
+
+/** unpack RGBA8 colors, out[i] = unpack_rgba8(in[i]). */
+inline void unpack_rgba8(std::span<const std::uint32_t> in, std::span<vec4> out)
+{
+    portable::unpack_color8<false>(in, out);
+}
+
+/** unpack BGRA8 colors, out[i] = unpack_bgra8(in[i]). */
+inline void unpack_bgra8(std::span<const std::uint32_t> in, std::span<vec4> out)
+{
+    portable::unpack_color8<true>(in, out);
+}
+
+/** out[i] = a[i] * b[i] for closed_unit_interval<T>. The loop is left to the auto-vectorizer. */
+template<typename T>
+inline void multiply_unit_interval(std::span<const closed_unit_interval<T>> a, std::span<const closed_unit_interval<T>> b, std::span<closed_unit_interval<T>> out)
+{
+    assert(b.size() >= a.size() && out.size() >= a.size());
+    for(std::size_t i = 0; i < a.size(); ++i)
+    {
+        out[i] = a[i] * b[i];
+    }
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]) for closed_unit_interval<T>. */
+template<typename T>
+inline void lerp_unit_interval(std::span<const closed_unit_interval<T>> t, std::span<const closed_unit_interval<T>> a, std::span<const closed_unit_interval<T>> b, std::span<closed_unit_interval<T>> out)
+{
+    assert(a.size() >= t.size() && b.size() >= t.size() && out.size() >= t.size());
+    for(std::size_t i = 0; i < t.size(); ++i)
+    {
+        out[i] = ml::lerp(t[i], a[i], b[i]);
+    }
+}
+
+/** out[i] = a[i] * b[i]. */
+inline void multiply(std::span<const fixed_8_t> a, std::span<const fixed_8_t> b, std::span<fixed_8_t> out)
+{
+    portable::multiply_unit_interval(a, b, out);
+}
+
+/** out[i] = a[i] * b[i]. */
+inline void multiply(std::span<const fixed_16_t> a, std::span<const fixed_16_t> b, std::span<fixed_16_t> out)
+{
+    portable::multiply_unit_interval(a, b, out);
+}
+
+/** out[i] = a[i] * b[i]. */
+inline void multiply(std::span<const fixed_32_t> a, std::span<const fixed_32_t> b, std::span<fixed_32_t> out)
+{
+    portable::multiply_unit_interval(a, b, out);
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]). */
+inline void lerp(std::span<const fixed_8_t> t, std::span<const fixed_8_t> a, std::span<const fixed_8_t> b, std::span<fixed_8_t> out)
+{
+    portable::lerp_unit_interval(t, a, b, out);
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]). */
+inline void lerp(std::span<const fixed_16_t> t, std::span<const fixed_16_t> a, std::span<const fixed_16_t> b, std::span<fixed_16_t> out)
+{
+    portable::lerp_unit_interval(t, a, b, out);
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]). */
+inline void lerp(std::span<const fixed_32_t> t, std::span<const fixed_32_t> a, std::span<const fixed_32_t> b, std::span<fixed_32_t> out)
+{
+    portable::lerp_unit_interval(t, a, b, out);
+}
+
+/** out[i] = closed_unit_interval<T>{in[i]}. The loop is left to the auto-vectorizer. */
+template<typename T>
+inline void quantize_unit_interval(std::span<const float> in, std::span<closed_unit_interval<T>> out)
+{
+    assert(out.size() >= in.size());
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = closed_unit_interval<T>{in[i]};
+    }
+}
+
+/** out[i] = fixed_8_t{in[i]}. */
+inline void quantize(std::span<const float> in, std::span<fixed_8_t> out)
+{
+    portable::quantize_unit_interval(in, out);
+}
+
+/** out[i] = fixed_16_t{in[i]}. */
+inline void quantize(std::span<const float> in, std::span<fixed_16_t> out)
+{
+    portable::quantize_unit_interval(in, out);
+}
+
+/** out[i] = fixed_32_t{in[i]}. */
+inline void quantize(std::span<const float> in, std::span<fixed_32_t> out)
+{
+    portable::quantize_unit_interval(in, out);
+}
+
+} /* namespace portable */
+
+} /* namespace ml */
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__AVX512F__)
+#    pragma GCC diagnostic pop
+#endif
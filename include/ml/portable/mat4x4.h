@@ -0,0 +1,168 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * 4d matrix implementation using std::experimental::simd.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+namespace portable
+{
+
+/** 4x4 matrix */
+struct mat4x4
+{
+    vec4 rows[4];
+
+    mat4x4()
+    {
+        *this = zero();
+    }
+    mat4x4(const vec4& row0, const vec4& row1, const vec4& row2, const vec4& row3)
+    : rows{row0, row1, row2, row3}
+    {
+    }
+
+    mat4x4(const mat4x4&) = default;
+    mat4x4(mat4x4&&) = default;
+
+    mat4x4& operator=(const mat4x4&) = default;
+
+    /* matrix-matrix operations. */
+    mat4x4 operator+(const mat4x4& m) const
+    {
+        return {
+          rows[0] + m.rows[0],
+          rows[1] + m.rows[1],
+          rows[2] + m.rows[2],
+          rows[3] + m.rows[3],
+        };
+    }
+    mat4x4 operator-(const mat4x4& m) const
+    {
+        return {
+          rows[0] - m.rows[0],
+          rows[1] - m.rows[1],
+          rows[2] - m.rows[2],
+          rows[3] - m.rows[3],
+        };
+    }
+    mat4x4 operator-() const
+    {
+        return {-rows[0], -rows[1], -rows[2], -rows[3]};
+    }
+    mat4x4 operator*(const mat4x4& m) const
+    {
+        const float4 b0 = m.rows[0].data(), b1 = m.rows[1].data(), b2 = m.rows[2].data(), b3 = m.rows[3].data();
+
+        mat4x4 res;
+        for(int i = 0; i < 4; ++i)
+        {
+            const vec4& a = rows[i];
+
+            // binary add to reduce cumulative errors, in the same order as the SSE backend.
+            res.rows[i] = vec4{(b0 * a.x + b2 * a.z) + (b1 * a.y + b3 * a.w)};
+        }
+        return res;
+    }
+
+    /* matrix-vector multiplication. */
+    vec4 operator*(const vec4& v) const
+    {
+        return {rows[0].dot_product(v), rows[1].dot_product(v), rows[2].dot_product(v), rows[3].dot_product(v)};
+    }
+
+    /* scaling */
+    mat4x4 operator*(float s) const
+    {
+        return {rows[0] * s, rows[1] * s, rows[2] * s, rows[3] * s};
+    }
+
+    /* assignments */
+    mat4x4& operator*=(const mat4x4 m)
+    {
+        *this = *this * m;
+        return *this;
+    }
+
+    mat4x4 operator*=(float s)
+    {
+        *this = *this * s;
+        return *this;
+    }
+    mat4x4 operator/=(float s)
+    {
+        *this = *this * (1.0f / s);
+        return *this;
+    }
+
+    /* exact comparisons */
+    bool operator==(const mat4x4& m) const
+    {
+        return rows[0] == m.rows[0] && rows[1] == m.rows[1] && rows[2] == m.rows[2] && rows[3] == m.rows[3];
+    }
+    bool operator!=(const mat4x4& m) const
+    {
+        return rows[0] != m.rows[0] || rows[1] != m.rows[1] || rows[2] != m.rows[2] || rows[3] != m.rows[3];
+    }
+
+    /* matrix transformations */
+    void transpose()
+    {
+        std::swap(rows[0].y, rows[1].x);
+        std::swap(rows[0].z, rows[2].x);
+        std::swap(rows[0].w, rows[3].x);
+        std::swap(rows[1].z, rows[2].y);
+        std::swap(rows[1].w, rows[3].y);
+        std::swap(rows[2].w, rows[3].z);
+    }
+
+    mat4x4 transposed() const
+    {
+        mat4x4 m{*this};
+        m.transpose();
+        return m;
+    }
+
+    /* access. */
+    vec4& operator[](int c)
+    {
+        assert(c >= 0 && c < 4);
+        return rows[c];
+    }
+    vec4 operator[](int c) const
+    {
+        assert(c >= 0 && c < 4);
+        return rows[c];
+    }
+
+    /* special matrices. */
+    static mat4x4 identity()
+    {
+        return {
+          {1.0f, 0.0f, 0.0f, 0.0f},
+          {0.0f, 1.0f, 0.0f, 0.0f},
+          {0.0f, 0.0f, 1.0f, 0.0f},
+          {0.0f, 0.0f, 0.0f, 1.0f},
+        };
+    }
+
+    static mat4x4 one()
+    {
+        return mat4x4{vec4::one(), vec4::one(), vec4::one(), vec4::one()};
+    }
+
+    static mat4x4 zero()
+    {
+        return mat4x4{vec4::zero(), vec4::zero(), vec4::zero(), vec4::zero()};
+    }
+};
+
+} /* namespace portable */
+
+} /* namespace ml */
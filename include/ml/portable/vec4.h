@@ -0,0 +1,287 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * 4d vector implementation using std::experimental::simd.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+namespace portable
+{
+
+namespace stdx = std::experimental;
+
+/** 4-wide float register. Maps to SSE, NEON or scalar code, depending on the target. */
+using float4 = stdx::fixed_size_simd<float, 4>;
+
+/** 4-dimensional vector */
+struct alignas(16) vec4
+{
+    union
+    {
+        struct
+        {
+            float x, y, z, w;
+        };
+        struct
+        {
+            float r, g, b, a;
+        };
+        struct
+        {
+            float s, t, p, q;
+        };
+    };
+
+    vec4()
+    : x{0}
+    , y{0}
+    , z{0}
+    , w{1}
+    {
+    }
+
+    explicit vec4(const float4& v)
+    {
+        v.copy_to(&x, stdx::vector_aligned);
+    }
+
+    vec4(const vec3& v)
+    : x{v.x}
+    , y{v.y}
+    , z{v.z}
+    , w{1}
+    {
+    }
+
+    vec4(const vec3& v, float in_w)
+    : x{v.x}
+    , y{v.y}
+    , z{v.z}
+    , w{in_w}
+    {
+    }
+
+    vec4(float in_x, float in_y, float in_z)
+    : x{in_x}
+    , y{in_y}
+    , z{in_z}
+    , w{1}
+    {
+    }
+
+    vec4(float in_x, float in_y, float in_z, float in_w)
+    : x{in_x}
+    , y{in_y}
+    , z{in_z}
+    , w{in_w}
+    {
+    }
+
+    vec4(float v[4])
+    : x{v[0]}
+    , y{v[1]}
+    , z{v[2]}
+    , w{v[3]}
+    {
+    }
+
+    vec4(const vec4&) = default;
+    vec4(vec4&&) = default;
+
+    vec4& operator=(const vec4&) = default;
+
+    /** load the components into a register. */
+    float4 data() const
+    {
+        return float4{&x, stdx::vector_aligned};
+    }
+
+    /** divide xyz by w and store 1/w in w */
+    void divide_by_w()
+    {
+        assert(w != 0.f);
+
+        const auto one_over_w = ml::rcp(w);
+        *this = scale(one_over_w);
+        w = one_over_w;
+    }
+
+    bool is_zero() const
+    {
+        return stdx::all_of(data() == 0.0f);
+    }
+
+    float length_squared() const
+    {
+        return dot_product(*this);
+    }
+
+    float length() const
+    {
+#ifdef __GNUC__
+        return sqrtf(length_squared());
+#else
+        return std::sqrtf(length_squared());
+#endif
+    }
+
+    float one_over_length() const
+    {
+        if(is_zero())
+        {
+            return 1.0f;
+        }
+
+        return ml::rsqrt(length_squared());
+    }
+
+    float dot_product(const vec4& v) const
+    {
+        // same summation order as the SSE backend.
+        const float4 r = data() * v.data();
+        return (r[0] + r[1]) + (r[2] + r[3]);
+    }
+
+    vec4 scale(float s) const
+    {
+        return vec4{data() * s};
+    }
+
+    void normalize()
+    {
+        /* one_over_length is safe to call on zero vectors - no check needed. */
+        *this = scale(one_over_length());
+    }
+    vec4 normalized() const
+    {
+        return scale(one_over_length());
+    }
+
+    /* operators. */
+    vec4 operator+(const vec4& v) const
+    {
+        return vec4{data() + v.data()};
+    }
+    vec4 operator+(float s) const
+    {
+        return vec4{data() + s};
+    }
+    vec4 operator-(const vec4& v) const
+    {
+        return vec4{data() - v.data()};
+    }
+    vec4 operator-(float s) const
+    {
+        return vec4{data() - s};
+    }
+    vec4 operator-() const
+    {
+        return vec4{-data()};
+    }
+    vec4 operator*(const vec4& v) const
+    {
+        return vec4{data() * v.data()};
+    }
+    vec4 operator*(float s) const
+    {
+        return scale(s);
+    }
+    vec4 operator/(float s) const
+    {
+        return scale(ml::rcp(s));
+    }
+    vec4 operator/(const vec4& v) const
+    {
+        return vec4{data() / v.data()};
+    }
+
+    vec4& operator+=(const vec4& v)
+    {
+        *this = *this + v;
+        return *this;
+    }
+    vec4& operator-=(const vec4& v)
+    {
+        *this = *this - v;
+        return *this;
+    }
+
+    vec4& operator*=(const vec4& v)
+    {
+        *this = *this * v;
+        return *this;
+    }
+
+    vec4& operator*=(float s)
+    {
+        *this = scale(s);
+        return *this;
+    }
+    vec4& operator/=(float s)
+    {
+        *this = scale(ml::rcp(s));
+        return *this;
+    }
+
+    /* exact comparisons */
+    bool operator==(const vec4& v) const
+    {
+        return stdx::all_of(data() == v.data());
+    }
+    bool operator!=(const vec4& v) const
+    {
+        return stdx::any_of(data() != v.data());
+    }
+
+    /* access. */
+    float& operator[](int c)
+    {
+        assert(c >= 0 && c < 4);
+        return (&x)[c];
+    }
+    float operator[](int c) const
+    {
+        assert(c >= 0 && c < 4);
+        return (&x)[c];
+    }
+
+#if defined(ML_DEFINE_SWIZZLE_FUNCTIONS)
+#    define ML_SWIZZLE_COMPONENTS 4
+#    define ML_SWIZZLE_VEC4_TYPE  vec4
+#    include "../swizzle.inl"
+#    undef ML_SWIZZLE_VEC4_TYPE
+#    undef ML_SWIZZLE_COMPONENTS
+#else /* defined(ML_DEFINE_SWIZZLE_FUNCTIONS) */
+    vec2 xy() const
+    {
+        return {x, y};
+    }
+
+    vec3 xyz() const
+    {
+        return {x, y, z};
+    }
+#endif
+
+    /* special vectors. */
+    static vec4 zero()
+    {
+        // note that by default w is initialized to 1, so we initialize the vector explicitely.
+        return vec4{float4{0.0f}};
+    }
+
+    static vec4 one()
+    {
+        return vec4{float4{1.0f}};
+    }
+};
+
+} /* namespace portable */
+
+} /* namespace ml */
@@ -0,0 +1,160 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * precision policies for reciprocals and reciprocal square roots.
+ *
+ * By default, the library uses IEEE divisions and square roots. Define ML_FAST_RCP to use
+ * the SSE estimates refined by one Newton-Raphson step instead, or ML_FAST_RCP_ESTIMATE to
+ * use the estimates without refinement. This affects divide_by_w, one_over_length and the
+ * division by a scalar of vec4, one_over_length of the packets vec4x4 and vec4x8, the batch
+ * kernel divide_by_w and plane::distance.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+namespace precision
+{
+
+/** IEEE division and square root. The results are correctly rounded. */
+struct exact
+{
+};
+
+/** hardware estimate, refined by one Newton-Raphson step. The relative error is below 2^-21. */
+struct refined
+{
+};
+
+/** hardware estimate. The relative error is at most 1.5*2^-12. */
+struct estimate
+{
+};
+
+/** the policy used by the library. */
+#if defined(ML_FAST_RCP_ESTIMATE)
+using default_policy = estimate;
+#elif defined(ML_FAST_RCP)
+using default_policy = refined;
+#else
+using default_policy = exact;
+#endif
+
+} /* namespace precision */
+
+#if defined(ML_SIMD_X86)
+
+namespace simd
+{
+
+/**
+ * 1/sqrt(x), estimated by _mm_rsqrt_ps and refined by one Newton-Raphson step.
+ *
+ * The estimate has a relative error of at most 1.5*2^-12, which the Newton step reduces
+ * to below 2^-21 (including rounding). x has to be a normal number: zero and denormals
+ * yield infinity or NaN.
+ */
+inline __m128 rsqrt_newton(const __m128 x)
+{
+    const __m128 y = _mm_rsqrt_ps(x);
+    const __m128 half_x_y = _mm_mul_ps(_mm_mul_ps(_mm_set_ps1(0.5f), x), y);
+
+    // y * (3 - x*y*y) / 2
+#if defined(ML_USE_FMA)
+    return _mm_mul_ps(y, _mm_fnmadd_ps(half_x_y, y, _mm_set_ps1(1.5f)));
+#else
+    return _mm_mul_ps(y, _mm_sub_ps(_mm_set_ps1(1.5f), _mm_mul_ps(half_x_y, y)));
+#endif
+}
+
+/**
+ * 1/x, estimated by _mm_rcp_ps and refined by one Newton-Raphson step. The relative error
+ * is below 2^-21. x has to be a normal number: zero yields NaN.
+ */
+inline __m128 rcp_newton(const __m128 x)
+{
+    const __m128 y = _mm_rcp_ps(x);
+
+    // y + y * (1 - x*y), or y * (2 - x*y). y*y would overflow for small x.
+#if defined(ML_USE_FMA)
+    return _mm_fmadd_ps(y, _mm_fnmadd_ps(x, y, _mm_set_ps1(1.0f)), y);
+#else
+    return _mm_mul_ps(y, _mm_sub_ps(_mm_set_ps1(2.0f), _mm_mul_ps(x, y)));
+#endif
+}
+
+/** 1/x for all lanes, using the precision policy P. */
+template<typename P = precision::default_policy>
+inline __m128 rcp(const __m128 x)
+{
+    if constexpr(std::is_same_v<P, precision::estimate>)
+    {
+        return _mm_rcp_ps(x);
+    }
+    else if constexpr(std::is_same_v<P, precision::refined>)
+    {
+        return rcp_newton(x);
+    }
+    else
+    {
+        return _mm_div_ps(_mm_set_ps1(1.0f), x);
+    }
+}
+
+/** 1/sqrt(x) for all lanes, using the precision policy P. */
+template<typename P = precision::default_policy>
+inline __m128 rsqrt(const __m128 x)
+{
+    if constexpr(std::is_same_v<P, precision::estimate>)
+    {
+        return _mm_rsqrt_ps(x);
+    }
+    else if constexpr(std::is_same_v<P, precision::refined>)
+    {
+        return rsqrt_newton(x);
+    }
+    else
+    {
+        return _mm_div_ps(_mm_set_ps1(1.0f), _mm_sqrt_ps(x));
+    }
+}
+
+} /* namespace simd */
+
+#endif /* defined(ML_SIMD_X86) */
+
+/** 1/x, using the precision policy P. Without SSE, the result is always exact. */
+template<typename P = precision::default_policy>
+inline float rcp(float x)
+{
+#if defined(ML_SIMD_X86)
+    if constexpr(!std::is_same_v<P, precision::exact>)
+    {
+        return _mm_cvtss_f32(simd::rcp<P>(_mm_set_ss(x)));
+    }
+#endif
+    return 1.0f / x;
+}
+
+/** 1/sqrt(x), using the precision policy P. Without SSE, the result is always exact. */
+template<typename P = precision::default_policy>
+inline float rsqrt(float x)
+{
+#if defined(ML_SIMD_X86)
+    if constexpr(!std::is_same_v<P, precision::exact>)
+    {
+        return _mm_cvtss_f32(simd::rsqrt<P>(_mm_set_ss(x)));
+    }
+#endif
+#ifdef __GNUC__
+    return 1.0f / sqrtf(x);
+#else
+    return 1.0f / std::sqrtf(x);
+#endif
+}
+
+} /* namespace ml */
@@ -0,0 +1,112 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * ray intersection tests. Rays are given as line3, with the points pos + t*dir for t >= 0.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+/** closest intersection of a ray found so far. */
+struct ray_hit
+{
+    /** marks a missing triangle index. */
+    static constexpr std::uint32_t no_triangle = std::numeric_limits<std::uint32_t>::max();
+
+    /** ray parameter of the hit. Only hits with a smaller ray parameter are accepted. */
+    float t{std::numeric_limits<float>::infinity()};
+
+    /** barycentric coordinates of the hit with respect to v1 and v2. */
+    float u{0}, v{0};
+
+    /** index of the triangle that was hit. */
+    std::uint32_t triangle{no_triangle};
+
+    ray_hit() = default;
+
+    /** accept only hits with ray parameter less than t_max. */
+    explicit ray_hit(float t_max)
+    : t{t_max}
+    {
+    }
+
+    bool valid() const
+    {
+        return triangle != no_triangle;
+    }
+};
+
+/**
+ * intersect a ray with the triangle (v0, v1, v2) (Möller-Trumbore). Both sides of the triangle
+ * are hit. If the ray hits the triangle with 0 <= t < hit.t, t and the barycentric coordinates
+ * are stored in hit and true is returned. The triangle index is left to the caller.
+ */
+inline bool intersect_triangle(const line3& ray, const vec3& v0, const vec3& v1, const vec3& v2, ray_hit& hit)
+{
+    const vec3 e1 = v1 - v0, e2 = v2 - v0;
+    const vec3 p = ray.dir.cross_product(e2);
+    const float det = e1.dot_product(p);
+    if(det == 0.f)
+    {
+        return false;
+    }
+    const float inv_det = 1.0f / det;
+
+    const vec3 s = ray.pos - v0;
+    const float u = s.dot_product(p) * inv_det;
+    if(u < 0.f || u > 1.f)
+    {
+        return false;
+    }
+
+    const vec3 q = s.cross_product(e1);
+    const float v = ray.dir.dot_product(q) * inv_det;
+    if(v < 0.f || u + v > 1.f)
+    {
+        return false;
+    }
+
+    const float t = e2.dot_product(q) * inv_det;
+    if(!(t >= 0.f && t < hit.t))
+    {
+        return false;
+    }
+
+    hit.t = t;
+    hit.u = u;
+    hit.v = v;
+    return true;
+}
+
+/**
+ * intersect a ray with an axis-aligned box (slab test), given the reciprocal of the ray direction.
+ * Returns the ray parameter where the ray enters the box, clamped to 0, or infinity if the box
+ * is missed or only hit at t >= t_max. For zero direction components, the slab test would
+ * compute 0 * inf = NaN on the slab planes, so the origin is tested against the slab instead.
+ */
+inline float intersect_aabb(const line3& ray, const vec3& inv_dir, const aabb3& b, float t_max)
+{
+    float t_enter = 0.f, t_exit = std::numeric_limits<float>::infinity();
+    for(int k = 0; k < 3; ++k)
+    {
+        if(ray.dir[k] == 0.f)
+        {
+            if(!(ray.pos[k] >= b.min[k] && ray.pos[k] <= b.max[k]))
+            {
+                return std::numeric_limits<float>::infinity();
+            }
+            continue;
+        }
+
+        const float t0 = (b.min[k] - ray.pos[k]) * inv_dir[k], t1 = (b.max[k] - ray.pos[k]) * inv_dir[k];
+        t_enter = std::max(t_enter, std::min(t0, t1));
+        t_exit = std::min(t_exit, std::max(t0, t1));
+    }
+    return t_enter <= t_exit && t_enter < t_max ? t_enter : std::numeric_limits<float>::infinity();
+}
+
+} /* namespace ml */
@@ -0,0 +1,650 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * batch kernels operating on arrays of vectors using SSE intrinsics.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+namespace simd
+{
+
+/**
+ * Matrix columns for the batch transformations. A matrix-vector product then is
+ * c0*x + c1*y + c2*z + c3*w, which needs no horizontal operations.
+ */
+struct mat4x4_columns
+{
+    __m128 c0, c1, c2, c3;
+
+    explicit mat4x4_columns(const mat4x4& m)
+    : c0{m.rows[0].data}
+    , c1{m.rows[1].data}
+    , c2{m.rows[2].data}
+    , c3{m.rows[3].data}
+    {
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    }
+
+    /*
+     * The summation order (and rounding, with FMA) is the same as for vec4::dot_product,
+     * so that the results match mat4x4::operator*(const vec4&) exactly.
+     */
+
+    __m128 transform(const __m128 v) const
+    {
+        const __m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m128 w = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+
+#if defined(ML_USE_FMA)
+        return _mm_add_ps(
+          _mm_fmadd_ps(c0, x, _mm_mul_ps(c1, y)),
+          _mm_fmadd_ps(c2, z, _mm_mul_ps(c3, w)));
+#else
+        return _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(c0, x), _mm_mul_ps(c1, y)),
+          _mm_add_ps(_mm_mul_ps(c2, z), _mm_mul_ps(c3, w)));
+#endif
+    }
+
+    /** transform a point, i.e. a vector with w=1. */
+    __m128 transform_point(const vec3& p) const
+    {
+#if defined(ML_USE_FMA)
+        return _mm_add_ps(
+          _mm_fmadd_ps(c0, _mm_set_ps1(p.x), _mm_mul_ps(c1, _mm_set_ps1(p.y))),
+          _mm_fmadd_ps(c2, _mm_set_ps1(p.z), c3));
+#else
+        return _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(c0, _mm_set_ps1(p.x)), _mm_mul_ps(c1, _mm_set_ps1(p.y))),
+          _mm_add_ps(_mm_mul_ps(c2, _mm_set_ps1(p.z)), c3));
+#endif
+    }
+
+    /** transform a direction, i.e. a vector with w=0. */
+    __m128 transform_direction(const vec3& d) const
+    {
+#if defined(ML_USE_FMA)
+        return _mm_add_ps(
+          _mm_fmadd_ps(c0, _mm_set_ps1(d.x), _mm_mul_ps(c1, _mm_set_ps1(d.y))),
+          _mm_mul_ps(c2, _mm_set_ps1(d.z)));
+#else
+        return _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(c0, _mm_set_ps1(d.x)), _mm_mul_ps(c1, _mm_set_ps1(d.y))),
+          _mm_mul_ps(c2, _mm_set_ps1(d.z)));
+#endif
+    }
+};
+
+/** transform homogeneous vectors, out[i] = m * in[i]. in and out may be the same array. */
+inline void transform(const mat4x4& m, std::span<const vec4> in, std::span<vec4> out)
+{
+    assert(out.size() >= in.size());
+
+    const mat4x4_columns cols{m};
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i].data = cols.transform(in[i].data);
+    }
+}
+
+/** transform points, out[i] = m * vec4{in[i], 1}. */
+inline void transform_points(const mat4x4& m, std::span<const vec3> in, std::span<vec4> out)
+{
+    assert(out.size() >= in.size());
+
+    const mat4x4_columns cols{m};
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i].data = cols.transform_point(in[i]);
+    }
+}
+
+/** transform directions, out[i] = (m * vec4{in[i], 0}).xyz(). in and out may be the same array. */
+inline void transform_directions(const mat4x4& m, std::span<const vec3> in, std::span<vec3> out)
+{
+    assert(out.size() >= in.size());
+
+    const mat4x4_columns cols{m};
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        const __m128 r = cols.transform_direction(in[i]);
+
+        _mm_storel_pi(reinterpret_cast<__m64*>(&out[i].x), r);
+        _mm_store_ss(&out[i].z, _mm_movehl_ps(r, r));
+    }
+}
+
+/**
+ * squared lengths of four packed 3d vectors, a = [x0 y0 z0 x1], b = [y1 z1 x2 y2], c = [z2 x3 y3 z3].
+ * The summation order is the same as for vec3::dot_product.
+ */
+inline __m128 length_squared_vec3x4(const __m128 a, const __m128 b, const __m128 c)
+{
+    // transpose into [x0 x1 x2 x3], [y0 y1 y2 y3] and [z0 z1 z2 z3].
+    __m128 x = _mm_blend_ps(_mm_blend_ps(a, b, 0x4), c, 0x2);
+    __m128 y = _mm_blend_ps(_mm_blend_ps(a, b, 0x9), c, 0x4);
+    __m128 z = _mm_blend_ps(_mm_blend_ps(a, b, 0x2), c, 0x9);
+    x = _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 2, 3, 0));
+    y = _mm_shuffle_ps(y, y, _MM_SHUFFLE(2, 3, 0, 1));
+    z = _mm_shuffle_ps(z, z, _MM_SHUFFLE(3, 0, 1, 2));
+
+#if defined(ML_USE_FMA)
+    return _mm_fmadd_ps(z, z, _mm_fmadd_ps(x, x, _mm_mul_ps(y, y)));
+#else
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+#endif
+}
+
+/*
+ * The normalization and length kernels estimate 1/length using rsqrt_newton. Compared to
+ * vec4::normalized and vec4::length, the results have a relative error below 2^-21 (about
+ * 4.8e-7, i.e. a few ulp). Squared lengths below FLT_MIN are treated as zero.
+ */
+
+/** squared lengths of four vectors. The summation order (and rounding, with FMA) is the same as for vec4::dot_product. */
+inline __m128 length_squared_vec4x4(__m128 a, __m128 b, __m128 c, __m128 d)
+{
+#if defined(ML_USE_FMA)
+    // transpose, so that x*x+y*y and z*z+w*w are rounded once each.
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+    return _mm_add_ps(
+      _mm_fmadd_ps(a, a, _mm_mul_ps(b, b)),
+      _mm_fmadd_ps(c, c, _mm_mul_ps(d, d)));
+#else
+    // the horizontal adds form (x+y)+(z+w), without transposing the vectors.
+    return _mm_hadd_ps(
+      _mm_hadd_ps(_mm_mul_ps(a, a), _mm_mul_ps(b, b)),
+      _mm_hadd_ps(_mm_mul_ps(c, c), _mm_mul_ps(d, d)));
+#endif
+}
+
+/** normalize vectors. Zero vectors are left unchanged. */
+inline void normalize(std::span<vec4> v)
+{
+    std::size_t i = 0;
+    for(; i + 4 <= v.size(); i += 4)
+    {
+        const __m128 s = one_over_length_estimate(length_squared_vec4x4(v[i].data, v[i + 1].data, v[i + 2].data, v[i + 3].data));
+
+        v[i].data = _mm_mul_ps(v[i].data, _mm_shuffle_ps(s, s, _MM_SHUFFLE(0, 0, 0, 0)));
+        v[i + 1].data = _mm_mul_ps(v[i + 1].data, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+        v[i + 2].data = _mm_mul_ps(v[i + 2].data, _mm_shuffle_ps(s, s, _MM_SHUFFLE(2, 2, 2, 2)));
+        v[i + 3].data = _mm_mul_ps(v[i + 3].data, _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+    for(; i < v.size(); ++i)
+    {
+        v[i].data = _mm_mul_ps(v[i].data, one_over_length_estimate(_mm_set_ps1(v[i].length_squared())));
+    }
+}
+
+/** normalize 3d vectors. Zero vectors are left unchanged. */
+inline void normalize(std::span<vec3> v)
+{
+    static_assert(sizeof(vec3) == 3 * sizeof(float), "normalize(std::span<vec3>) needs packed vectors");
+
+    std::size_t i = 0;
+    for(; i + 4 <= v.size(); i += 4)
+    {
+        float* p = &v[i].x;
+
+        const __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4), c = _mm_loadu_ps(p + 8);
+        const __m128 s = one_over_length_estimate(length_squared_vec3x4(a, b, c));
+
+        // spread the scale factors over [x0 y0 z0 x1], [y1 z1 x2 y2] and [z2 x3 y3 z3].
+        _mm_storeu_ps(p, _mm_mul_ps(a, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 0, 0, 0))));
+        _mm_storeu_ps(p + 4, _mm_mul_ps(b, _mm_shuffle_ps(s, s, _MM_SHUFFLE(2, 2, 1, 1))));
+        _mm_storeu_ps(p + 8, _mm_mul_ps(c, _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 2))));
+    }
+    for(; i < v.size(); ++i)
+    {
+        v[i] = v[i].scale(_mm_cvtss_f32(one_over_length_estimate(_mm_set_ss(v[i].length_squared()))));
+    }
+}
+
+/** vector lengths, out[i] = in[i].length(). */
+inline void lengths(std::span<const vec4> in, std::span<float> out)
+{
+    assert(out.size() >= in.size());
+
+    std::size_t i = 0;
+    for(; i + 4 <= in.size(); i += 4)
+    {
+        _mm_storeu_ps(&out[i], length_estimate(length_squared_vec4x4(in[i].data, in[i + 1].data, in[i + 2].data, in[i + 3].data)));
+    }
+    for(; i < in.size(); ++i)
+    {
+        out[i] = _mm_cvtss_f32(length_estimate(_mm_set_ss(in[i].length_squared())));
+    }
+}
+
+/** 3d vector lengths, out[i] = in[i].length(). */
+inline void lengths(std::span<const vec3> in, std::span<float> out)
+{
+    assert(out.size() >= in.size());
+
+    std::size_t i = 0;
+    for(; i + 4 <= in.size(); i += 4)
+    {
+        const float* p = &in[i].x;
+        _mm_storeu_ps(&out[i], length_estimate(length_squared_vec3x4(_mm_loadu_ps(p), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8))));
+    }
+    for(; i < in.size(); ++i)
+    {
+        out[i] = _mm_cvtss_f32(length_estimate(_mm_set_ss(in[i].length_squared())));
+    }
+}
+
+/** divide xyz by w and store 1/w in w. All w components have to be non-zero. */
+inline void divide_by_w(std::span<vec4> v)
+{
+    for(auto& it: v)
+    {
+        const __m128 one_over_w = rcp(_mm_shuffle_ps(it.data, it.data, _MM_SHUFFLE(3, 3, 3, 3)));
+        it.data = _mm_blend_ps(_mm_mul_ps(it.data, one_over_w), one_over_w, 0x8);
+    }
+}
+
+/**
+ * transform clip coordinates to screen coordinates: divide xyz by w, apply the viewport
+ * transformation xyz*scale + bias and store 1/w in w. All w components have to be non-zero.
+ */
+inline void clip_to_screen(std::span<vec4> v, const vec3& scale, const vec3& bias)
+{
+    const __m128 s = _mm_setr_ps(scale.x, scale.y, scale.z, 0);
+    const __m128 b = _mm_setr_ps(bias.x, bias.y, bias.z, 0);
+    for(auto& it: v)
+    {
+        const __m128 one_over_w = rcp(_mm_shuffle_ps(it.data, it.data, _MM_SHUFFLE(3, 3, 3, 3)));
+#if defined(ML_USE_FMA)
+        const __m128 screen = _mm_fmadd_ps(_mm_mul_ps(it.data, one_over_w), s, b);
+#else
+        const __m128 screen = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(it.data, one_over_w), s), b);
+#endif
+        it.data = _mm_blend_ps(screen, one_over_w, 0x8);
+    }
+}
+
+/** clamp all vector components to the interval [0,1]. */
+inline void clamp_to_unit_interval(std::span<vec4> v)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set_ps1(1.0f);
+    for(auto& it: v)
+    {
+        it.data = _mm_min_ps(_mm_max_ps(it.data, zero), one);
+    }
+}
+
+/** clamp a color to [0,1], scale it by 255 and round it to 32-bit integers. BGRA swaps red and blue. */
+template<bool bgra>
+inline __m128i quantize_color8(__m128 c)
+{
+    if constexpr(bgra)
+    {
+        c = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 1, 2));
+    }
+    c = _mm_min_ps(_mm_max_ps(c, _mm_setzero_ps()), _mm_set_ps1(1.0f));
+    return _mm_cvtps_epi32(_mm_mul_ps(c, _mm_set_ps1(255.0f)));
+}
+
+/** pack colors into RGBA8 or BGRA8. */
+template<bool bgra>
+inline void pack_color8(std::span<const vec4> in, std::span<std::uint32_t> out)
+{
+    assert(out.size() >= in.size());
+
+    std::size_t i = 0;
+    for(; i + 4 <= in.size(); i += 4)
+    {
+        // the saturating packs keep the byte order, i.e. the components of four colors.
+        const __m128i c01 = _mm_packs_epi32(quantize_color8<bgra>(in[i].data), quantize_color8<bgra>(in[i + 1].data));
+        const __m128i c23 = _mm_packs_epi32(quantize_color8<bgra>(in[i + 2].data), quantize_color8<bgra>(in[i + 3].data));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&out[i]), _mm_packus_epi16(c01, c23));
+    }
+    for(; i < in.size(); ++i)
+    {
+        const __m128i c = _mm_packs_epi32(quantize_color8<bgra>(in[i].data), _mm_setzero_si128());
+        out[i] = static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(c, c)));
+    }
+}
+
+/** convert the lowest four bytes to a color. BGRA swaps red and blue. */
+template<bool bgra>
+inline __m128 dequantize_color8(const __m128i c)
+{
+    const __m128 r = _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(c)), _mm_set_ps1(1.0f / 255.0f));
+    if constexpr(bgra)
+    {
+        return _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 0, 1, 2));
+    }
+    return r;
+}
+
+/** unpack RGBA8 or BGRA8 colors. */
+template<bool bgra>
+inline void unpack_color8(std::span<const std::uint32_t> in, std::span<vec4> out)
+{
+    assert(out.size() >= in.size());
+
+    std::size_t i = 0;
+    for(; i + 4 <= in.size(); i += 4)
+    {
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[i]));
+        out[i].data = dequantize_color8<bgra>(c);
+        out[i + 1].data = dequantize_color8<bgra>(_mm_srli_si128(c, 4));
+        out[i + 2].data = dequantize_color8<bgra>(_mm_srli_si128(c, 8));
+        out[i + 3].data = dequantize_color8<bgra>(_mm_srli_si128(c, 12));
+    }
+    for(; i < in.size(); ++i)
+    {
+        out[i].data = dequantize_color8<bgra>(_mm_cvtsi32_si128(static_cast<int>(in[i])));
+    }
+}
+
+/** pack colors into RGBA8, out[i] = pack_rgba8(in[i]). */
+inline void pack_rgba8(std::span<const vec4> in, std::span<std::uint32_t> out)
+{
+    simd::pack_color8<false>(in, out);
+}
+
+/** pack colors into BGRA8, out[i] = pack_bgra8(in[i]). */
+inline void pack_bgra8(std::span<const vec4> in, std::span<std::uint32_t> out)
+{
+    simd::pack_color8<true>(in, out);
+}
+
+/** unpack RGBA8 colors, out[i] = unpack_rgba8(in[i]). */
+inline void unpack_rgba8(std::span<const std::uint32_t> in, std::span<vec4> out)
+{
+    simd::unpack_color8<false>(in, out);
+}
+
+/** unpack BGRA8 colors, out[i] = unpack_bgra8(in[i]). */
+inline void unpack_bgra8(std::span<const std::uint32_t> in, std::span<vec4> out)
+{
+    simd::unpack_color8<true>(in, out);
+}
+
+/*
+ * closed_unit_interval arithmetic. The results are the same as for closed_unit_interval::operator*
+ * and lerp, i.e. correctly rounded. The packed operations use the rounding division of
+ * closed_unit_interval::round_div_one, (t + (t >> bits)) >> bits with t = x + half.
+ */
+
+/** multiply packed representations of closed_unit_interval<T>. */
+template<typename T>
+inline __m128i multiply_unit_interval(const __m128i a, const __m128i b)
+{
+    if constexpr(sizeof(T) == 1)
+    {
+        // the 16-bit products are at most 255*255, so all intermediate results fit.
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i half = _mm_set1_epi16(0x80);
+
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)), half);
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)), half);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        return _mm_packus_epi16(lo, hi);
+    }
+    else if constexpr(sizeof(T) == 2)
+    {
+        // with x = hi*2^16 + lo, the 16-bit halves of t = x + 0x8000 are hi' = hi + (lo >> 15)
+        // and lo' = lo ^ 0x8000. the result hi' + carry(lo' + hi') needs no 32-bit arithmetic.
+        const __m128i lo = _mm_mullo_epi16(a, b);
+        const __m128i t_hi = _mm_add_epi16(_mm_mulhi_epu16(a, b), _mm_srli_epi16(lo, 15));
+        const __m128i t_lo = _mm_xor_si128(lo, _mm_set1_epi16(static_cast<short>(0x8000)));
+
+        // the saturated and the wrapped sum differ exactly if the sum overflows.
+        const __m128i overflow = _mm_sub_epi16(_mm_adds_epu16(t_lo, t_hi), _mm_add_epi16(t_lo, t_hi));
+        return _mm_add_epi16(t_hi, _mm_min_epu16(overflow, _mm_set1_epi16(1)));
+    }
+    else
+    {
+        // 64-bit products of the even and the odd lanes.
+        const __m128i half = _mm_set1_epi64x(0x80000000);
+        __m128i even = _mm_add_epi64(_mm_mul_epu32(a, b), half);
+        __m128i odd = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)), half);
+
+        // the results of the odd lanes are in the upper halves before the last shift.
+        even = _mm_srli_epi64(_mm_add_epi64(even, _mm_srli_epi64(even, 32)), 32);
+        odd = _mm_add_epi64(odd, _mm_srli_epi64(odd, 32));
+        return _mm_blend_epi16(even, odd, 0xCC);
+    }
+}
+
+/** interpolate packed representations of closed_unit_interval<T>, a*(1-t) + b*t. */
+template<typename T>
+inline __m128i lerp_unit_interval(const __m128i t, const __m128i a, const __m128i b)
+{
+    // the representation of 1-t is ~t.
+    const __m128i nt = _mm_xor_si128(t, _mm_set1_epi32(-1));
+
+    if constexpr(sizeof(T) == 1)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i half = _mm_set1_epi16(0x80);
+
+        // the sums are at most 255*255.
+        __m128i lo = _mm_add_epi16(
+          _mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(nt, zero)),
+          _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), _mm_unpacklo_epi8(t, zero)));
+        __m128i hi = _mm_add_epi16(
+          _mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(nt, zero)),
+          _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), _mm_unpackhi_epi8(t, zero)));
+        lo = _mm_add_epi16(lo, half);
+        hi = _mm_add_epi16(hi, half);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        return _mm_packus_epi16(lo, hi);
+    }
+    else if constexpr(sizeof(T) == 2)
+    {
+        // assemble the 32-bit products from their halves. the sums are at most 65535*65535.
+        const __m128i a_lo = _mm_mullo_epi16(a, nt), a_hi = _mm_mulhi_epu16(a, nt);
+        const __m128i b_lo = _mm_mullo_epi16(b, t), b_hi = _mm_mulhi_epu16(b, t);
+        const __m128i half = _mm_set1_epi32(0x8000);
+
+        __m128i lo = _mm_add_epi32(_mm_add_epi32(_mm_unpacklo_epi16(a_lo, a_hi), _mm_unpacklo_epi16(b_lo, b_hi)), half);
+        __m128i hi = _mm_add_epi32(_mm_add_epi32(_mm_unpackhi_epi16(a_lo, a_hi), _mm_unpackhi_epi16(b_lo, b_hi)), half);
+        lo = _mm_srli_epi32(_mm_add_epi32(lo, _mm_srli_epi32(lo, 16)), 16);
+        hi = _mm_srli_epi32(_mm_add_epi32(hi, _mm_srli_epi32(hi, 16)), 16);
+        return _mm_packus_epi32(lo, hi);
+    }
+    else
+    {
+        const __m128i half = _mm_set1_epi64x(0x80000000);
+        __m128i even = _mm_add_epi64(_mm_add_epi64(_mm_mul_epu32(a, nt), _mm_mul_epu32(b, t)), half);
+        __m128i odd = _mm_add_epi64(
+          _mm_add_epi64(
+            _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(nt, 32)),
+            _mm_mul_epu32(_mm_srli_epi64(b, 32), _mm_srli_epi64(t, 32))),
+          half);
+
+        even = _mm_srli_epi64(_mm_add_epi64(even, _mm_srli_epi64(even, 32)), 32);
+        odd = _mm_add_epi64(odd, _mm_srli_epi64(odd, 32));
+        return _mm_blend_epi16(even, odd, 0xCC);
+    }
+}
+
+/** out[i] = a[i] * b[i] for closed_unit_interval<T>, 16 bytes at a time. */
+template<typename T>
+inline void multiply_unit_interval(std::span<const closed_unit_interval<T>> a, std::span<const closed_unit_interval<T>> b, std::span<closed_unit_interval<T>> out)
+{
+    assert(b.size() >= a.size() && out.size() >= a.size());
+    static_assert(sizeof(closed_unit_interval<T>) == sizeof(T), "closed_unit_interval needs to be packed");
+
+    constexpr std::size_t lanes = 16 / sizeof(T);
+
+    std::size_t i = 0;
+    for(; i + lanes <= a.size(); i += lanes)
+    {
+        const __m128i r = multiply_unit_interval<T>(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&a[i])),
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&b[i])));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&out[i]), r);
+    }
+    for(; i < a.size(); ++i)
+    {
+        out[i] = a[i] * b[i];
+    }
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]) for closed_unit_interval<T>, 16 bytes at a time. */
+template<typename T>
+inline void lerp_unit_interval(std::span<const closed_unit_interval<T>> t, std::span<const closed_unit_interval<T>> a, std::span<const closed_unit_interval<T>> b, std::span<closed_unit_interval<T>> out)
+{
+    assert(a.size() >= t.size() && b.size() >= t.size() && out.size() >= t.size());
+    static_assert(sizeof(closed_unit_interval<T>) == sizeof(T), "closed_unit_interval needs to be packed");
+
+    constexpr std::size_t lanes = 16 / sizeof(T);
+
+    std::size_t i = 0;
+    for(; i + lanes <= t.size(); i += lanes)
+    {
+        const __m128i r = lerp_unit_interval<T>(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&t[i])),
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&a[i])),
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&b[i])));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&out[i]), r);
+    }
+    for(; i < t.size(); ++i)
+    {
+        out[i] = ml::lerp(t[i], a[i], b[i]);
+    }
+}
+
+/** out[i] = a[i] * b[i]. */
+inline void multiply(std::span<const fixed_8_t> a, std::span<const fixed_8_t> b, std::span<fixed_8_t> out)
+{
+    simd::multiply_unit_interval(a, b, out);
+}
+
+/** out[i] = a[i] * b[i]. */
+inline void multiply(std::span<const fixed_16_t> a, std::span<const fixed_16_t> b, std::span<fixed_16_t> out)
+{
+    simd::multiply_unit_interval(a, b, out);
+}
+
+/** out[i] = a[i] * b[i]. */
+inline void multiply(std::span<const fixed_32_t> a, std::span<const fixed_32_t> b, std::span<fixed_32_t> out)
+{
+    simd::multiply_unit_interval(a, b, out);
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]). */
+inline void lerp(std::span<const fixed_8_t> t, std::span<const fixed_8_t> a, std::span<const fixed_8_t> b, std::span<fixed_8_t> out)
+{
+    simd::lerp_unit_interval(t, a, b, out);
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]). */
+inline void lerp(std::span<const fixed_16_t> t, std::span<const fixed_16_t> a, std::span<const fixed_16_t> b, std::span<fixed_16_t> out)
+{
+    simd::lerp_unit_interval(t, a, b, out);
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]). */
+inline void lerp(std::span<const fixed_32_t> t, std::span<const fixed_32_t> a, std::span<const fixed_32_t> b, std::span<fixed_32_t> out)
+{
+    simd::lerp_unit_interval(t, a, b, out);
+}
+
+/*
+ * conversion of floats to closed_unit_interval. The results are the same as for the clamping
+ * constructor, and NaN yields zero.
+ */
+
+/**
+ * convert 4 floats to the representations of closed_unit_interval<T> in 32-bit lanes. For
+ * 8 and 16 bits, the result is 2^bits for inputs >= 1 and needs to be saturated.
+ */
+template<typename T>
+inline __m128i quantize_unit_interval(const __m128 x)
+{
+    // maxps returns the second operand for NaN.
+    const __m128 c = _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set_ps1(1.0f));
+    const __m128 s = _mm_mul_ps(c, _mm_set_ps1(closed_unit_interval<T>::scale));
+
+    if constexpr(sizeof(T) < 4)
+    {
+        return _mm_cvttps_epi32(s);
+    }
+    else
+    {
+        // cvttps2dq is signed, so convert values >= 2^31 after subtracting 2^31 (which is
+        // exact) and restore the top bit. c = 1 needs to be set to one explicitly.
+        const __m128 top = _mm_set_ps1(2147483648.0f);
+        const __m128 upper = _mm_cmpge_ps(s, top);
+        const __m128i r = _mm_cvttps_epi32(_mm_sub_ps(s, _mm_and_ps(upper, top)));
+        const __m128i sign = _mm_slli_epi32(_mm_castps_si128(upper), 31);
+        return _mm_or_si128(_mm_xor_si128(r, sign), _mm_castps_si128(_mm_cmpge_ps(c, _mm_set_ps1(1.0f))));
+    }
+}
+
+/** out[i] = closed_unit_interval<T>{in[i]}, 16 bytes of output at a time. */
+template<typename T>
+inline void quantize_unit_interval(std::span<const float> in, std::span<closed_unit_interval<T>> out)
+{
+    assert(out.size() >= in.size());
+    static_assert(sizeof(closed_unit_interval<T>) == sizeof(T), "closed_unit_interval needs to be packed");
+
+    constexpr std::size_t lanes = 16 / sizeof(T);
+
+    std::size_t i = 0;
+    for(; i + lanes <= in.size(); i += lanes)
+    {
+        const __m128i a = quantize_unit_interval<T>(_mm_loadu_ps(&in[i]));
+        __m128i r;
+        if constexpr(sizeof(T) == 1)
+        {
+            const __m128i b = quantize_unit_interval<T>(_mm_loadu_ps(&in[i + 4]));
+            const __m128i c = quantize_unit_interval<T>(_mm_loadu_ps(&in[i + 8]));
+            const __m128i d = quantize_unit_interval<T>(_mm_loadu_ps(&in[i + 12]));
+            r = _mm_packus_epi16(_mm_packus_epi32(a, b), _mm_packus_epi32(c, d));
+        }
+        else if constexpr(sizeof(T) == 2)
+        {
+            r = _mm_packus_epi32(a, quantize_unit_interval<T>(_mm_loadu_ps(&in[i + 4])));
+        }
+        else
+        {
+            r = a;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&out[i]), r);
+    }
+    for(; i < in.size(); ++i)
+    {
+        out[i] = closed_unit_interval<T>{in[i]};
+    }
+}
+
+/** out[i] = fixed_8_t{in[i]}. */
+inline void quantize(std::span<const float> in, std::span<fixed_8_t> out)
+{
+    simd::quantize_unit_interval(in, out);
+}
+
+/** out[i] = fixed_16_t{in[i]}. */
+inline void quantize(std::span<const float> in, std::span<fixed_16_t> out)
+{
+    simd::quantize_unit_interval(in, out);
+}
+
+/** out[i] = fixed_32_t{in[i]}. */
+inline void quantize(std::span<const float> in, std::span<fixed_32_t> out)
+{
+    simd::quantize_unit_interval(in, out);
+}
+
+} /* namespace simd */
+
+} /* namespace ml */
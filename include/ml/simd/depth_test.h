@@ -0,0 +1,199 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * depth test of packets of four (SSE) or eight (AVX2) fixed_32_t samples, and depth range
+ * reductions.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+namespace simd
+{
+
+/** all bits set in lane i if bit i of the mask is set. */
+inline __m128i lane_mask_x4(unsigned int mask)
+{
+    const __m128i bits = _mm_setr_epi32(1, 2, 4, 8);
+    return _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(static_cast<int>(mask)), bits), bits);
+}
+
+/**
+ * depth test of the raw fixed_32_t values of four samples. All bits are set in the lanes
+ * where "z F d" holds. SSE only has signed comparisons, so the unsigned values are compared
+ * after flipping their top bit.
+ */
+template<depth_compare F>
+inline __m128i depth_test(const __m128i z, const __m128i d)
+{
+    const __m128i bias = _mm_set1_epi32(std::numeric_limits<std::int32_t>::min());
+    const __m128i all = _mm_set1_epi32(-1);
+
+    if constexpr(F == depth_compare::never)
+    {
+        return _mm_setzero_si128();
+    }
+    else if constexpr(F == depth_compare::less)
+    {
+        return _mm_cmpgt_epi32(_mm_xor_si128(d, bias), _mm_xor_si128(z, bias));
+    }
+    else if constexpr(F == depth_compare::less_equal)
+    {
+        return _mm_xor_si128(_mm_cmpgt_epi32(_mm_xor_si128(z, bias), _mm_xor_si128(d, bias)), all);
+    }
+    else if constexpr(F == depth_compare::equal)
+    {
+        return _mm_cmpeq_epi32(z, d);
+    }
+    else if constexpr(F == depth_compare::greater)
+    {
+        return _mm_cmpgt_epi32(_mm_xor_si128(z, bias), _mm_xor_si128(d, bias));
+    }
+    else if constexpr(F == depth_compare::greater_equal)
+    {
+        return _mm_xor_si128(_mm_cmpgt_epi32(_mm_xor_si128(d, bias), _mm_xor_si128(z, bias)), all);
+    }
+    else if constexpr(F == depth_compare::not_equal)
+    {
+        return _mm_xor_si128(_mm_cmpeq_epi32(z, d), all);
+    }
+    else
+    {
+        return all;
+    }
+}
+
+/**
+ * depth test of four samples under a coverage mask (bits 0 to 3). If write is set, the
+ * depths of the samples that pass are stored. Returns the mask of the passing samples.
+ */
+template<depth_compare F>
+inline unsigned int depth_test_and_update_x4(fixed_32_t* depth, const __m128i z, unsigned int mask, bool write)
+{
+    static_assert(sizeof(fixed_32_t) == sizeof(std::uint32_t), "closed_unit_interval needs to be packed");
+
+    const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(depth));
+    const __m128i pass = _mm_and_si128(depth_test<F>(z, d), lane_mask_x4(mask));
+    if(write)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(depth), _mm_blendv_epi8(d, z, pass));
+    }
+    return static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(pass)));
+}
+
+/** minimum and maximum of the lanes of a and b, interpreted as unsigned. */
+inline depth_range horizontal_depth_range(__m128i a, __m128i b)
+{
+    a = _mm_min_epu32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)));
+    b = _mm_max_epu32(b, _mm_shuffle_epi32(b, _MM_SHUFFLE(1, 0, 3, 2)));
+    a = _mm_min_epu32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)));
+    b = _mm_max_epu32(b, _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 3, 0, 1)));
+    return {wrap(static_cast<std::uint32_t>(_mm_cvtsi128_si32(a))), wrap(static_cast<std::uint32_t>(_mm_cvtsi128_si32(b)))};
+}
+
+/** depth range of 64 consecutive samples, e.g. a tile of depth_buffer. */
+inline depth_range depth_range_x64(const fixed_32_t* samples)
+{
+    static_assert(sizeof(fixed_32_t) == sizeof(std::uint32_t), "closed_unit_interval needs to be packed");
+
+#if defined(ML_SIMD_AVX2)
+    const __m256i* p = reinterpret_cast<const __m256i*>(samples);
+    __m256i lo = _mm256_loadu_si256(p), hi = lo;
+    for(int i = 1; i < 8; ++i)
+    {
+        const __m256i v = _mm256_loadu_si256(p + i);
+        lo = _mm256_min_epu32(lo, v);
+        hi = _mm256_max_epu32(hi, v);
+    }
+    return horizontal_depth_range(
+      _mm_min_epu32(_mm256_castsi256_si128(lo), _mm256_extracti128_si256(lo, 1)),
+      _mm_max_epu32(_mm256_castsi256_si128(hi), _mm256_extracti128_si256(hi, 1)));
+#else
+    const __m128i* p = reinterpret_cast<const __m128i*>(samples);
+    __m128i lo[2] = {_mm_loadu_si128(p), _mm_loadu_si128(p + 1)};
+    __m128i hi[2] = {lo[0], lo[1]};
+    for(int i = 2; i < 16; i += 2)
+    {
+        // two independent chains to hide the latency.
+        const __m128i v0 = _mm_loadu_si128(p + i), v1 = _mm_loadu_si128(p + i + 1);
+        lo[0] = _mm_min_epu32(lo[0], v0);
+        hi[0] = _mm_max_epu32(hi[0], v0);
+        lo[1] = _mm_min_epu32(lo[1], v1);
+        hi[1] = _mm_max_epu32(hi[1], v1);
+    }
+    return horizontal_depth_range(_mm_min_epu32(lo[0], lo[1]), _mm_max_epu32(hi[0], hi[1]));
+#endif
+}
+
+#if defined(ML_SIMD_AVX2)
+
+/** all bits set in lane i if bit i of the mask is set. */
+inline __m256i lane_mask_x8(unsigned int mask)
+{
+    const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(static_cast<int>(mask)), bits), bits);
+}
+
+/** depth test of the raw fixed_32_t values of eight samples. See depth_test(__m128i, __m128i). */
+template<depth_compare F>
+inline __m256i depth_test(const __m256i z, const __m256i d)
+{
+    const __m256i bias = _mm256_set1_epi32(std::numeric_limits<std::int32_t>::min());
+    const __m256i all = _mm256_set1_epi32(-1);
+
+    if constexpr(F == depth_compare::never)
+    {
+        return _mm256_setzero_si256();
+    }
+    else if constexpr(F == depth_compare::less)
+    {
+        return _mm256_cmpgt_epi32(_mm256_xor_si256(d, bias), _mm256_xor_si256(z, bias));
+    }
+    else if constexpr(F == depth_compare::less_equal)
+    {
+        return _mm256_xor_si256(_mm256_cmpgt_epi32(_mm256_xor_si256(z, bias), _mm256_xor_si256(d, bias)), all);
+    }
+    else if constexpr(F == depth_compare::equal)
+    {
+        return _mm256_cmpeq_epi32(z, d);
+    }
+    else if constexpr(F == depth_compare::greater)
+    {
+        return _mm256_cmpgt_epi32(_mm256_xor_si256(z, bias), _mm256_xor_si256(d, bias));
+    }
+    else if constexpr(F == depth_compare::greater_equal)
+    {
+        return _mm256_xor_si256(_mm256_cmpgt_epi32(_mm256_xor_si256(d, bias), _mm256_xor_si256(z, bias)), all);
+    }
+    else if constexpr(F == depth_compare::not_equal)
+    {
+        return _mm256_xor_si256(_mm256_cmpeq_epi32(z, d), all);
+    }
+    else
+    {
+        return all;
+    }
+}
+
+/** depth test of eight samples under a coverage mask (bits 0 to 7). See depth_test_and_update_x4. */
+template<depth_compare F>
+inline unsigned int depth_test_and_update_x8(fixed_32_t* depth, const __m256i z, unsigned int mask, bool write)
+{
+    const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(depth));
+    const __m256i pass = _mm256_and_si256(depth_test<F>(z, d), lane_mask_x8(mask));
+    if(write)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(depth), _mm256_blendv_epi8(d, z, pass));
+    }
+    return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(pass)));
+}
+
+#endif /* defined(ML_SIMD_AVX2) */
+
+} /* namespace simd */
+
+} /* namespace ml */
@@ -0,0 +1,239 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * edge functions of a triangle, evaluated for packets of four (SSE) or eight (AVX2) pixels,
+ * and coverage masks of 4x4 and 8x8 tiles.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+namespace simd
+{
+
+/**
+ * The three edge functions of a triangle, evaluated for four pixels at once.
+ *
+ * The edge function of the edge from a to b at p is (b-a).area(p-a), i.e.
+ * (b.x-a.x)*(p.y-a.y) - (b.y-a.y)*(p.x-a.x). It is computed on the raw int32_t
+ * representation of vec2_fixed<F>, so the results are the raw values of vec2_fixed::area,
+ * with 2F fractional bits. As for vec2_fixed, the products have to fit into 32 bits.
+ *
+ * The edges are v0->v1, v1->v2 and v2->v0. For triangles with positive area
+ * (v1-v0).area(v2-v0), all edge functions are non-negative exactly inside the triangle.
+ */
+struct edge_functions_x4
+{
+    /** edge vectors b-a and start points a, broadcast into all lanes. */
+    __m128i dx[3], dy[3], ax[3], ay[3];
+
+    /** set up the edges from the raw coordinates of the vertices. */
+    edge_functions_x4(const std::int32_t x[3], const std::int32_t y[3])
+    {
+        for(int i = 0; i < 3; ++i)
+        {
+            const int j = (i + 1) % 3;
+            dx[i] = _mm_set1_epi32(x[j] - x[i]);
+            dy[i] = _mm_set1_epi32(y[j] - y[i]);
+            ax[i] = _mm_set1_epi32(x[i]);
+            ay[i] = _mm_set1_epi32(y[i]);
+        }
+    }
+
+#ifndef ML_NO_CNL
+    template<int F>
+    edge_functions_x4(const vec2_fixed<F>& v0, const vec2_fixed<F>& v1, const vec2_fixed<F>& v2)
+    {
+        const std::int32_t x[3] = {cnl::unwrap(v0.x), cnl::unwrap(v1.x), cnl::unwrap(v2.x)};
+        const std::int32_t y[3] = {cnl::unwrap(v0.y), cnl::unwrap(v1.y), cnl::unwrap(v2.y)};
+        *this = edge_functions_x4{x, y};
+    }
+#endif /* ML_NO_CNL */
+
+    edge_functions_x4(const edge_functions_x4&) = default;
+    edge_functions_x4& operator=(const edge_functions_x4&) = default;
+
+    /** evaluate edge i at the pixels (px, py), given in the raw representation. */
+    __m128i evaluate(int i, const __m128i px, const __m128i py) const
+    {
+        return _mm_sub_epi32(
+          _mm_mullo_epi32(dx[i], _mm_sub_epi32(py, ay[i])),
+          _mm_mullo_epi32(dy[i], _mm_sub_epi32(px, ax[i])));
+    }
+
+    /** all bits set in the lanes where all edge functions are non-negative. */
+    __m128i inside(const __m128i px, const __m128i py) const
+    {
+        const __m128i e = _mm_or_si128(_mm_or_si128(evaluate(0, px, py), evaluate(1, px, py)), evaluate(2, px, py));
+
+        // the sign bit of the disjunction is set if any edge function is negative.
+        return _mm_cmpgt_epi32(e, _mm_set1_epi32(-1));
+    }
+
+    /** coverage mask. bit i is set if pixel i is inside the triangle. */
+    int coverage(const __m128i px, const __m128i py) const
+    {
+        return _mm_movemask_ps(_mm_castsi128_ps(inside(px, py)));
+    }
+};
+
+#if defined(ML_SIMD_AVX2)
+
+/** The three edge functions of a triangle, evaluated for eight pixels at once. See edge_functions_x4. */
+struct edge_functions_x8
+{
+    /** edge vectors b-a and start points a, broadcast into all lanes. */
+    __m256i dx[3], dy[3], ax[3], ay[3];
+
+    /** set up the edges from the raw coordinates of the vertices. */
+    edge_functions_x8(const std::int32_t x[3], const std::int32_t y[3])
+    {
+        for(int i = 0; i < 3; ++i)
+        {
+            const int j = (i + 1) % 3;
+            dx[i] = _mm256_set1_epi32(x[j] - x[i]);
+            dy[i] = _mm256_set1_epi32(y[j] - y[i]);
+            ax[i] = _mm256_set1_epi32(x[i]);
+            ay[i] = _mm256_set1_epi32(y[i]);
+        }
+    }
+
+#    ifndef ML_NO_CNL
+    template<int F>
+    edge_functions_x8(const vec2_fixed<F>& v0, const vec2_fixed<F>& v1, const vec2_fixed<F>& v2)
+    {
+        const std::int32_t x[3] = {cnl::unwrap(v0.x), cnl::unwrap(v1.x), cnl::unwrap(v2.x)};
+        const std::int32_t y[3] = {cnl::unwrap(v0.y), cnl::unwrap(v1.y), cnl::unwrap(v2.y)};
+        *this = edge_functions_x8{x, y};
+    }
+#    endif /* ML_NO_CNL */
+
+    edge_functions_x8(const edge_functions_x8&) = default;
+    edge_functions_x8& operator=(const edge_functions_x8&) = default;
+
+    /** evaluate edge i at the pixels (px, py), given in the raw representation. */
+    __m256i evaluate(int i, const __m256i px, const __m256i py) const
+    {
+        return _mm256_sub_epi32(
+          _mm256_mullo_epi32(dx[i], _mm256_sub_epi32(py, ay[i])),
+          _mm256_mullo_epi32(dy[i], _mm256_sub_epi32(px, ax[i])));
+    }
+
+    /** all bits set in the lanes where all edge functions are non-negative. */
+    __m256i inside(const __m256i px, const __m256i py) const
+    {
+        const __m256i e = _mm256_or_si256(_mm256_or_si256(evaluate(0, px, py), evaluate(1, px, py)), evaluate(2, px, py));
+        return _mm256_cmpgt_epi32(e, _mm256_set1_epi32(-1));
+    }
+
+    /** coverage mask. bit i is set if pixel i is inside the triangle. */
+    int coverage(const __m256i px, const __m256i py) const
+    {
+        return _mm256_movemask_ps(_mm256_castsi256_ps(inside(px, py)));
+    }
+};
+
+#endif /* defined(ML_SIMD_AVX2) */
+
+/*
+ * coverage masks of tiles. Bit row*size + column of the mask is set if the center of the
+ * pixel (x + column, y + row) is covered by the triangle. The edge values are stepped with
+ * the increments of triangle_setup, starting from the clamped value at the upper-left pixel,
+ * so that they fit into 32 bits.
+ */
+
+/** edge values at the pixels (x, y), ..., (x + 3, y). */
+inline __m128i edge_values_x4(const triangle_setup& setup, int i, int x, int y)
+{
+    return _mm_add_epi32(
+      _mm_set1_epi32(setup.evaluate_clamped(i, x, y)),
+      _mm_mullo_epi32(_mm_set1_epi32(setup.step_x[i]), _mm_setr_epi32(0, 1, 2, 3)));
+}
+
+/** coverage mask of the 4x4 tile at the pixel (x,y). */
+inline std::uint16_t coverage_mask_4x4(const triangle_setup& setup, int x, int y)
+{
+    __m128i e[3], step[3];
+    for(int i = 0; i < 3; ++i)
+    {
+        e[i] = edge_values_x4(setup, i, x, y);
+        step[i] = _mm_set1_epi32(setup.step_y[i]);
+    }
+
+    unsigned int outside = 0;
+    for(int row = 0; row < 4; ++row)
+    {
+        // the sign bit of the disjunction is set if any edge value is negative.
+        const __m128i m = _mm_or_si128(_mm_or_si128(e[0], e[1]), e[2]);
+        outside |= static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(m))) << (4 * row);
+
+        for(int i = 0; i < 3; ++i)
+        {
+            e[i] = _mm_add_epi32(e[i], step[i]);
+        }
+    }
+    return static_cast<std::uint16_t>(~outside);
+}
+
+/** coverage mask of the 8x8 tile at the pixel (x,y). */
+inline std::uint64_t coverage_mask_8x8(const triangle_setup& setup, int x, int y)
+{
+    std::uint64_t outside = 0;
+
+#if defined(ML_SIMD_AVX2)
+    __m256i e[3], step[3];
+    for(int i = 0; i < 3; ++i)
+    {
+        e[i] = _mm256_add_epi32(
+          _mm256_set1_epi32(setup.evaluate_clamped(i, x, y)),
+          _mm256_mullo_epi32(_mm256_set1_epi32(setup.step_x[i]), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+        step[i] = _mm256_set1_epi32(setup.step_y[i]);
+    }
+
+    for(int row = 0; row < 8; ++row)
+    {
+        const __m256i m = _mm256_or_si256(_mm256_or_si256(e[0], e[1]), e[2]);
+        outside |= static_cast<std::uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(m))) << (8 * row);
+
+        for(int i = 0; i < 3; ++i)
+        {
+            e[i] = _mm256_add_epi32(e[i], step[i]);
+        }
+    }
+#else
+    // left and right half of the rows.
+    __m128i lo[3], hi[3], step[3];
+    for(int i = 0; i < 3; ++i)
+    {
+        lo[i] = edge_values_x4(setup, i, x, y);
+        hi[i] = _mm_add_epi32(lo[i], _mm_set1_epi32(4 * setup.step_x[i]));
+        step[i] = _mm_set1_epi32(setup.step_y[i]);
+    }
+
+    for(int row = 0; row < 8; ++row)
+    {
+        const __m128i m_lo = _mm_or_si128(_mm_or_si128(lo[0], lo[1]), lo[2]);
+        const __m128i m_hi = _mm_or_si128(_mm_or_si128(hi[0], hi[1]), hi[2]);
+        const unsigned int bits =
+          static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(m_lo)))
+          | (static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(m_hi))) << 4);
+        outside |= static_cast<std::uint64_t>(bits) << (8 * row);
+
+        for(int i = 0; i < 3; ++i)
+        {
+            lo[i] = _mm_add_epi32(lo[i], step[i]);
+            hi[i] = _mm_add_epi32(hi[i], step[i]);
+        }
+    }
+#endif
+
+    return ~outside;
+}
+
+} /* namespace simd */
+
+} /* namespace ml */
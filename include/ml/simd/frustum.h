@@ -0,0 +1,118 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * frustum tests of packets of four (SSE) or eight (AVX) spheres or axis-aligned boxes.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+namespace simd
+{
+
+/**
+ * The planes of a frustum, broadcast into all lanes. The tests accumulate the minimum of the
+ * plane distances, so that a single comparison decides visibility.
+ */
+struct frustum_x4
+{
+    /** the planes, broadcast into all lanes. */
+    plane_x4 planes[6];
+
+    /** masks selecting the maximum of a box along the plane normals. */
+    __m128 positive_a[6], positive_b[6], positive_c[6];
+
+    explicit frustum_x4(const frustum& f)
+    {
+        for(int i = 0; i < 6; ++i)
+        {
+            planes[i] = plane_x4{f.planes[i]};
+            positive_a[i] = _mm_cmpge_ps(planes[i].a, _mm_setzero_ps());
+            positive_b[i] = _mm_cmpge_ps(planes[i].b, _mm_setzero_ps());
+            positive_c[i] = _mm_cmpge_ps(planes[i].c, _mm_setzero_ps());
+        }
+    }
+
+    /** visibility mask of four spheres. bit i is set if sphere i intersects the frustum. */
+    int spheres(const __m128 x, const __m128 y, const __m128 z, const __m128 r) const
+    {
+        __m128 m = planes[0].distance(x, y, z, r);
+        for(int i = 1; i < 6; ++i)
+        {
+            m = _mm_min_ps(m, planes[i].distance(x, y, z, r));
+        }
+        return _mm_movemask_ps(_mm_cmpge_ps(m, _mm_setzero_ps()));
+    }
+
+    /** visibility mask of four axis-aligned boxes. bit i is set if box i intersects the frustum. */
+    int aabbs(const __m128 min_x, const __m128 min_y, const __m128 min_z, const __m128 max_x, const __m128 max_y, const __m128 max_z) const
+    {
+        __m128 m = _mm_set_ps1(std::numeric_limits<float>::infinity());
+        for(int i = 0; i < 6; ++i)
+        {
+            const __m128 px = _mm_blendv_ps(min_x, max_x, positive_a[i]);
+            const __m128 py = _mm_blendv_ps(min_y, max_y, positive_b[i]);
+            const __m128 pz = _mm_blendv_ps(min_z, max_z, positive_c[i]);
+            m = _mm_min_ps(m, planes[i].distance(px, py, pz));
+        }
+        return _mm_movemask_ps(_mm_cmpge_ps(m, _mm_setzero_ps()));
+    }
+};
+
+#if defined(ML_USE_AVX)
+
+/** The planes of a frustum, broadcast into all lanes. See frustum_x4. */
+struct frustum_x8
+{
+    /** the planes, broadcast into all lanes. */
+    plane_x8 planes[6];
+
+    /** masks selecting the maximum of a box along the plane normals. */
+    __m256 positive_a[6], positive_b[6], positive_c[6];
+
+    explicit frustum_x8(const frustum& f)
+    {
+        for(int i = 0; i < 6; ++i)
+        {
+            planes[i] = plane_x8{f.planes[i]};
+            positive_a[i] = _mm256_cmp_ps(planes[i].a, _mm256_setzero_ps(), _CMP_GE_OQ);
+            positive_b[i] = _mm256_cmp_ps(planes[i].b, _mm256_setzero_ps(), _CMP_GE_OQ);
+            positive_c[i] = _mm256_cmp_ps(planes[i].c, _mm256_setzero_ps(), _CMP_GE_OQ);
+        }
+    }
+
+    /** visibility mask of eight spheres. bit i is set if sphere i intersects the frustum. */
+    int spheres(const __m256 x, const __m256 y, const __m256 z, const __m256 r) const
+    {
+        __m256 m = planes[0].distance(x, y, z, r);
+        for(int i = 1; i < 6; ++i)
+        {
+            m = _mm256_min_ps(m, planes[i].distance(x, y, z, r));
+        }
+        return _mm256_movemask_ps(_mm256_cmp_ps(m, _mm256_setzero_ps(), _CMP_GE_OQ));
+    }
+
+    /** visibility mask of eight axis-aligned boxes. bit i is set if box i intersects the frustum. */
+    int aabbs(const __m256 min_x, const __m256 min_y, const __m256 min_z, const __m256 max_x, const __m256 max_y, const __m256 max_z) const
+    {
+        __m256 m = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+        for(int i = 0; i < 6; ++i)
+        {
+            const __m256 px = _mm256_blendv_ps(min_x, max_x, positive_a[i]);
+            const __m256 py = _mm256_blendv_ps(min_y, max_y, positive_b[i]);
+            const __m256 pz = _mm256_blendv_ps(min_z, max_z, positive_c[i]);
+            m = _mm256_min_ps(m, planes[i].distance(px, py, pz));
+        }
+        return _mm256_movemask_ps(_mm256_cmp_ps(m, _mm256_setzero_ps(), _CMP_GE_OQ));
+    }
+};
+
+#endif /* defined(ML_USE_AVX) */
+
+} /* namespace simd */
+
+} /* namespace ml */
@@ -0,0 +1,88 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * perspective-correct interpolation of vertex attributes for packets of four (SSE) or
+ * eight (AVX) pixels.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+namespace simd
+{
+
+/** evaluate a plane equation at four offsets (dx, dy) from the first vertex. */
+inline __m128 evaluate(const screen_plane& p, const __m128 dx, const __m128 dy)
+{
+#if defined(ML_USE_FMA)
+    return _mm_fmadd_ps(_mm_set_ps1(p.dvdy), dy, _mm_fmadd_ps(_mm_set_ps1(p.dvdx), dx, _mm_set_ps1(p.v0)));
+#else
+    return _mm_add_ps(_mm_add_ps(_mm_set_ps1(p.v0), _mm_mul_ps(_mm_set_ps1(p.dvdx), dx)), _mm_mul_ps(_mm_set_ps1(p.dvdy), dy));
+#endif
+}
+
+/** depth at the screen positions (x[i], y[i]) of four pixels. */
+template<std::size_t N>
+inline __m128 interpolate_depth(const triangle_interpolator<N>& t, const __m128 x, const __m128 y)
+{
+    return evaluate(t.depth, _mm_sub_ps(x, _mm_set_ps1(t.x0)), _mm_sub_ps(y, _mm_set_ps1(t.y0)));
+}
+
+/**
+ * interpolate the attributes at the screen positions (x[i], y[i]) of four pixels. Lane i
+ * of out[k] holds the k-th attribute of the i-th pixel. The reciprocal of 1/w follows the
+ * precision policy.
+ */
+template<std::size_t N>
+inline void interpolate(const triangle_interpolator<N>& t, const __m128 x, const __m128 y, __m128 (&out)[N])
+{
+    const __m128 dx = _mm_sub_ps(x, _mm_set_ps1(t.x0));
+    const __m128 dy = _mm_sub_ps(y, _mm_set_ps1(t.y0));
+    const __m128 w = rcp(evaluate(t.one_over_w, dx, dy));
+    for(std::size_t i = 0; i < N; ++i)
+    {
+        out[i] = _mm_mul_ps(evaluate(t.attributes[i], dx, dy), w);
+    }
+}
+
+#if defined(ML_USE_AVX)
+
+/** evaluate a plane equation at eight offsets (dx, dy) from the first vertex. */
+inline __m256 evaluate(const screen_plane& p, const __m256 dx, const __m256 dy)
+{
+#    if defined(ML_USE_FMA)
+    return _mm256_fmadd_ps(_mm256_set1_ps(p.dvdy), dy, _mm256_fmadd_ps(_mm256_set1_ps(p.dvdx), dx, _mm256_set1_ps(p.v0)));
+#    else
+    return _mm256_add_ps(_mm256_add_ps(_mm256_set1_ps(p.v0), _mm256_mul_ps(_mm256_set1_ps(p.dvdx), dx)), _mm256_mul_ps(_mm256_set1_ps(p.dvdy), dy));
+#    endif
+}
+
+/** depth at the screen positions (x[i], y[i]) of eight pixels. */
+template<std::size_t N>
+inline __m256 interpolate_depth(const triangle_interpolator<N>& t, const __m256 x, const __m256 y)
+{
+    return evaluate(t.depth, _mm256_sub_ps(x, _mm256_set1_ps(t.x0)), _mm256_sub_ps(y, _mm256_set1_ps(t.y0)));
+}
+
+/** interpolate the attributes at the screen positions (x[i], y[i]) of eight pixels. */
+template<std::size_t N>
+inline void interpolate(const triangle_interpolator<N>& t, const __m256 x, const __m256 y, __m256 (&out)[N])
+{
+    const __m256 dx = _mm256_sub_ps(x, _mm256_set1_ps(t.x0));
+    const __m256 dy = _mm256_sub_ps(y, _mm256_set1_ps(t.y0));
+    const __m256 w = rcp(evaluate(t.one_over_w, dx, dy));
+    for(std::size_t i = 0; i < N; ++i)
+    {
+        out[i] = _mm256_mul_ps(evaluate(t.attributes[i], dx, dy), w);
+    }
+}
+
+#endif /* defined(ML_USE_AVX) */
+
+} /* namespace simd */
+
+} /* namespace ml */
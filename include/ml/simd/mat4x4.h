@@ -61,6 +61,23 @@ struct mat4x4
     }
     mat4x4 operator*(const mat4x4& m) const
     {
+#if defined(ML_USE_FMA)
+        mat4x4 res;
+        for(int i = 0; i < 4; ++i)
+        {
+            const __m128 v = rows[i].data;
+            const __m128 vX = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+            const __m128 vY = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+            const __m128 vZ = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+            const __m128 vW = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+
+            // same rounding as vec4::dot_product.
+            res.rows[i].data = _mm_add_ps(
+              _mm_fmadd_ps(vX, m.rows[0].data, _mm_mul_ps(vY, m.rows[1].data)),
+              _mm_fmadd_ps(vZ, m.rows[2].data, _mm_mul_ps(vW, m.rows[3].data)));
+        }
+        return res;
+#else
         // reference: https://github.com/microsoft/DirectXMath/blob/master/Inc/DirectXMathMatrix.inl
         mat4x4 res;
 
@@ -128,6 +145,7 @@ struct mat4x4
         res.rows[3].data = vX;
 
         return res;
+#endif
     }
 
     /* matrix-vector multiplication. */
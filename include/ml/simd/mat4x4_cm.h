@@ -0,0 +1,211 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * 4d matrix with column-major storage using SSE intrinsics.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+namespace simd
+{
+
+/**
+ * 4x4 matrix, stored as columns. The matrix-vector product is c0*x + c1*y + c2*z + c3*w,
+ * i.e. four broadcasts and multiply-adds without horizontal operations. Prefer this layout
+ * if many vectors are transformed by the same matrix.
+ *
+ * The results are the same as for the row-major mat4x4.
+ */
+struct mat4x4_cm
+{
+    vec4 columns[4];
+
+    mat4x4_cm()
+    {
+        *this = zero();
+    }
+    mat4x4_cm(const vec4& col0, const vec4& col1, const vec4& col2, const vec4& col3)
+    : columns{col0, col1, col2, col3}
+    {
+    }
+
+    /** convert from row-major storage. */
+    explicit mat4x4_cm(const mat4x4& m)
+    : columns{m.rows[0], m.rows[1], m.rows[2], m.rows[3]}
+    {
+        transpose();
+    }
+
+    mat4x4_cm(const mat4x4_cm&) = default;
+    mat4x4_cm(mat4x4_cm&&) = default;
+
+    mat4x4_cm& operator=(const mat4x4_cm&) = default;
+
+    /** convert to row-major storage. */
+    mat4x4 to_row_major() const
+    {
+        mat4x4 m{columns[0], columns[1], columns[2], columns[3]};
+        m.transpose();
+        return m;
+    }
+
+    /* matrix-matrix operations. */
+    mat4x4_cm operator+(const mat4x4_cm& m) const
+    {
+        return {
+          columns[0] + m.columns[0],
+          columns[1] + m.columns[1],
+          columns[2] + m.columns[2],
+          columns[3] + m.columns[3],
+        };
+    }
+    mat4x4_cm operator-(const mat4x4_cm& m) const
+    {
+        return {
+          columns[0] - m.columns[0],
+          columns[1] - m.columns[1],
+          columns[2] - m.columns[2],
+          columns[3] - m.columns[3],
+        };
+    }
+    mat4x4_cm operator-() const
+    {
+        return {-columns[0], -columns[1], -columns[2], -columns[3]};
+    }
+    mat4x4_cm operator*(const mat4x4_cm& m) const
+    {
+        // the j-th column of the product is this matrix applied to the j-th column of m.
+        const __m128 c0 = columns[0].data, c1 = columns[1].data, c2 = columns[2].data, c3 = columns[3].data;
+
+        mat4x4_cm res;
+        for(int j = 0; j < 4; ++j)
+        {
+            const __m128 v = m.columns[j].data;
+            const __m128 vX = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+            const __m128 vY = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+            const __m128 vZ = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+            const __m128 vW = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+
+            // same summation order as mat4x4::operator*(const mat4x4&).
+#if defined(ML_USE_FMA)
+            res.columns[j].data = _mm_add_ps(
+              _mm_fmadd_ps(c0, vX, _mm_mul_ps(c1, vY)),
+              _mm_fmadd_ps(c2, vZ, _mm_mul_ps(c3, vW)));
+#else
+            res.columns[j].data = _mm_add_ps(
+              _mm_add_ps(_mm_mul_ps(c0, vX), _mm_mul_ps(c2, vZ)),
+              _mm_add_ps(_mm_mul_ps(c1, vY), _mm_mul_ps(c3, vW)));
+#endif
+        }
+        return res;
+    }
+
+    /* matrix-vector multiplication. */
+    vec4 operator*(const vec4& v) const
+    {
+        const __m128 x = _mm_shuffle_ps(v.data, v.data, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m128 y = _mm_shuffle_ps(v.data, v.data, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m128 z = _mm_shuffle_ps(v.data, v.data, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m128 w = _mm_shuffle_ps(v.data, v.data, _MM_SHUFFLE(3, 3, 3, 3));
+
+        // same summation order as vec4::dot_product.
+#if defined(ML_USE_FMA)
+        return {_mm_add_ps(
+          _mm_fmadd_ps(columns[0].data, x, _mm_mul_ps(columns[1].data, y)),
+          _mm_fmadd_ps(columns[2].data, z, _mm_mul_ps(columns[3].data, w)))};
+#else
+        return {_mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(columns[0].data, x), _mm_mul_ps(columns[1].data, y)),
+          _mm_add_ps(_mm_mul_ps(columns[2].data, z), _mm_mul_ps(columns[3].data, w)))};
+#endif
+    }
+
+    /* scaling */
+    mat4x4_cm operator*(float s) const
+    {
+        return {columns[0] * s, columns[1] * s, columns[2] * s, columns[3] * s};
+    }
+
+    /* assignments */
+    mat4x4_cm& operator*=(const mat4x4_cm m)
+    {
+        *this = *this * m;
+        return *this;
+    }
+
+    mat4x4_cm operator*=(float s)
+    {
+        *this = *this * s;
+        return *this;
+    }
+    mat4x4_cm operator/=(float s)
+    {
+        *this = *this * (1.0f / s);
+        return *this;
+    }
+
+    /* exact comparisons */
+    bool operator==(const mat4x4_cm& m) const
+    {
+        return columns[0] == m.columns[0] && columns[1] == m.columns[1] && columns[2] == m.columns[2] && columns[3] == m.columns[3];
+    }
+    bool operator!=(const mat4x4_cm& m) const
+    {
+        return columns[0] != m.columns[0] || columns[1] != m.columns[1] || columns[2] != m.columns[2] || columns[3] != m.columns[3];
+    }
+
+    /* matrix transformations */
+    void transpose()
+    {
+        _MM_TRANSPOSE4_PS(columns[0].data, columns[1].data, columns[2].data, columns[3].data);
+    }
+
+    mat4x4_cm transposed() const
+    {
+        mat4x4_cm m{*this};
+        m.transpose();
+        return m;
+    }
+
+    /* access. note that this returns columns. */
+    vec4& operator[](int c)
+    {
+        assert(c >= 0 && c < 4);
+        return columns[c];
+    }
+    vec4 operator[](int c) const
+    {
+        assert(c >= 0 && c < 4);
+        return columns[c];
+    }
+
+    /* special matrices. */
+    static mat4x4_cm identity()
+    {
+        return {
+          {1.0f, 0.0f, 0.0f, 0.0f},
+          {0.0f, 1.0f, 0.0f, 0.0f},
+          {0.0f, 0.0f, 1.0f, 0.0f},
+          {0.0f, 0.0f, 0.0f, 1.0f},
+        };
+    }
+
+    static mat4x4_cm one()
+    {
+        return mat4x4_cm{vec4::one(), vec4::one(), vec4::one(), vec4::one()};
+    }
+
+    static mat4x4_cm zero()
+    {
+        return mat4x4_cm{vec4::zero(), vec4::zero(), vec4::zero(), vec4::zero()};
+    }
+};
+
+} /* namespace simd */
+
+} /* namespace ml */
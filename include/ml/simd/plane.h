@@ -0,0 +1,122 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * normalized planes broadcast into packets of four (SSE) or eight (AVX) lanes, for the
+ * classification of points and for frustum tests.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+namespace simd
+{
+
+/** A normalized plane, broadcast into all lanes. */
+struct plane_x4
+{
+    /** plane coefficients. */
+    __m128 a, b, c, d;
+
+    plane_x4() = default;
+
+    explicit plane_x4(const normalized_plane& p)
+    : a{_mm_set_ps1(p.normal.x)}
+    , b{_mm_set_ps1(p.normal.y)}
+    , c{_mm_set_ps1(p.normal.z)}
+    , d{_mm_set_ps1(p.d)}
+    {
+    }
+
+    /** signed distances of the points (x, y, z). */
+    __m128 distance(const __m128 x, const __m128 y, const __m128 z) const
+    {
+#if defined(ML_USE_FMA)
+        return _mm_fmadd_ps(a, x, _mm_fmadd_ps(b, y, _mm_fmadd_ps(c, z, d)));
+#else
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, x), _mm_mul_ps(b, y)), _mm_add_ps(_mm_mul_ps(c, z), d));
+#endif
+    }
+
+    /** signed distances of the points (x, y, z), plus an offset. */
+    __m128 distance(const __m128 x, const __m128 y, const __m128 z, const __m128 offset) const
+    {
+#if defined(ML_USE_FMA)
+        return _mm_fmadd_ps(a, x, _mm_fmadd_ps(b, y, _mm_fmadd_ps(c, z, _mm_add_ps(d, offset))));
+#else
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, x), _mm_mul_ps(b, y)), _mm_add_ps(_mm_mul_ps(c, z), _mm_add_ps(d, offset)));
+#endif
+    }
+};
+
+/** lanes of the distances dist that are greater than epsilon, i.e., in front of the plane. */
+inline __m128 front_of(const __m128 dist, const __m128 epsilon)
+{
+    return _mm_cmpgt_ps(dist, epsilon);
+}
+
+/** lanes of the distances dist that are less than -epsilon, i.e., behind the plane. */
+inline __m128 back_of(const __m128 dist, const __m128 epsilon)
+{
+    return _mm_cmplt_ps(dist, _mm_xor_ps(epsilon, _mm_set_ps1(-0.0f)));
+}
+
+#if defined(ML_USE_AVX)
+
+/** A normalized plane, broadcast into all lanes. See plane_x4. */
+struct plane_x8
+{
+    /** plane coefficients. */
+    __m256 a, b, c, d;
+
+    plane_x8() = default;
+
+    explicit plane_x8(const normalized_plane& p)
+    : a{_mm256_set1_ps(p.normal.x)}
+    , b{_mm256_set1_ps(p.normal.y)}
+    , c{_mm256_set1_ps(p.normal.z)}
+    , d{_mm256_set1_ps(p.d)}
+    {
+    }
+
+    /** signed distances of the points (x, y, z). */
+    __m256 distance(const __m256 x, const __m256 y, const __m256 z) const
+    {
+#    if defined(ML_USE_FMA)
+        return _mm256_fmadd_ps(a, x, _mm256_fmadd_ps(b, y, _mm256_fmadd_ps(c, z, d)));
+#    else
+        return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, x), _mm256_mul_ps(b, y)), _mm256_add_ps(_mm256_mul_ps(c, z), d));
+#    endif
+    }
+
+    /** signed distances of the points (x, y, z), plus an offset. */
+    __m256 distance(const __m256 x, const __m256 y, const __m256 z, const __m256 offset) const
+    {
+#    if defined(ML_USE_FMA)
+        return _mm256_fmadd_ps(a, x, _mm256_fmadd_ps(b, y, _mm256_fmadd_ps(c, z, _mm256_add_ps(d, offset))));
+#    else
+        return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, x), _mm256_mul_ps(b, y)), _mm256_add_ps(_mm256_mul_ps(c, z), _mm256_add_ps(d, offset)));
+#    endif
+    }
+};
+
+/** lanes of the distances dist that are greater than epsilon. See front_of(__m128, __m128). */
+inline __m256 front_of(const __m256 dist, const __m256 epsilon)
+{
+    return _mm256_cmp_ps(dist, epsilon, _CMP_GT_OQ);
+}
+
+/** lanes of the distances dist that are less than -epsilon. See back_of(__m128, __m128). */
+inline __m256 back_of(const __m256 dist, const __m256 epsilon)
+{
+    return _mm256_cmp_ps(dist, _mm256_xor_ps(epsilon, _mm256_set1_ps(-0.0f)), _CMP_LT_OQ);
+}
+
+#endif /* defined(ML_USE_AVX) */
+
+} /* namespace simd */
+
+} /* namespace ml */
@@ -0,0 +1,313 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * Möller-Trumbore ray-triangle intersection for one ray and packets of four (SSE) or eight
+ * (AVX) triangles, or packets of four or eight rays and one triangle.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+namespace simd
+{
+
+/**
+ * N triangles in structure-of-arrays layout, stored as the first vertex and the edges
+ * v1 - v0 and v2 - v0, so that the intersection needs no per-triangle setup. Unused lanes
+ * hold degenerate triangles, which are never hit.
+ */
+template<std::size_t N>
+struct alignas(N * sizeof(float)) triangle_block
+{
+    /** x, y and z components of v0, e1 = v1 - v0 and e2 = v2 - v0. */
+    float v0[3][N], e1[3][N], e2[3][N];
+
+    /** store the triangle (a, b, c) in a lane. */
+    void set(std::size_t lane, const vec3& a, const vec3& b, const vec3& c)
+    {
+        for(int k = 0; k < 3; ++k)
+        {
+            v0[k][lane] = a[k];
+            e1[k][lane] = b[k] - a[k];
+            e2[k][lane] = c[k] - a[k];
+        }
+    }
+};
+
+/**
+ * pack the triangles (vertices[3i], vertices[3i+1], vertices[3i+2]) into blocks of N. Triangle i
+ * is stored in lane i % N of block i / N.
+ */
+template<std::size_t N>
+std::vector<triangle_block<N>> pack_triangles(std::span<const vec3> vertices)
+{
+    assert(vertices.size() % 3 == 0);
+
+    const std::size_t n = vertices.size() / 3;
+    std::vector<triangle_block<N>> blocks((n + N - 1) / N, triangle_block<N>{});
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        blocks[i / N].set(i % N, vertices[3 * i], vertices[3 * i + 1], vertices[3 * i + 2]);
+    }
+    return blocks;
+}
+
+/** ray parameters and barycentric coordinates of a packet test. Lane i is a hit if bit i of mask is set. */
+struct packet_hits_x4
+{
+    __m128 t, u, v;
+    int mask;
+};
+
+/** update hit from the hit lanes with parameters t, u and v, if one of them is closer. */
+inline bool closest_hit(const float* t, const float* u, const float* v, int mask, ray_hit& hit, std::uint32_t first_triangle)
+{
+    bool found = false;
+    for(std::uint32_t lane = 0; mask != 0; ++lane, mask >>= 1)
+    {
+        if((mask & 1) != 0 && t[lane] < hit.t)
+        {
+            hit.t = t[lane];
+            hit.u = u[lane];
+            hit.v = v[lane];
+            hit.triangle = first_triangle + lane;
+            found = true;
+        }
+    }
+    return found;
+}
+
+/**
+ * update the closest hit from a one-ray packet test. first_triangle is the index of the
+ * triangle in lane 0.
+ */
+inline bool closest_hit(const packet_hits_x4& hits, ray_hit& hit, std::uint32_t first_triangle)
+{
+    alignas(16) float t[4], u[4], v[4];
+    _mm_store_ps(t, hits.t);
+    _mm_store_ps(u, hits.u);
+    _mm_store_ps(v, hits.v);
+    return closest_hit(t, u, v, hits.mask, hit, first_triangle);
+}
+
+/** a ray, broadcast into all lanes. */
+struct ray_x4
+{
+    __m128 pos[3], dir[3];
+
+    explicit ray_x4(const line3& ray)
+    {
+        for(int k = 0; k < 3; ++k)
+        {
+            pos[k] = _mm_set_ps1(ray.pos[k]);
+            dir[k] = _mm_set_ps1(ray.dir[k]);
+        }
+    }
+};
+
+/** four rays in structure-of-arrays layout. */
+struct rays_x4
+{
+    __m128 pos[3], dir[3];
+
+    rays_x4() = default;
+
+    explicit rays_x4(std::span<const line3, 4> rays)
+    {
+        for(int k = 0; k < 3; ++k)
+        {
+            pos[k] = _mm_setr_ps(rays[0].pos[k], rays[1].pos[k], rays[2].pos[k], rays[3].pos[k]);
+            dir[k] = _mm_setr_ps(rays[0].dir[k], rays[1].dir[k], rays[2].dir[k], rays[3].dir[k]);
+        }
+    }
+};
+
+/**
+ * Möller-Trumbore on four lanes, for rays (pos, dir) and triangles (v0, e1, e2). Hits have
+ * 0 <= t < t_max. The reciprocal of the determinant follows the precision policy.
+ */
+inline packet_hits_x4 intersect_triangles(
+  const __m128 (&pos)[3], const __m128 (&dir)[3],
+  const __m128 (&v0)[3], const __m128 (&e1)[3], const __m128 (&e2)[3],
+  const __m128 t_max)
+{
+    const auto cross = [](const __m128 (&a)[3], const __m128 (&b)[3], __m128 (&out)[3])
+    {
+        out[0] = _mm_sub_ps(_mm_mul_ps(a[1], b[2]), _mm_mul_ps(a[2], b[1]));
+        out[1] = _mm_sub_ps(_mm_mul_ps(a[2], b[0]), _mm_mul_ps(a[0], b[2]));
+        out[2] = _mm_sub_ps(_mm_mul_ps(a[0], b[1]), _mm_mul_ps(a[1], b[0]));
+    };
+    const auto dot = [](const __m128 (&a)[3], const __m128 (&b)[3]) -> __m128
+    {
+#if defined(ML_USE_FMA)
+        return _mm_fmadd_ps(a[2], b[2], _mm_fmadd_ps(a[1], b[1], _mm_mul_ps(a[0], b[0])));
+#else
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])), _mm_mul_ps(a[2], b[2]));
+#endif
+    };
+
+    __m128 p[3], q[3];
+    cross(dir, e2, p);
+    const __m128 det = dot(e1, p);
+    const __m128 inv_det = rcp(det);
+
+    const __m128 s[3] = {_mm_sub_ps(pos[0], v0[0]), _mm_sub_ps(pos[1], v0[1]), _mm_sub_ps(pos[2], v0[2])};
+    const __m128 u = _mm_mul_ps(dot(s, p), inv_det);
+    cross(s, e1, q);
+    const __m128 v = _mm_mul_ps(dot(dir, q), inv_det);
+    const __m128 t = _mm_mul_ps(dot(e2, q), inv_det);
+
+    const __m128 zero = _mm_setzero_ps();
+    __m128 hit = _mm_cmpneq_ps(det, zero);
+    hit = _mm_and_ps(hit, _mm_cmpge_ps(u, zero));
+    hit = _mm_and_ps(hit, _mm_cmpge_ps(v, zero));
+    hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), _mm_set_ps1(1.f)));
+    hit = _mm_and_ps(hit, _mm_cmpge_ps(t, zero));
+    hit = _mm_and_ps(hit, _mm_cmplt_ps(t, t_max));
+    return {t, u, v, _mm_movemask_ps(hit)};
+}
+
+/** intersect one ray with four triangles. */
+inline packet_hits_x4 intersect(const ray_x4& ray, const triangle_block<4>& b, float t_max = std::numeric_limits<float>::infinity())
+{
+    const __m128 v0[3] = {_mm_load_ps(b.v0[0]), _mm_load_ps(b.v0[1]), _mm_load_ps(b.v0[2])};
+    const __m128 e1[3] = {_mm_load_ps(b.e1[0]), _mm_load_ps(b.e1[1]), _mm_load_ps(b.e1[2])};
+    const __m128 e2[3] = {_mm_load_ps(b.e2[0]), _mm_load_ps(b.e2[1]), _mm_load_ps(b.e2[2])};
+    return intersect_triangles(ray.pos, ray.dir, v0, e1, e2, _mm_set_ps1(t_max));
+}
+
+/** intersect four rays with the triangle in a lane of a block. t_max holds the maximum ray parameter of each ray. */
+template<std::size_t N>
+packet_hits_x4 intersect(const rays_x4& rays, const triangle_block<N>& b, std::size_t lane, const __m128 t_max)
+{
+    const __m128 v0[3] = {_mm_set_ps1(b.v0[0][lane]), _mm_set_ps1(b.v0[1][lane]), _mm_set_ps1(b.v0[2][lane])};
+    const __m128 e1[3] = {_mm_set_ps1(b.e1[0][lane]), _mm_set_ps1(b.e1[1][lane]), _mm_set_ps1(b.e1[2][lane])};
+    const __m128 e2[3] = {_mm_set_ps1(b.e2[0][lane]), _mm_set_ps1(b.e2[1][lane]), _mm_set_ps1(b.e2[2][lane])};
+    return intersect_triangles(rays.pos, rays.dir, v0, e1, e2, t_max);
+}
+
+#if defined(ML_USE_AVX)
+
+/** ray parameters and barycentric coordinates of a packet test. Lane i is a hit if bit i of mask is set. */
+struct packet_hits_x8
+{
+    __m256 t, u, v;
+    int mask;
+};
+
+/** a ray, broadcast into all lanes. */
+struct ray_x8
+{
+    __m256 pos[3], dir[3];
+
+    explicit ray_x8(const line3& ray)
+    {
+        for(int k = 0; k < 3; ++k)
+        {
+            pos[k] = _mm256_set1_ps(ray.pos[k]);
+            dir[k] = _mm256_set1_ps(ray.dir[k]);
+        }
+    }
+};
+
+/** eight rays in structure-of-arrays layout. */
+struct rays_x8
+{
+    __m256 pos[3], dir[3];
+
+    rays_x8() = default;
+
+    explicit rays_x8(std::span<const line3, 8> rays)
+    {
+        for(int k = 0; k < 3; ++k)
+        {
+            pos[k] = _mm256_setr_ps(
+              rays[0].pos[k], rays[1].pos[k], rays[2].pos[k], rays[3].pos[k],
+              rays[4].pos[k], rays[5].pos[k], rays[6].pos[k], rays[7].pos[k]);
+            dir[k] = _mm256_setr_ps(
+              rays[0].dir[k], rays[1].dir[k], rays[2].dir[k], rays[3].dir[k],
+              rays[4].dir[k], rays[5].dir[k], rays[6].dir[k], rays[7].dir[k]);
+        }
+    }
+};
+
+/** Möller-Trumbore on eight lanes. See intersect_triangles(const __m128 (&)[3], ...). */
+inline packet_hits_x8 intersect_triangles(
+  const __m256 (&pos)[3], const __m256 (&dir)[3],
+  const __m256 (&v0)[3], const __m256 (&e1)[3], const __m256 (&e2)[3],
+  const __m256 t_max)
+{
+    const auto cross = [](const __m256 (&a)[3], const __m256 (&b)[3], __m256 (&out)[3])
+    {
+        out[0] = _mm256_sub_ps(_mm256_mul_ps(a[1], b[2]), _mm256_mul_ps(a[2], b[1]));
+        out[1] = _mm256_sub_ps(_mm256_mul_ps(a[2], b[0]), _mm256_mul_ps(a[0], b[2]));
+        out[2] = _mm256_sub_ps(_mm256_mul_ps(a[0], b[1]), _mm256_mul_ps(a[1], b[0]));
+    };
+    const auto dot = [](const __m256 (&a)[3], const __m256 (&b)[3]) -> __m256
+    {
+#    if defined(ML_USE_FMA)
+        return _mm256_fmadd_ps(a[2], b[2], _mm256_fmadd_ps(a[1], b[1], _mm256_mul_ps(a[0], b[0])));
+#    else
+        return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a[0], b[0]), _mm256_mul_ps(a[1], b[1])), _mm256_mul_ps(a[2], b[2]));
+#    endif
+    };
+
+    __m256 p[3], q[3];
+    cross(dir, e2, p);
+    const __m256 det = dot(e1, p);
+    const __m256 inv_det = rcp(det);
+
+    const __m256 s[3] = {_mm256_sub_ps(pos[0], v0[0]), _mm256_sub_ps(pos[1], v0[1]), _mm256_sub_ps(pos[2], v0[2])};
+    const __m256 u = _mm256_mul_ps(dot(s, p), inv_det);
+    cross(s, e1, q);
+    const __m256 v = _mm256_mul_ps(dot(dir, q), inv_det);
+    const __m256 t = _mm256_mul_ps(dot(e2, q), inv_det);
+
+    const __m256 zero = _mm256_setzero_ps();
+    __m256 hit = _mm256_cmp_ps(det, zero, _CMP_NEQ_OQ);
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_add_ps(u, v), _mm256_set1_ps(1.f), _CMP_LE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, zero, _CMP_GE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, t_max, _CMP_LT_OQ));
+    return {t, u, v, _mm256_movemask_ps(hit)};
+}
+
+/** intersect one ray with eight triangles. */
+inline packet_hits_x8 intersect(const ray_x8& ray, const triangle_block<8>& b, float t_max = std::numeric_limits<float>::infinity())
+{
+    const __m256 v0[3] = {_mm256_load_ps(b.v0[0]), _mm256_load_ps(b.v0[1]), _mm256_load_ps(b.v0[2])};
+    const __m256 e1[3] = {_mm256_load_ps(b.e1[0]), _mm256_load_ps(b.e1[1]), _mm256_load_ps(b.e1[2])};
+    const __m256 e2[3] = {_mm256_load_ps(b.e2[0]), _mm256_load_ps(b.e2[1]), _mm256_load_ps(b.e2[2])};
+    return intersect_triangles(ray.pos, ray.dir, v0, e1, e2, _mm256_set1_ps(t_max));
+}
+
+/** intersect eight rays with the triangle in a lane of a block. t_max holds the maximum ray parameter of each ray. */
+template<std::size_t N>
+packet_hits_x8 intersect(const rays_x8& rays, const triangle_block<N>& b, std::size_t lane, const __m256 t_max)
+{
+    const __m256 v0[3] = {_mm256_broadcast_ss(&b.v0[0][lane]), _mm256_broadcast_ss(&b.v0[1][lane]), _mm256_broadcast_ss(&b.v0[2][lane])};
+    const __m256 e1[3] = {_mm256_broadcast_ss(&b.e1[0][lane]), _mm256_broadcast_ss(&b.e1[1][lane]), _mm256_broadcast_ss(&b.e1[2][lane])};
+    const __m256 e2[3] = {_mm256_broadcast_ss(&b.e2[0][lane]), _mm256_broadcast_ss(&b.e2[1][lane]), _mm256_broadcast_ss(&b.e2[2][lane])};
+    return intersect_triangles(rays.pos, rays.dir, v0, e1, e2, t_max);
+}
+
+/** update the closest hit from a one-ray packet test. See closest_hit(const packet_hits_x4&, ...). */
+inline bool closest_hit(const packet_hits_x8& hits, ray_hit& hit, std::uint32_t first_triangle)
+{
+    alignas(32) float t[8], u[8], v[8];
+    _mm256_store_ps(t, hits.t);
+    _mm256_store_ps(u, hits.u);
+    _mm256_store_ps(v, hits.v);
+    return closest_hit(t, u, v, hits.mask, hit, first_triangle);
+}
+
+#endif /* defined(ML_USE_AVX) */
+
+} /* namespace simd */
+
+} /* namespace ml */
@@ -81,7 +81,7 @@ struct vec4
     {
         assert(w != 0.f);
 
-        const auto one_over_w = 1.0f / w;
+        const auto one_over_w = ml::rcp(w);
         data = _mm_mul_ps(data, _mm_set_ps1(one_over_w));
         w = one_over_w;
     }
@@ -112,14 +112,20 @@ struct vec4
             return 1.0f;
         }
 
-        return 1.0f / length();
+        return ml::rsqrt(length_squared());
     }
 
     float dot_product(const vec4& v) const
     {
         // see answer here: https://stackoverflow.com/questions/6996764/fastest-way-to-do-horizontal-sse-vector-sum-or-other-reduction
 
-#if defined(ML_USE_SSE41)
+#if defined(ML_USE_FMA)
+        // sums x+y and z+w with one rounding each, then add them like _mm_dp_ps.
+        const __m128 sums = _mm_fmadd_ps(
+          data, v.data,
+          _mm_mul_ps(_mm_shuffle_ps(data, data, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(v.data, v.data, _MM_SHUFFLE(2, 3, 0, 1))));
+        return _mm_cvtss_f32(_mm_add_ss(sums, _mm_movehl_ps(sums, sums)));
+#elif defined(ML_USE_SSE41)
         return _mm_cvtss_f32(_mm_dp_ps(data, v.data, 0xff));
 #elif defined(ML_USE_SSE3)
         // multiply entries
@@ -190,7 +196,7 @@ struct vec4
     }
     vec4 operator/(float s) const
     {
-        return scale(1.0f / s);
+        return scale(ml::rcp(s));
     }
     vec4 operator/(const vec4 other) const
     {
@@ -221,7 +227,7 @@ struct vec4
     }
     vec4& operator/=(float s)
     {
-        *this = scale(1.0f / s);
+        *this = scale(ml::rcp(s));
         return *this;
     }
 
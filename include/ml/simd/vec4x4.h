@@ -0,0 +1,312 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * packet of four 4d vectors in structure-of-arrays layout using SSE intrinsics.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+namespace simd
+{
+
+/** estimate one over length from squared lengths. Squared lengths below FLT_MIN (e.g. of zero vectors) yield one. */
+inline __m128 one_over_length_estimate(const __m128 len_sqr)
+{
+    const __m128 tiny = _mm_cmplt_ps(len_sqr, _mm_set_ps1(std::numeric_limits<float>::min()));
+    return _mm_blendv_ps(rsqrt_newton(len_sqr), _mm_set_ps1(1.0f), tiny);
+}
+
+/** estimate lengths from squared lengths. Squared lengths below FLT_MIN (e.g. of zero vectors) yield zero. */
+inline __m128 length_estimate(const __m128 len_sqr)
+{
+    const __m128 tiny = _mm_cmplt_ps(len_sqr, _mm_set_ps1(std::numeric_limits<float>::min()));
+    return _mm_andnot_ps(tiny, _mm_mul_ps(len_sqr, rsqrt_newton(len_sqr)));
+}
+
+/**
+ * Four 4-dimensional vectors stored as one register per component.
+ *
+ * Lane i of x, y, z and w holds the i-th vector. Since all operations act on
+ * whole registers, there are no horizontal operations (e.g. dot products
+ * produce four results at once).
+ */
+struct vec4x4
+{
+    __m128 x, y, z, w;
+
+    vec4x4()
+    : x{_mm_setzero_ps()}
+    , y{_mm_setzero_ps()}
+    , z{_mm_setzero_ps()}
+    , w{_mm_set_ps1(1.0f)}
+    {
+    }
+
+    vec4x4(const __m128 in_x, const __m128 in_y, const __m128 in_z, const __m128 in_w)
+    : x{in_x}
+    , y{in_y}
+    , z{in_z}
+    , w{in_w}
+    {
+    }
+
+    /** broadcast a vector into all lanes. */
+    explicit vec4x4(const vec4& v)
+    : x{_mm_set_ps1(v.x)}
+    , y{_mm_set_ps1(v.y)}
+    , z{_mm_set_ps1(v.z)}
+    , w{_mm_set_ps1(v.w)}
+    {
+    }
+
+    vec4x4(const vec4& v0, const vec4& v1, const vec4& v2, const vec4& v3)
+    : x{v0.data}
+    , y{v1.data}
+    , z{v2.data}
+    , w{v3.data}
+    {
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+    }
+
+    vec4x4(const vec4x4&) = default;
+    vec4x4(vec4x4&&) = default;
+
+    vec4x4& operator=(const vec4x4&) = default;
+
+    /*
+     * load and store.
+     */
+
+    /** load the first four vectors of v. */
+    static vec4x4 load(std::span<const vec4> v)
+    {
+        assert(v.size() >= 4);
+        return {v[0], v[1], v[2], v[3]};
+    }
+
+#if defined(ML_INCLUDE_SIMD)
+    /** load the first four vectors of v. */
+    static vec4x4 load(std::span<const ml::vec4> v)
+    {
+        assert(v.size() >= 4);
+
+        const float* p = &v[0].x;
+        vec4x4 r{_mm_loadu_ps(p), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8), _mm_loadu_ps(p + 12)};
+        _MM_TRANSPOSE4_PS(r.x, r.y, r.z, r.w);
+        return r;
+    }
+#endif /* defined(ML_INCLUDE_SIMD) */
+
+    /** store the vectors into the first four entries of v. */
+    void store(std::span<vec4> v) const
+    {
+        assert(v.size() >= 4);
+
+        __m128 r0 = x, r1 = y, r2 = z, r3 = w;
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        v[0].data = r0;
+        v[1].data = r1;
+        v[2].data = r2;
+        v[3].data = r3;
+    }
+
+#if defined(ML_INCLUDE_SIMD)
+    /** store the vectors into the first four entries of v. */
+    void store(std::span<ml::vec4> v) const
+    {
+        assert(v.size() >= 4);
+
+        __m128 r0 = x, r1 = y, r2 = z, r3 = w;
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+        float* p = &v[0].x;
+        _mm_storeu_ps(p, r0);
+        _mm_storeu_ps(p + 4, r1);
+        _mm_storeu_ps(p + 8, r2);
+        _mm_storeu_ps(p + 12, r3);
+    }
+#endif /* defined(ML_INCLUDE_SIMD) */
+
+    /*
+     * vector operations.
+     */
+
+    __m128 dot_product(const vec4x4& v) const
+    {
+        // same summation order (and rounding, with FMA) as vec4::dot_product.
+#if defined(ML_USE_FMA)
+        return _mm_add_ps(
+          _mm_fmadd_ps(x, v.x, _mm_mul_ps(y, v.y)),
+          _mm_fmadd_ps(z, v.z, _mm_mul_ps(w, v.w)));
+#else
+        return _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(x, v.x), _mm_mul_ps(y, v.y)),
+          _mm_add_ps(_mm_mul_ps(z, v.z), _mm_mul_ps(w, v.w)));
+#endif
+    }
+
+    __m128 length_squared() const
+    {
+        return dot_product(*this);
+    }
+
+    __m128 length() const
+    {
+        return _mm_sqrt_ps(length_squared());
+    }
+
+    /** one over length for all lanes. Zero vectors yield one, same as vec4::one_over_length. */
+    __m128 one_over_length() const
+    {
+        const __m128 len_sqr = length_squared();
+        const __m128 one = _mm_set_ps1(1.0f);
+
+        return _mm_blendv_ps(rsqrt(len_sqr), one, _mm_cmpeq_ps(len_sqr, _mm_setzero_ps()));
+    }
+
+    vec4x4 scale(const __m128 s) const
+    {
+        return {_mm_mul_ps(x, s), _mm_mul_ps(y, s), _mm_mul_ps(z, s), _mm_mul_ps(w, s)};
+    }
+
+    vec4x4 scale(float s) const
+    {
+        return scale(_mm_set_ps1(s));
+    }
+
+    void normalize()
+    {
+        /* one_over_length is safe to call on zero vectors - no check needed. */
+        *this = scale(one_over_length());
+    }
+    vec4x4 normalized() const
+    {
+        return scale(one_over_length());
+    }
+
+    /* operators. */
+    vec4x4 operator+(const vec4x4& v) const
+    {
+        return {_mm_add_ps(x, v.x), _mm_add_ps(y, v.y), _mm_add_ps(z, v.z), _mm_add_ps(w, v.w)};
+    }
+    vec4x4 operator+(float s) const
+    {
+        const __m128 t = _mm_set_ps1(s);
+        return {_mm_add_ps(x, t), _mm_add_ps(y, t), _mm_add_ps(z, t), _mm_add_ps(w, t)};
+    }
+    vec4x4 operator-(const vec4x4& v) const
+    {
+        return {_mm_sub_ps(x, v.x), _mm_sub_ps(y, v.y), _mm_sub_ps(z, v.z), _mm_sub_ps(w, v.w)};
+    }
+    vec4x4 operator-(float s) const
+    {
+        const __m128 t = _mm_set_ps1(s);
+        return {_mm_sub_ps(x, t), _mm_sub_ps(y, t), _mm_sub_ps(z, t), _mm_sub_ps(w, t)};
+    }
+    vec4x4 operator-() const
+    {
+        const __m128 zero = _mm_setzero_ps();
+        return {_mm_sub_ps(zero, x), _mm_sub_ps(zero, y), _mm_sub_ps(zero, z), _mm_sub_ps(zero, w)};
+    }
+    vec4x4 operator*(const vec4x4& v) const
+    {
+        return {_mm_mul_ps(x, v.x), _mm_mul_ps(y, v.y), _mm_mul_ps(z, v.z), _mm_mul_ps(w, v.w)};
+    }
+    vec4x4 operator*(float s) const
+    {
+        return scale(s);
+    }
+    vec4x4 operator/(float s) const
+    {
+        return scale(1.0f / s);
+    }
+    vec4x4 operator/(const vec4x4& v) const
+    {
+        return {_mm_div_ps(x, v.x), _mm_div_ps(y, v.y), _mm_div_ps(z, v.z), _mm_div_ps(w, v.w)};
+    }
+
+    vec4x4& operator+=(const vec4x4& v)
+    {
+        *this = *this + v;
+        return *this;
+    }
+    vec4x4& operator-=(const vec4x4& v)
+    {
+        *this = *this - v;
+        return *this;
+    }
+
+    vec4x4& operator*=(const vec4x4& v)
+    {
+        *this = *this * v;
+        return *this;
+    }
+
+    vec4x4& operator*=(float s)
+    {
+        *this = scale(s);
+        return *this;
+    }
+    vec4x4& operator/=(float s)
+    {
+        *this = scale(1.0f / s);
+        return *this;
+    }
+
+    /* exact comparisons */
+    bool operator==(const vec4x4& v) const
+    {
+        const __m128 eq = _mm_and_ps(
+          _mm_and_ps(_mm_cmpeq_ps(x, v.x), _mm_cmpeq_ps(y, v.y)),
+          _mm_and_ps(_mm_cmpeq_ps(z, v.z), _mm_cmpeq_ps(w, v.w)));
+        return _mm_movemask_ps(eq) == 0xF;
+    }
+    bool operator!=(const vec4x4& v) const
+    {
+        return !(*this == v);
+    }
+
+    /* access. */
+    vec4 operator[](int c) const
+    {
+        assert(c >= 0 && c < 4);
+
+        alignas(16) float v[4][4];
+        _mm_store_ps(v[0], x);
+        _mm_store_ps(v[1], y);
+        _mm_store_ps(v[2], z);
+        _mm_store_ps(v[3], w);
+        return {v[0][c], v[1][c], v[2][c], v[3][c]};
+    }
+};
+
+/** dot products of all lanes. */
+inline __m128 dot(const vec4x4& a, const vec4x4& b)
+{
+    return a.dot_product(b);
+}
+
+/** Linear vector interpolation. */
+inline vec4x4 lerp(float t, const vec4x4& v1, const vec4x4& v2)
+{
+#if defined(ML_USE_FMA)
+    // same as lerp(float, float, float).
+    const __m128 t4 = _mm_set_ps1(t);
+    return {
+      _mm_fmadd_ps(t4, v2.x, _mm_fnmadd_ps(t4, v1.x, v1.x)),
+      _mm_fmadd_ps(t4, v2.y, _mm_fnmadd_ps(t4, v1.y, v1.y)),
+      _mm_fmadd_ps(t4, v2.z, _mm_fnmadd_ps(t4, v1.z, v1.z)),
+      _mm_fmadd_ps(t4, v2.w, _mm_fnmadd_ps(t4, v1.w, v1.w))};
+#else
+    return v1 * (1 - t) + v2 * t;
+#endif
+}
+
+} /* namespace simd */
+
+} /* namespace ml */
@@ -0,0 +1,413 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * packet of eight 4d vectors in structure-of-arrays layout using AVX intrinsics.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+namespace simd
+{
+
+#if defined(ML_DISPATCH_TARGET_NAMESPACE)
+/* compiled for a runtime dispatch target, see dispatch/batch.h. */
+inline namespace ML_DISPATCH_TARGET_NAMESPACE
+{
+#endif
+
+/** 1/sqrt(x), estimated by _mm256_rsqrt_ps and refined by one Newton-Raphson step. See rsqrt_newton(__m128). */
+inline __m256 rsqrt_newton(const __m256 x)
+{
+    const __m256 y = _mm256_rsqrt_ps(x);
+    const __m256 half_x_y = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), x), y);
+
+#if defined(ML_USE_FMA)
+    return _mm256_mul_ps(y, _mm256_fnmadd_ps(half_x_y, y, _mm256_set1_ps(1.5f)));
+#else
+    return _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(half_x_y, y)));
+#endif
+}
+
+/** 1/x, estimated by _mm256_rcp_ps and refined by one Newton-Raphson step. See rcp_newton(__m128). */
+inline __m256 rcp_newton(const __m256 x)
+{
+    const __m256 y = _mm256_rcp_ps(x);
+
+#if defined(ML_USE_FMA)
+    return _mm256_fmadd_ps(y, _mm256_fnmadd_ps(x, y, _mm256_set1_ps(1.0f)), y);
+#else
+    return _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(2.0f), _mm256_mul_ps(x, y)));
+#endif
+}
+
+/** 1/x for all lanes, using the precision policy P. */
+template<typename P = precision::default_policy>
+inline __m256 rcp(const __m256 x)
+{
+    if constexpr(std::is_same_v<P, precision::estimate>)
+    {
+        return _mm256_rcp_ps(x);
+    }
+    else if constexpr(std::is_same_v<P, precision::refined>)
+    {
+        return rcp_newton(x);
+    }
+    else
+    {
+        return _mm256_div_ps(_mm256_set1_ps(1.0f), x);
+    }
+}
+
+/** 1/sqrt(x) for all lanes, using the precision policy P. */
+template<typename P = precision::default_policy>
+inline __m256 rsqrt(const __m256 x)
+{
+    if constexpr(std::is_same_v<P, precision::estimate>)
+    {
+        return _mm256_rsqrt_ps(x);
+    }
+    else if constexpr(std::is_same_v<P, precision::refined>)
+    {
+        return rsqrt_newton(x);
+    }
+    else
+    {
+        return _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(x));
+    }
+}
+
+/** estimate one over length from squared lengths. Squared lengths below FLT_MIN (e.g. of zero vectors) yield one. */
+inline __m256 one_over_length_estimate(const __m256 len_sqr)
+{
+    const __m256 tiny = _mm256_cmp_ps(len_sqr, _mm256_set1_ps(std::numeric_limits<float>::min()), _CMP_LT_OQ);
+    return _mm256_blendv_ps(rsqrt_newton(len_sqr), _mm256_set1_ps(1.0f), tiny);
+}
+
+/** estimate lengths from squared lengths. Squared lengths below FLT_MIN (e.g. of zero vectors) yield zero. */
+inline __m256 length_estimate(const __m256 len_sqr)
+{
+    const __m256 tiny = _mm256_cmp_ps(len_sqr, _mm256_set1_ps(std::numeric_limits<float>::min()), _CMP_LT_OQ);
+    return _mm256_andnot_ps(tiny, _mm256_mul_ps(len_sqr, rsqrt_newton(len_sqr)));
+}
+
+/**
+ * Eight 4-dimensional vectors stored as one register per component.
+ *
+ * Lane i of x, y, z and w holds the i-th vector. See vec4x4.
+ */
+struct vec4x8
+{
+    __m256 x, y, z, w;
+
+    vec4x8()
+    : x{_mm256_setzero_ps()}
+    , y{_mm256_setzero_ps()}
+    , z{_mm256_setzero_ps()}
+    , w{_mm256_set1_ps(1.0f)}
+    {
+    }
+
+    vec4x8(const __m256 in_x, const __m256 in_y, const __m256 in_z, const __m256 in_w)
+    : x{in_x}
+    , y{in_y}
+    , z{in_z}
+    , w{in_w}
+    {
+    }
+
+    /** broadcast a vector into all lanes. */
+    explicit vec4x8(const vec4& v)
+    : x{_mm256_set1_ps(v.x)}
+    , y{_mm256_set1_ps(v.y)}
+    , z{_mm256_set1_ps(v.z)}
+    , w{_mm256_set1_ps(v.w)}
+    {
+    }
+
+    /** combine two 4-packets. lo holds vectors 0-3, hi holds vectors 4-7. */
+    vec4x8(const vec4x4& lo, const vec4x4& hi)
+    : x{_mm256_insertf128_ps(_mm256_castps128_ps256(lo.x), hi.x, 1)}
+    , y{_mm256_insertf128_ps(_mm256_castps128_ps256(lo.y), hi.y, 1)}
+    , z{_mm256_insertf128_ps(_mm256_castps128_ps256(lo.z), hi.z, 1)}
+    , w{_mm256_insertf128_ps(_mm256_castps128_ps256(lo.w), hi.w, 1)}
+    {
+    }
+
+    vec4x8(const vec4x8&) = default;
+    vec4x8(vec4x8&&) = default;
+
+    vec4x8& operator=(const vec4x8&) = default;
+
+    /*
+     * load and store.
+     */
+
+    /** load the first eight vectors of v. */
+    static vec4x8 load(std::span<const vec4> v)
+    {
+        assert(v.size() >= 8);
+        return from_rows(&v[0].x);
+    }
+
+#if defined(ML_INCLUDE_SIMD)
+    /** load the first eight vectors of v. */
+    static vec4x8 load(std::span<const ml::vec4> v)
+    {
+        assert(v.size() >= 8);
+        return from_rows(&v[0].x);
+    }
+#endif /* defined(ML_INCLUDE_SIMD) */
+
+    /** store the vectors into the first eight entries of v. */
+    void store(std::span<vec4> v) const
+    {
+        assert(v.size() >= 8);
+        to_rows(&v[0].x);
+    }
+
+#if defined(ML_INCLUDE_SIMD)
+    /** store the vectors into the first eight entries of v. */
+    void store(std::span<ml::vec4> v) const
+    {
+        assert(v.size() >= 8);
+        to_rows(&v[0].x);
+    }
+#endif /* defined(ML_INCLUDE_SIMD) */
+
+    /** lower four vectors. */
+    vec4x4 lo() const
+    {
+        return {_mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z), _mm256_castps256_ps128(w)};
+    }
+
+    /** upper four vectors. */
+    vec4x4 hi() const
+    {
+        return {_mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1), _mm256_extractf128_ps(w, 1)};
+    }
+
+    /*
+     * vector operations.
+     */
+
+    __m256 dot_product(const vec4x8& v) const
+    {
+        // same summation order (and rounding, with FMA) as vec4::dot_product.
+#if defined(ML_USE_FMA)
+        return _mm256_add_ps(
+          _mm256_fmadd_ps(x, v.x, _mm256_mul_ps(y, v.y)),
+          _mm256_fmadd_ps(z, v.z, _mm256_mul_ps(w, v.w)));
+#else
+        return _mm256_add_ps(
+          _mm256_add_ps(_mm256_mul_ps(x, v.x), _mm256_mul_ps(y, v.y)),
+          _mm256_add_ps(_mm256_mul_ps(z, v.z), _mm256_mul_ps(w, v.w)));
+#endif
+    }
+
+    __m256 length_squared() const
+    {
+        return dot_product(*this);
+    }
+
+    __m256 length() const
+    {
+        return _mm256_sqrt_ps(length_squared());
+    }
+
+    /** one over length for all lanes. Zero vectors yield one, same as vec4::one_over_length. */
+    __m256 one_over_length() const
+    {
+        const __m256 len_sqr = length_squared();
+        const __m256 one = _mm256_set1_ps(1.0f);
+
+        return _mm256_blendv_ps(rsqrt(len_sqr), one, _mm256_cmp_ps(len_sqr, _mm256_setzero_ps(), _CMP_EQ_OQ));
+    }
+
+    vec4x8 scale(const __m256 s) const
+    {
+        return {_mm256_mul_ps(x, s), _mm256_mul_ps(y, s), _mm256_mul_ps(z, s), _mm256_mul_ps(w, s)};
+    }
+
+    vec4x8 scale(float s) const
+    {
+        return scale(_mm256_set1_ps(s));
+    }
+
+    void normalize()
+    {
+        /* one_over_length is safe to call on zero vectors - no check needed. */
+        *this = scale(one_over_length());
+    }
+    vec4x8 normalized() const
+    {
+        return scale(one_over_length());
+    }
+
+    /* operators. */
+    vec4x8 operator+(const vec4x8& v) const
+    {
+        return {_mm256_add_ps(x, v.x), _mm256_add_ps(y, v.y), _mm256_add_ps(z, v.z), _mm256_add_ps(w, v.w)};
+    }
+    vec4x8 operator+(float s) const
+    {
+        const __m256 t = _mm256_set1_ps(s);
+        return {_mm256_add_ps(x, t), _mm256_add_ps(y, t), _mm256_add_ps(z, t), _mm256_add_ps(w, t)};
+    }
+    vec4x8 operator-(const vec4x8& v) const
+    {
+        return {_mm256_sub_ps(x, v.x), _mm256_sub_ps(y, v.y), _mm256_sub_ps(z, v.z), _mm256_sub_ps(w, v.w)};
+    }
+    vec4x8 operator-(float s) const
+    {
+        const __m256 t = _mm256_set1_ps(s);
+        return {_mm256_sub_ps(x, t), _mm256_sub_ps(y, t), _mm256_sub_ps(z, t), _mm256_sub_ps(w, t)};
+    }
+    vec4x8 operator-() const
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        return {_mm256_sub_ps(zero, x), _mm256_sub_ps(zero, y), _mm256_sub_ps(zero, z), _mm256_sub_ps(zero, w)};
+    }
+    vec4x8 operator*(const vec4x8& v) const
+    {
+        return {_mm256_mul_ps(x, v.x), _mm256_mul_ps(y, v.y), _mm256_mul_ps(z, v.z), _mm256_mul_ps(w, v.w)};
+    }
+    vec4x8 operator*(float s) const
+    {
+        return scale(s);
+    }
+    vec4x8 operator/(float s) const
+    {
+        return scale(1.0f / s);
+    }
+    vec4x8 operator/(const vec4x8& v) const
+    {
+        return {_mm256_div_ps(x, v.x), _mm256_div_ps(y, v.y), _mm256_div_ps(z, v.z), _mm256_div_ps(w, v.w)};
+    }
+
+    vec4x8& operator+=(const vec4x8& v)
+    {
+        *this = *this + v;
+        return *this;
+    }
+    vec4x8& operator-=(const vec4x8& v)
+    {
+        *this = *this - v;
+        return *this;
+    }
+
+    vec4x8& operator*=(const vec4x8& v)
+    {
+        *this = *this * v;
+        return *this;
+    }
+
+    vec4x8& operator*=(float s)
+    {
+        *this = scale(s);
+        return *this;
+    }
+    vec4x8& operator/=(float s)
+    {
+        *this = scale(1.0f / s);
+        return *this;
+    }
+
+    /* exact comparisons */
+    bool operator==(const vec4x8& v) const
+    {
+        const __m256 eq = _mm256_and_ps(
+          _mm256_and_ps(_mm256_cmp_ps(x, v.x, _CMP_EQ_OQ), _mm256_cmp_ps(y, v.y, _CMP_EQ_OQ)),
+          _mm256_and_ps(_mm256_cmp_ps(z, v.z, _CMP_EQ_OQ), _mm256_cmp_ps(w, v.w, _CMP_EQ_OQ)));
+        return _mm256_movemask_ps(eq) == 0xFF;
+    }
+    bool operator!=(const vec4x8& v) const
+    {
+        return !(*this == v);
+    }
+
+    /* access. */
+    vec4 operator[](int c) const
+    {
+        assert(c >= 0 && c < 8);
+        return c < 4 ? lo()[c] : hi()[c - 4];
+    }
+
+private:
+    /** transpose the 4x4 blocks in both 128-bit halves. */
+    static void transpose(__m256& r0, __m256& r1, __m256& r2, __m256& r3)
+    {
+        const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+        const __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+        const __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+        const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+
+        r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+        r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+        r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    /** load eight consecutive vectors, i.e. 32 floats, from p. */
+    static vec4x8 from_rows(const float* p)
+    {
+        // pair vector i with vector i+4, so that the transposed halves line up.
+        vec4x8 r{
+          _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 16), 1),
+          _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 20), 1),
+          _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 24), 1),
+          _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 12)), _mm_loadu_ps(p + 28), 1)};
+        transpose(r.x, r.y, r.z, r.w);
+        return r;
+    }
+
+    /** store eight consecutive vectors, i.e. 32 floats, to p. */
+    void to_rows(float* p) const
+    {
+        __m256 r0 = x, r1 = y, r2 = z, r3 = w;
+        transpose(r0, r1, r2, r3);
+
+        _mm_storeu_ps(p, _mm256_castps256_ps128(r0));
+        _mm_storeu_ps(p + 4, _mm256_castps256_ps128(r1));
+        _mm_storeu_ps(p + 8, _mm256_castps256_ps128(r2));
+        _mm_storeu_ps(p + 12, _mm256_castps256_ps128(r3));
+        _mm_storeu_ps(p + 16, _mm256_extractf128_ps(r0, 1));
+        _mm_storeu_ps(p + 20, _mm256_extractf128_ps(r1, 1));
+        _mm_storeu_ps(p + 24, _mm256_extractf128_ps(r2, 1));
+        _mm_storeu_ps(p + 28, _mm256_extractf128_ps(r3, 1));
+    }
+};
+
+/** dot products of all lanes. */
+inline __m256 dot(const vec4x8& a, const vec4x8& b)
+{
+    return a.dot_product(b);
+}
+
+/** Linear vector interpolation. */
+inline vec4x8 lerp(float t, const vec4x8& v1, const vec4x8& v2)
+{
+#if defined(ML_USE_FMA)
+    // same as lerp(float, float, float).
+    const __m256 t8 = _mm256_set1_ps(t);
+    return {
+      _mm256_fmadd_ps(t8, v2.x, _mm256_fnmadd_ps(t8, v1.x, v1.x)),
+      _mm256_fmadd_ps(t8, v2.y, _mm256_fnmadd_ps(t8, v1.y, v1.y)),
+      _mm256_fmadd_ps(t8, v2.z, _mm256_fnmadd_ps(t8, v1.z, v1.z)),
+      _mm256_fmadd_ps(t8, v2.w, _mm256_fnmadd_ps(t8, v1.w, v1.w))};
+#else
+    return v1 * (1 - t) + v2 * t;
+#endif
+}
+
+#if defined(ML_DISPATCH_TARGET_NAMESPACE)
+} /* inline namespace ML_DISPATCH_TARGET_NAMESPACE */
+#endif
+
+} /* namespace simd */
+
+} /* namespace ml */
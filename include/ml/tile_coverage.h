@@ -0,0 +1,142 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * hierarchical coverage test of triangles for 4x4 and 8x8 tiles.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+/** coverage of a tile by a triangle. */
+enum class tile_coverage
+{
+    none,    /** no pixel is covered. */
+    partial, /** some pixels may be covered. */
+    full     /** all pixels are covered. */
+};
+
+/**
+ * classify the tile of size x size pixels at the pixel (x,y). The edge functions are linear,
+ * so their extreme values over the pixel centers of the tile are found at the corners.
+ * A tile that is outside of the triangle but not outside of a single edge is classified
+ * as partially covered.
+ */
+inline tile_coverage classify_tile(const triangle_setup& setup, int x, int y, int size)
+{
+    bool full = true;
+    for(int i = 0; i < 3; ++i)
+    {
+        const std::int64_t e = setup.evaluate(i, x, y);
+        const std::int64_t dx = std::int64_t{setup.step_x[i]} * (size - 1);
+        const std::int64_t dy = std::int64_t{setup.step_y[i]} * (size - 1);
+
+        if(e + std::max<std::int64_t>(dx, 0) + std::max<std::int64_t>(dy, 0) < 0)
+        {
+            return tile_coverage::none;
+        }
+        full = full && e + std::min<std::int64_t>(dx, 0) + std::min<std::int64_t>(dy, 0) >= 0;
+    }
+    return full ? tile_coverage::full : tile_coverage::partial;
+}
+
+/**
+ * coverage mask of the tile of size x size pixels at the pixel (x,y), for sizes up to 8. Bit
+ * row*size + column is set if the center of the pixel (x + column, y + row) is covered.
+ */
+inline std::uint64_t coverage_mask(const triangle_setup& setup, int x, int y, int size)
+{
+    assert(size > 0 && size <= 8);
+
+    std::int64_t row[3];
+    for(int i = 0; i < 3; ++i)
+    {
+        row[i] = setup.evaluate(i, x, y);
+    }
+
+    std::uint64_t mask = 0;
+    for(int r = 0; r < size; ++r)
+    {
+        std::int64_t e[3] = {row[0], row[1], row[2]};
+        for(int c = 0; c < size; ++c)
+        {
+            mask |= static_cast<std::uint64_t>((e[0] | e[1] | e[2]) >= 0) << (r * size + c);
+            for(int i = 0; i < 3; ++i)
+            {
+                e[i] += setup.step_x[i];
+            }
+        }
+        for(int i = 0; i < 3; ++i)
+        {
+            row[i] += setup.step_y[i];
+        }
+    }
+    return mask;
+}
+
+/** mask of the pixels of the 8x8 tile at (x,y) which are inside the bounding box of the triangle. */
+inline std::uint64_t bounding_box_mask_8x8(const triangle_setup& setup, int x, int y)
+{
+    const int c0 = std::max(setup.x_min - x, 0), c1 = std::min(setup.x_max - x, 8);
+    const int r0 = std::max(setup.y_min - y, 0), r1 = std::min(setup.y_max - y, 8);
+    if(c0 >= c1 || r0 >= r1)
+    {
+        return 0;
+    }
+
+    const std::uint64_t columns = ((std::uint64_t(1) << c1) - 1) & ~((std::uint64_t(1) << c0) - 1);
+    std::uint64_t mask = 0;
+    for(int r = r0; r < r1; ++r)
+    {
+        mask |= columns << (8 * r);
+    }
+    return mask;
+}
+
+/**
+ * call f(x, y, mask) for the 8x8 tiles overlapping the triangle. The tiles are aligned to
+ * multiples of 8 and (x,y) is their upper-left pixel. mask is the coverage mask in the
+ * layout of coverage_mask, restricted to the viewport. Tiles are first classified using
+ * their corners, so that only partially covered tiles need a per-pixel test, which is
+ * vectorized if available.
+ */
+template<typename F>
+void for_each_tile(const triangle_setup& setup, F&& f)
+{
+    if(setup.empty())
+    {
+        return;
+    }
+
+    for(int y = setup.y_min & ~7; y < setup.y_max; y += 8)
+    {
+        for(int x = setup.x_min & ~7; x < setup.x_max; x += 8)
+        {
+            const tile_coverage c = classify_tile(setup, x, y, 8);
+            if(c == tile_coverage::none)
+            {
+                continue;
+            }
+
+            std::uint64_t mask = bounding_box_mask_8x8(setup, x, y);
+            if(c == tile_coverage::partial)
+            {
+#if defined(ML_SIMD_X86)
+                mask &= simd::coverage_mask_8x8(setup, x, y);
+#else
+                mask &= coverage_mask(setup, x, y, 8);
+#endif
+            }
+
+            if(mask != 0)
+            {
+                f(x, y, mask);
+            }
+        }
+    }
+}
+
+} /* namespace ml */
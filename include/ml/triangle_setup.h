@@ -0,0 +1,283 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * triangle setup for rasterization with sub-pixel precision, and incremental edge stepping.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+/**
+ * linear edge equation. For the edge from a to b, the value at p is
+ *
+ *   a_x*(p.x - x0) + a_y*(p.y - y0) + bias = (b-a).area(p-a) + bias,
+ *
+ * with (a_x, a_y) = (a.y - b.y, b.x - a.x) and (x0, y0) = a. All coordinates are raw values
+ * of fixed_28_4_t. The coefficients fit into 32 bits, but the value is of the order of the
+ * squared coordinate differences, so it is evaluated in 64 bits.
+ */
+struct edge_equation
+{
+    /** coefficients, i.e. the gradient of the edge function. */
+    std::int32_t a_x{0}, a_y{0};
+
+    /** a point on the edge. */
+    std::int32_t x0{0}, y0{0};
+
+    /** fill rule bias. 0 for top-left edges and -1 otherwise. */
+    std::int32_t bias{0};
+
+    edge_equation() = default;
+
+    /** set up the edge from a to b. */
+    edge_equation(std::int32_t ax, std::int32_t ay, std::int32_t bx, std::int32_t by)
+    : a_x{ay - by}
+    , a_y{bx - ax}
+    , x0{ax}
+    , y0{ay}
+    {
+        // with y pointing down, the interior is to the right of left edges and below top edges.
+        const bool top_left = a_x > 0 || (a_x == 0 && a_y > 0);
+        bias = top_left ? 0 : -1;
+    }
+
+    /** value at the point (x,y), including the bias. The point is inside if the value is non-negative. */
+    std::int64_t evaluate(std::int32_t x, std::int32_t y) const
+    {
+        return std::int64_t{a_x} * (std::int64_t{x} - x0) + std::int64_t{a_y} * (std::int64_t{y} - y0) + bias;
+    }
+
+    /** whether the fill rule includes points on this edge. */
+    bool is_top_left() const
+    {
+        return bias == 0;
+    }
+};
+
+/**
+ * Triangle setup for rasterization.
+ *
+ * The vertices are given in the raw representation of fixed_28_4_t (i.e. vec2_fixed<4>), with
+ * the y axis pointing down. Pixel (x,y) is sampled at its center (x+0.5, y+0.5), and pixels
+ * on shared edges are assigned by the top-left fill rule. Triangles need to have a positive
+ * area (v1-v0).area(v2-v0), i.e. be oriented clockwise on the screen. Otherwise, they are
+ * considered empty and can be rasterized by swapping two vertices.
+ *
+ * The vertex coordinates have to be in (-max_coordinate, max_coordinate), i.e. within 65536
+ * pixels of the origin. Then the edge increments for a step of one pixel fit into 32 bits, and
+ * so do the increments across a tile of 8x8 pixels.
+ */
+struct triangle_setup
+{
+    /** fractional bits of the vertex coordinates. */
+    static constexpr int subpixel_bits = 4;
+
+    /** one pixel in the raw representation. */
+    static constexpr std::int32_t subpixel_one = 1 << subpixel_bits;
+
+    /** bound of the raw vertex coordinates. */
+    static constexpr std::int32_t max_coordinate = 1 << 20;
+
+    /**
+     * bound of the edge values returned by evaluate_clamped. The edge coefficients are less than
+     * 2*max_coordinate, so the steps for one pixel are less than 2^25, and an edge value changes
+     * by less than 14*2^25 < 2^29 across a tile of 8x8 pixels.
+     */
+    static constexpr std::int32_t max_tile_value = 1 << 29;
+
+    /** edges v0->v1, v1->v2 and v2->v0. */
+    edge_equation edges[3];
+
+    /** twice the area of the triangle, with 2*subpixel_bits fractional bits. */
+    std::int64_t area{0};
+
+    /** pixel bounding box, clipped to the viewport. The minimum is inclusive, the maximum exclusive. */
+    int x_min{0}, y_min{0}, x_max{0}, y_max{0};
+
+    /** edge value increments for a step of one pixel in x and y direction. */
+    std::int32_t step_x[3]{}, step_y[3]{};
+
+    /** set up a triangle from the raw vertex coordinates for a viewport of the given size. */
+    triangle_setup(const std::int32_t x[3], const std::int32_t y[3], int width, int height)
+    {
+        for(int i = 0; i < 3; ++i)
+        {
+            assert(-max_coordinate < x[i] && x[i] < max_coordinate);
+            assert(-max_coordinate < y[i] && y[i] < max_coordinate);
+
+            const int j = (i + 1) % 3;
+            edges[i] = edge_equation{x[i], y[i], x[j], y[j]};
+            step_x[i] = edges[i].a_x * subpixel_one;
+            step_y[i] = edges[i].a_y * subpixel_one;
+        }
+        area = std::int64_t{edges[0].a_y} * (y[2] - y[0]) + std::int64_t{edges[0].a_x} * (x[2] - x[0]);
+
+        // pixels whose centers may be covered, i.e. ceil(min - 1/2) <= pixel < ceil(max - 1/2).
+        constexpr std::int32_t half = subpixel_one / 2;
+        const auto first_pixel = [](std::int32_t c) -> int
+        { return (c - half + subpixel_one - 1) >> subpixel_bits; };
+
+        x_min = std::max(first_pixel(std::min({x[0], x[1], x[2]})), 0);
+        y_min = std::max(first_pixel(std::min({y[0], y[1], y[2]})), 0);
+        x_max = std::min(first_pixel(std::max({x[0], x[1], x[2]}) + 1), width);
+        y_max = std::min(first_pixel(std::max({y[0], y[1], y[2]}) + 1), height);
+    }
+
+#ifndef ML_NO_CNL
+    triangle_setup(const vec2_fixed<4>& v0, const vec2_fixed<4>& v1, const vec2_fixed<4>& v2, int width, int height)
+    {
+        const std::int32_t x[3] = {cnl::unwrap(v0.x), cnl::unwrap(v1.x), cnl::unwrap(v2.x)};
+        const std::int32_t y[3] = {cnl::unwrap(v0.y), cnl::unwrap(v1.y), cnl::unwrap(v2.y)};
+        *this = triangle_setup{x, y, width, height};
+    }
+#endif /* ML_NO_CNL */
+
+    /** whether the triangle covers no pixels. */
+    bool empty() const
+    {
+        return area <= 0 || x_min >= x_max || y_min >= y_max;
+    }
+
+    /** raw coordinate of the center of a pixel. */
+    static std::int32_t pixel_center(int i)
+    {
+        return i * subpixel_one + subpixel_one / 2;
+    }
+
+    /** value of edge i at the center of pixel (x,y). */
+    std::int64_t evaluate(int i, int x, int y) const
+    {
+        return edges[i].evaluate(pixel_center(x), pixel_center(y));
+    }
+
+    /**
+     * value of edge i at the center of pixel (x,y), clamped to [-max_tile_value, max_tile_value].
+     * Stepping the clamped value across a tile of up to 8x8 pixels starting at (x,y) does not
+     * overflow 32 bits, and gives the same signs as stepping the exact value.
+     */
+    std::int32_t evaluate_clamped(int i, int x, int y) const
+    {
+        return static_cast<std::int32_t>(std::clamp<std::int64_t>(evaluate(i, x, y), -max_tile_value, max_tile_value));
+    }
+
+    /** whether the center of pixel (x,y) is covered. */
+    bool covers(int x, int y) const
+    {
+        return (evaluate(0, x, y) | evaluate(1, x, y) | evaluate(2, x, y)) >= 0;
+    }
+};
+
+/**
+ * Walk the bounding box of a triangle in scanline order. The edge values are updated using
+ * the increments of triangle_setup, i.e. with additions only.
+ */
+class edge_walker
+{
+    /** the triangle. */
+    const triangle_setup& setup;
+
+    /** current pixel. */
+    int px, py;
+
+    /** edge values at the first pixel of the current row and at the current pixel. */
+    std::int64_t row[3], values[3];
+
+public:
+    explicit edge_walker(const triangle_setup& in_setup)
+    : setup{in_setup}
+    , px{in_setup.x_min}
+    , py{in_setup.y_min}
+    {
+        for(int i = 0; i < 3; ++i)
+        {
+            row[i] = values[i] = setup.evaluate(i, px, py);
+        }
+    }
+
+    int x() const
+    {
+        return px;
+    }
+    int y() const
+    {
+        return py;
+    }
+
+    /** edge value i at the current pixel. */
+    std::int64_t value(int i) const
+    {
+        return values[i];
+    }
+
+    /** whether the current pixel is covered. */
+    bool inside() const
+    {
+        return (values[0] | values[1] | values[2]) >= 0;
+    }
+
+    /** whether the walker is past the last row. */
+    bool done() const
+    {
+        return py >= setup.y_max || setup.x_min >= setup.x_max;
+    }
+
+    /** step to the next pixel in the current row. */
+    void step_x()
+    {
+        ++px;
+        for(int i = 0; i < 3; ++i)
+        {
+            values[i] += setup.step_x[i];
+        }
+    }
+
+    /** step to the first pixel of the next row. */
+    void step_y()
+    {
+        px = setup.x_min;
+        ++py;
+        for(int i = 0; i < 3; ++i)
+        {
+            row[i] += setup.step_y[i];
+            values[i] = row[i];
+        }
+    }
+
+    /** step to the next pixel in scanline order. Returns false if there is none. */
+    bool next()
+    {
+        if(px + 1 < setup.x_max)
+        {
+            step_x();
+        }
+        else
+        {
+            step_y();
+        }
+        return !done();
+    }
+};
+
+/** call f(x, y) for all pixels covered by the triangle, in scanline order. */
+template<typename F>
+void for_each_covered_pixel(const triangle_setup& setup, F&& f)
+{
+    if(setup.empty())
+    {
+        return;
+    }
+
+    for(edge_walker w{setup}; !w.done(); w.next())
+    {
+        if(w.inside())
+        {
+            f(w.x(), w.y());
+        }
+    }
+}
+
+} /* namespace ml */
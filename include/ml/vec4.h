@@ -12,10 +12,20 @@
 
 #    if defined(ML_SIMD_X86)
 #        include "simd/vec4.h"
+#        include "simd/vec4x4.h"
+#        if defined(ML_USE_AVX)
+#            include "simd/vec4x8.h"
+#        endif
 namespace ml
 {
 using vec4 = simd::vec4;
 }; /* namespace ml */
+#    elif defined(ML_SIMD_PORTABLE)
+#        include "portable/vec4.h"
+namespace ml
+{
+using vec4 = portable::vec4;
+}; /* namespace ml */
 #    else /* defined(ML_SIMD_X86) */
 #        include "x86/vec4.h"
 #    endif
@@ -25,9 +35,16 @@ using vec4 = simd::vec4;
 #    if defined(ML_SIMD_X86)
 #        include "x86/vec4.h"
 #        include "simd/vec4.h"
+#        include "simd/vec4x4.h"
+#        if defined(ML_USE_AVX)
+#            include "simd/vec4x8.h"
+#        endif
 #    else
 #        include "x86/vec4.h"
 #    endif /* defined(ML_INCLUDE_SIMD) */
+#    if defined(ML_SIMD_PORTABLE)
+#        include "portable/vec4.h"
+#    endif
 
 #else
 #    include "x86/vec4.h"
@@ -0,0 +1,247 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * batch kernels operating on arrays of vectors.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+namespace ml
+{
+
+/** transform homogeneous vectors, out[i] = m * in[i]. in and out may be the same array. */
+inline void transform(const mat4x4& m, std::span<const vec4> in, std::span<vec4> out)
+{
+    assert(out.size() >= in.size());
+
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = m * in[i];
+    }
+}
+
+/** transform points, out[i] = m * vec4{in[i], 1}. */
+inline void transform_points(const mat4x4& m, std::span<const vec3> in, std::span<vec4> out)
+{
+    assert(out.size() >= in.size());
+
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = m * vec4{in[i]};
+    }
+}
+
+/** transform directions, out[i] = (m * vec4{in[i], 0}).xyz(). in and out may be the same array. */
+inline void transform_directions(const mat4x4& m, std::span<const vec3> in, std::span<vec3> out)
+{
+    assert(out.size() >= in.size());
+
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = (m * vec4{in[i], 0}).xyz();
+    }
+}
+
+/** normalize vectors. Zero vectors are left unchanged. */
+inline void normalize(std::span<vec4> v)
+{
+    for(auto& it: v)
+    {
+        it.normalize();
+    }
+}
+
+/** normalize 3d vectors. Zero vectors are left unchanged. */
+inline void normalize(std::span<vec3> v)
+{
+    for(auto& it: v)
+    {
+        it.normalize();
+    }
+}
+
+/** vector lengths, out[i] = in[i].length(). */
+inline void lengths(std::span<const vec4> in, std::span<float> out)
+{
+    assert(out.size() >= in.size());
+
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = in[i].length();
+    }
+}
+
+/** 3d vector lengths, out[i] = in[i].length(). */
+inline void lengths(std::span<const vec3> in, std::span<float> out)
+{
+    assert(out.size() >= in.size());
+
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = in[i].length();
+    }
+}
+
+/** divide xyz by w and store 1/w in w. All w components have to be non-zero. */
+inline void divide_by_w(std::span<vec4> v)
+{
+    for(auto& it: v)
+    {
+        it.divide_by_w();
+    }
+}
+
+/**
+ * transform clip coordinates to screen coordinates: divide xyz by w, apply the viewport
+ * transformation xyz*scale + bias and store 1/w in w. All w components have to be non-zero.
+ */
+inline void clip_to_screen(std::span<vec4> v, const vec3& scale, const vec3& bias)
+{
+    for(auto& it: v)
+    {
+        it.divide_by_w();
+        it.x = it.x * scale.x + bias.x;
+        it.y = it.y * scale.y + bias.y;
+        it.z = it.z * scale.z + bias.z;
+    }
+}
+
+/** clamp all vector components to the interval [0,1]. */
+inline void clamp_to_unit_interval(std::span<vec4> v)
+{
+    for(auto& it: v)
+    {
+        it = clamp_to_unit_interval(it);
+    }
+}
+
+/** pack colors into RGBA8, out[i] = pack_rgba8(in[i]). */
+inline void pack_rgba8(std::span<const vec4> in, std::span<std::uint32_t> out)
+{
+    assert(out.size() >= in.size());
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = pack_rgba8(in[i]);
+    }
+}
+
+/** pack colors into BGRA8, out[i] = pack_bgra8(in[i]). */
+inline void pack_bgra8(std::span<const vec4> in, std::span<std::uint32_t> out)
+{
+    assert(out.size() >= in.size());
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = pack_bgra8(in[i]);
+    }
+}
+
+/** unpack RGBA8 colors, out[i] = unpack_rgba8(in[i]). */
+inline void unpack_rgba8(std::span<const std::uint32_t> in, std::span<vec4> out)
+{
+    assert(out.size() >= in.size());
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = unpack_rgba8(in[i]);
+    }
+}
+
+/** unpack BGRA8 colors, out[i] = unpack_bgra8(in[i]). */
+inline void unpack_bgra8(std::span<const std::uint32_t> in, std::span<vec4> out)
+{
+    assert(out.size() >= in.size());
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = unpack_bgra8(in[i]);
+    }
+}
+
+/** out[i] = a[i] * b[i] for closed_unit_interval<T>. */
+template<typename T>
+inline void multiply_unit_interval(std::span<const closed_unit_interval<T>> a, std::span<const closed_unit_interval<T>> b, std::span<closed_unit_interval<T>> out)
+{
+    assert(b.size() >= a.size() && out.size() >= a.size());
+    for(std::size_t i = 0; i < a.size(); ++i)
+    {
+        out[i] = a[i] * b[i];
+    }
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]) for closed_unit_interval<T>. */
+template<typename T>
+inline void lerp_unit_interval(std::span<const closed_unit_interval<T>> t, std::span<const closed_unit_interval<T>> a, std::span<const closed_unit_interval<T>> b, std::span<closed_unit_interval<T>> out)
+{
+    assert(a.size() >= t.size() && b.size() >= t.size() && out.size() >= t.size());
+    for(std::size_t i = 0; i < t.size(); ++i)
+    {
+        out[i] = ml::lerp(t[i], a[i], b[i]);
+    }
+}
+
+/** out[i] = a[i] * b[i]. */
+inline void multiply(std::span<const fixed_8_t> a, std::span<const fixed_8_t> b, std::span<fixed_8_t> out)
+{
+    multiply_unit_interval(a, b, out);
+}
+
+/** out[i] = a[i] * b[i]. */
+inline void multiply(std::span<const fixed_16_t> a, std::span<const fixed_16_t> b, std::span<fixed_16_t> out)
+{
+    multiply_unit_interval(a, b, out);
+}
+
+/** out[i] = a[i] * b[i]. */
+inline void multiply(std::span<const fixed_32_t> a, std::span<const fixed_32_t> b, std::span<fixed_32_t> out)
+{
+    multiply_unit_interval(a, b, out);
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]). */
+inline void lerp(std::span<const fixed_8_t> t, std::span<const fixed_8_t> a, std::span<const fixed_8_t> b, std::span<fixed_8_t> out)
+{
+    lerp_unit_interval(t, a, b, out);
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]). */
+inline void lerp(std::span<const fixed_16_t> t, std::span<const fixed_16_t> a, std::span<const fixed_16_t> b, std::span<fixed_16_t> out)
+{
+    lerp_unit_interval(t, a, b, out);
+}
+
+/** out[i] = lerp(t[i], a[i], b[i]). */
+inline void lerp(std::span<const fixed_32_t> t, std::span<const fixed_32_t> a, std::span<const fixed_32_t> b, std::span<fixed_32_t> out)
+{
+    lerp_unit_interval(t, a, b, out);
+}
+
+/** out[i] = closed_unit_interval<T>{in[i]}. */
+template<typename T>
+inline void quantize_unit_interval(std::span<const float> in, std::span<closed_unit_interval<T>> out)
+{
+    assert(out.size() >= in.size());
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = closed_unit_interval<T>{in[i]};
+    }
+}
+
+/** out[i] = fixed_8_t{in[i]}. */
+inline void quantize(std::span<const float> in, std::span<fixed_8_t> out)
+{
+    quantize_unit_interval(in, out);
+}
+
+/** out[i] = fixed_16_t{in[i]}. */
+inline void quantize(std::span<const float> in, std::span<fixed_16_t> out)
+{
+    quantize_unit_interval(in, out);
+}
+
+/** out[i] = fixed_32_t{in[i]}. */
+inline void quantize(std::span<const float> in, std::span<fixed_32_t> out)
+{
+    quantize_unit_interval(in, out);
+}
+
+} /* namespace ml */
@@ -87,7 +87,7 @@ struct vec4
     {
         assert(w != 0.f);
 
-        const auto one_over_w = 1.0f / w;
+        const auto one_over_w = ml::rcp(w);
         x *= one_over_w;
         y *= one_over_w;
         z *= one_over_w;
@@ -120,7 +120,7 @@ struct vec4
             return 1.0f;
         }
 
-        return 1.0f / length();
+        return ml::rsqrt(length_squared());
     }
 
     float dot_product(const vec4& v) const
@@ -174,7 +174,7 @@ struct vec4
     }
     vec4 operator/(float s) const
     {
-        return scale(1.0f / s);
+        return scale(ml::rcp(s));
     }
     vec4 operator/(const vec4& v) const
     {
@@ -4,6 +4,12 @@
 #define BOOST_TEST_MODULE closed interval fixed - point class test
 #include <boost/test/unit_test.hpp>
 
+/* C++ headers */
+#include <bit>
+#include <cmath>
+#include <random>
+#include <vector>
+
 /* user headers. */
 #include "ml/all.h"
 
@@ -78,4 +84,207 @@ BOOST_AUTO_TEST_CASE(comparisons)
     BOOST_CHECK_GE(one, one);
 }
 
+/*
+ * arithmetic.
+ */
+
+/** correctly rounded x / one, ties rounded up. */
+template<typename T>
+T reference_div_one(uint64_t x)
+{
+    constexpr uint64_t one = closed_unit_interval<T>::one;
+    return static_cast<T>(x / one + (2 * (x % one) >= one ? 1 : 0));
+}
+
+template<typename T>
+void check_arithmetic(closed_unit_interval<T> t, closed_unit_interval<T> a, closed_unit_interval<T> b)
+{
+    constexpr uint64_t one = closed_unit_interval<T>::one;
+    BOOST_CHECK_EQUAL(unwrap(a * b), reference_div_one<T>(uint64_t(a.data) * b.data));
+    BOOST_CHECK_EQUAL(unwrap(ml::lerp(t, a, b)), reference_div_one<T>(uint64_t(a.data) * (one - t.data) + uint64_t(b.data) * t.data));
+}
+
+BOOST_AUTO_TEST_CASE(multiplication)
+{
+    BOOST_CHECK_EQUAL(zero * one, zero);
+    BOOST_CHECK_EQUAL(one * one, one);
+    BOOST_CHECK_EQUAL(half * one, half);
+    BOOST_CHECK_EQUAL(unwrap(half * half), 1073741824u);
+
+    closed_unit_interval<uint32_t> x = half;
+    x *= half;
+    BOOST_CHECK_EQUAL(x, half * half);
+
+    // all 8-bit products.
+    for(unsigned a = 0; a < 256; ++a)
+    {
+        for(unsigned b = 0; b < 256; ++b)
+        {
+            const auto ua = wrap(static_cast<uint8_t>(a)), ub = wrap(static_cast<uint8_t>(b));
+            BOOST_REQUIRE_EQUAL(unwrap(ua * ub), reference_div_one<uint8_t>(a * b));
+        }
+    }
+
+    mt19937_64 engine{17};
+    for(int i = 0; i < 100000; ++i)
+    {
+        const uint64_t r = engine();
+        check_arithmetic(wrap(static_cast<uint16_t>(r)), wrap(static_cast<uint16_t>(r >> 16)), wrap(static_cast<uint16_t>(r >> 32)));
+        check_arithmetic(wrap(static_cast<uint32_t>(r)), wrap(static_cast<uint32_t>(r >> 32)), wrap(static_cast<uint32_t>(engine())));
+        check_arithmetic(wrap(static_cast<uint8_t>(r)), wrap(static_cast<uint8_t>(r >> 8)), wrap(static_cast<uint8_t>(r >> 16)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(interpolation)
+{
+    const closed_unit_interval<uint32_t> a{0.25f}, b{0.75f};
+
+    BOOST_CHECK_EQUAL(ml::lerp(zero, a, b), a);
+    BOOST_CHECK_EQUAL(ml::lerp(one, a, b), b);
+    BOOST_CHECK_EQUAL(ml::lerp(half, a, a), a);
+    BOOST_CHECK_CLOSE(to_float(ml::lerp(half, a, b)), 0.5f, 1e-5f);
+}
+
+/** check the packed kernels against the scalar operations for all lengths up to n. */
+template<typename T>
+void check_kernels(
+  std::size_t n,
+  void (*multiply)(std::span<const closed_unit_interval<T>>, std::span<const closed_unit_interval<T>>, std::span<closed_unit_interval<T>>),
+  void (*lerp)(std::span<const closed_unit_interval<T>>, std::span<const closed_unit_interval<T>>, std::span<const closed_unit_interval<T>>, std::span<closed_unit_interval<T>>))
+{
+    mt19937_64 engine{42};
+    for(std::size_t k = 0; k <= n; ++k)
+    {
+        vector<closed_unit_interval<T>> t(k), a(k), b(k);
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            t[i] = wrap(static_cast<T>(engine()));
+            a[i] = i % 5 == 0 ? wrap(closed_unit_interval<T>::one) : wrap(static_cast<T>(engine()));
+            b[i] = wrap(static_cast<T>(engine()));
+        }
+
+        // the last element is a guard.
+        vector<closed_unit_interval<T>> products(k + 1, wrap(T{7})), interpolated(k + 1, wrap(T{7}));
+        multiply(a, b, span{products}.first(k));
+        lerp(t, a, b, span{interpolated}.first(k));
+
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            BOOST_CHECK_EQUAL(products[i], a[i] * b[i]);
+            BOOST_CHECK_EQUAL(interpolated[i], ml::lerp(t[i], a[i], b[i]));
+        }
+        BOOST_CHECK_EQUAL(unwrap(products[k]), T{7});
+        BOOST_CHECK_EQUAL(unwrap(interpolated[k]), T{7});
+    }
+}
+
+BOOST_AUTO_TEST_CASE(kernels)
+{
+    check_kernels<uint8_t>(70, ml::multiply, ml::lerp);
+    check_kernels<uint16_t>(40, ml::multiply, ml::lerp);
+    check_kernels<uint32_t>(20, ml::multiply, ml::lerp);
+
+#if defined(ML_SIMD_X86)
+    check_kernels<uint8_t>(70, ml::simd::multiply, ml::simd::lerp);
+    check_kernels<uint16_t>(40, ml::simd::multiply, ml::simd::lerp);
+    check_kernels<uint32_t>(20, ml::simd::multiply, ml::simd::lerp);
+#endif
+#if defined(ML_SIMD_AVX2)
+    check_kernels<uint8_t>(70, ml::avx::multiply, ml::avx::lerp);
+    check_kernels<uint16_t>(40, ml::avx::multiply, ml::avx::lerp);
+    check_kernels<uint32_t>(20, ml::avx::multiply, ml::avx::lerp);
+#endif
+}
+
+/*
+ * conversion from float.
+ */
+
+/** the previous (branching) implementation of the clamping constructor. NaN is not allowed. */
+template<typename T>
+closed_unit_interval<T> reference_conversion(float in)
+{
+    using U = closed_unit_interval<T>;
+
+    if(in <= 0.f)
+    {
+        return wrap(T{0});
+    }
+    if(in >= 1.f)
+    {
+        return wrap(U::one);
+    }
+    if(in <= 0.5f)
+    {
+        return wrap(static_cast<T>(in * U::scale));
+    }
+    return wrap(static_cast<T>(static_cast<T>((in - 0.5f) * U::scale) + U::half));
+}
+
+/**
+ * compare the constructor with the reference and the kernel with the constructor, in blocks
+ * of 2^16 bit patterns. All floats in [0,1] are checked. The remaining inputs clamp to zero
+ * or one (or are NaN, which converts to zero), and only every 16th block of them is checked.
+ */
+template<typename T>
+void check_conversion(void (*quantize)(std::span<const float>, std::span<closed_unit_interval<T>>))
+{
+    constexpr std::uint32_t block = 1 << 16;
+    vector<float> in(block);
+    vector<closed_unit_interval<T>> out(block);
+
+    std::uint64_t constructor_errors = 0, kernel_errors = 0;
+    const std::uint64_t unit_end = std::bit_cast<std::uint32_t>(1.0f);
+    for(std::uint64_t base = 0; base < (std::uint64_t(1) << 32); base += block)
+    {
+        if(base > unit_end && (base / block) % 16 != 0)
+        {
+            continue;
+        }
+
+        for(std::uint32_t i = 0; i < block; ++i)
+        {
+            in[i] = std::bit_cast<float>(static_cast<std::uint32_t>(base + i));
+        }
+        quantize(in, out);
+
+        for(std::uint32_t i = 0; i < block; ++i)
+        {
+            const closed_unit_interval<T> c{in[i]};
+            const closed_unit_interval<T> expected = std::isnan(in[i]) ? wrap(T{0}) : reference_conversion<T>(in[i]);
+            constructor_errors += (c != expected);
+            kernel_errors += (out[i] != c);
+        }
+    }
+    BOOST_CHECK_EQUAL(constructor_errors, 0);
+    BOOST_CHECK_EQUAL(kernel_errors, 0);
+}
+
+BOOST_AUTO_TEST_CASE(conversion)
+{
+    // the batch kernel in the namespace ml, which is the fastest available one.
+    check_conversion<uint8_t>(ml::quantize);
+    check_conversion<uint16_t>(ml::quantize);
+    check_conversion<uint32_t>(ml::quantize);
+
+    // boundaries and the tail of the packed kernels.
+    const float values[] = {-1.f, -0.f, 0.f, 1e-30f, 0.25f, 0.5f, std::nextafter(0.5f, 1.f), std::nextafter(1.f, 0.f), 1.f, 2.f, INFINITY, NAN};
+    vector<fixed_32_t> out(std::size(values));
+    ml::quantize(values, out);
+    const std::uint32_t expected[] = {0, 0, 0, 0, 0x40000000, 0x80000000, 0x80000100, 0xffffff00, 0xffffffff, 0xffffffff, 0xffffffff, 0};
+    for(std::size_t i = 0; i < std::size(values); ++i)
+    {
+        BOOST_CHECK_EQUAL(unwrap(out[i]), expected[i]);
+    }
+}
+
+#if defined(ML_SIMD_AVX2) || defined(ML_SIMD_AVX512) || defined(ML_SIMD_DISPATCH)
+BOOST_AUTO_TEST_CASE(conversion_simd)
+{
+    check_conversion<uint8_t>(ml::simd::quantize);
+    check_conversion<uint16_t>(ml::simd::quantize);
+    check_conversion<uint32_t>(ml::simd::quantize);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
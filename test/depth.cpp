@@ -0,0 +1,348 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * tests for the depth test, the depth buffer and the depth pyramid.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+/* boost test framework. */
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#define BOOST_TEST_MODULE depth test
+#include <boost/test/unit_test.hpp>
+
+/* C++ headers */
+#include <array>
+#include <random>
+
+/* user headers. */
+#include "ml/all.h"
+
+using namespace std;
+
+/*
+ * Helpers.
+ */
+
+/** all comparison functions. */
+const ml::depth_compare all_compares[] = {
+  ml::depth_compare::never, ml::depth_compare::less, ml::depth_compare::less_equal, ml::depth_compare::equal,
+  ml::depth_compare::greater, ml::depth_compare::greater_equal, ml::depth_compare::not_equal, ml::depth_compare::always};
+
+/** random depths. A small range makes equal values likely, and the values above 2^31 check the unsigned comparison. */
+struct random_depths
+{
+    mt19937 engine{42};
+    uniform_int_distribution<std::uint32_t> dist{0, 7};
+
+    ml::fixed_32_t operator()()
+    {
+        constexpr std::uint32_t values[8] = {0, 1, 0x7fffffff, 0x80000000, 0x80000001, 0xc0000000, 0xfffffffe, 0xffffffff};
+        return ml::wrap(values[dist(engine)]);
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(depth)
+
+BOOST_AUTO_TEST_CASE(depth_test_scalar)
+{
+    const ml::fixed_32_t a = ml::wrap(std::uint32_t{1}), b = ml::wrap(std::uint32_t{0x80000000});
+
+    BOOST_CHECK(!ml::depth_test(ml::depth_compare::never, a, a));
+    BOOST_CHECK(ml::depth_test(ml::depth_compare::less, a, b));
+    BOOST_CHECK(!ml::depth_test(ml::depth_compare::less, b, a));
+    BOOST_CHECK(ml::depth_test(ml::depth_compare::less_equal, a, a));
+    BOOST_CHECK(ml::depth_test(ml::depth_compare::equal, b, b));
+    BOOST_CHECK(ml::depth_test(ml::depth_compare::greater, b, a));
+    BOOST_CHECK(ml::depth_test(ml::depth_compare::greater_equal, b, b));
+    BOOST_CHECK(ml::depth_test(ml::depth_compare::not_equal, a, b));
+    BOOST_CHECK(ml::depth_test(ml::depth_compare::always, b, a));
+}
+
+#if defined(ML_SIMD_X86)
+
+/** compare a SIMD kernel for N samples with the scalar depth test. */
+template<std::size_t N, typename K>
+void check_kernel(ml::depth_compare f, K&& kernel)
+{
+    random_depths depths;
+    for(int k = 0; k < 1000; ++k)
+    {
+        std::array<ml::fixed_32_t, N> z, d, expected;
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            z[i] = depths();
+            d[i] = expected[i] = depths();
+        }
+        const unsigned int mask = depths.engine() & ((1u << N) - 1);
+        const bool write = (k & 1) != 0;
+
+        unsigned int expected_pass = 0;
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            if(((mask >> i) & 1) != 0 && ml::depth_test(f, z[i], d[i]))
+            {
+                expected_pass |= 1u << i;
+                if(write)
+                {
+                    expected[i] = z[i];
+                }
+            }
+        }
+
+        BOOST_REQUIRE_EQUAL(kernel(d.data(), z.data(), mask, write), expected_pass);
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            BOOST_REQUIRE_EQUAL(ml::unwrap(d[i]), ml::unwrap(expected[i]));
+        }
+    }
+}
+
+template<ml::depth_compare F>
+void check_kernels()
+{
+    check_kernel<4>(
+      F, [](ml::fixed_32_t* d, const ml::fixed_32_t* z, unsigned int mask, bool write)
+      { return ml::simd::depth_test_and_update_x4<F>(d, _mm_loadu_si128(reinterpret_cast<const __m128i*>(z)), mask, write); });
+
+#    if defined(ML_SIMD_AVX2)
+    check_kernel<8>(
+      F, [](ml::fixed_32_t* d, const ml::fixed_32_t* z, unsigned int mask, bool write)
+      { return ml::simd::depth_test_and_update_x8<F>(d, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(z)), mask, write); });
+#    endif
+}
+
+BOOST_AUTO_TEST_CASE(depth_test_simd)
+{
+    check_kernels<ml::depth_compare::never>();
+    check_kernels<ml::depth_compare::less>();
+    check_kernels<ml::depth_compare::less_equal>();
+    check_kernels<ml::depth_compare::equal>();
+    check_kernels<ml::depth_compare::greater>();
+    check_kernels<ml::depth_compare::greater_equal>();
+    check_kernels<ml::depth_compare::not_equal>();
+    check_kernels<ml::depth_compare::always>();
+}
+
+#endif /* defined(ML_SIMD_X86) */
+
+BOOST_AUTO_TEST_CASE(depth_buffer_layout)
+{
+    ml::depth_buffer buffer{20, 10, ml::fixed_32_t{0.5f}};
+    BOOST_CHECK_EQUAL(buffer.width(), 20);
+    BOOST_CHECK_EQUAL(buffer.height(), 10);
+    BOOST_CHECK_EQUAL(buffer.tile_count_x(), 3);
+    BOOST_CHECK_EQUAL(buffer.tile_count_y(), 2);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(&buffer.get_tile(1, 1)) % 64, 0u);
+    BOOST_CHECK(buffer.at(19, 9) == ml::fixed_32_t{0.5f});
+
+    buffer.at(13, 9) = ml::fixed_32_t{0.25f};
+    BOOST_CHECK(buffer.get_tile(1, 1).samples[1 * 8 + 5] == ml::fixed_32_t{0.25f});
+
+    buffer.clear(ml::fixed_32_t{1.0f});
+    BOOST_CHECK(buffer.at(13, 9) == ml::fixed_32_t{1.0f});
+}
+
+BOOST_AUTO_TEST_CASE(depth_buffer_test_and_update)
+{
+    random_depths depths;
+    for(auto f: all_compares)
+    {
+        for(int k = 0; k < 50; ++k)
+        {
+            ml::depth_buffer buffer{16, 16}, expected{16, 16};
+            for(int y = 0; y < 16; ++y)
+            {
+                for(int x = 0; x < 16; ++x)
+                {
+                    buffer.at(x, y) = expected.at(x, y) = depths();
+                }
+            }
+
+            std::array<ml::fixed_32_t, 64> z;
+            for(auto& s: z)
+            {
+                s = depths();
+            }
+            const std::uint64_t mask = (std::uint64_t{depths.engine()} << 32) | depths.engine();
+            const bool write = (k & 1) != 0;
+
+            std::uint64_t expected_pass = 0;
+            for(int i = 0; i < 64; ++i)
+            {
+                if(((mask >> i) & 1) != 0 && expected.test_and_update(8 + i % 8, 8 + i / 8, z[i], f, write))
+                {
+                    expected_pass |= std::uint64_t{1} << i;
+                }
+            }
+
+            BOOST_REQUIRE_EQUAL(buffer.test_and_update(8, 8, z, mask, f, write), expected_pass);
+            for(int y = 0; y < 16; ++y)
+            {
+                for(int x = 0; x < 16; ++x)
+                {
+                    BOOST_REQUIRE_EQUAL(ml::unwrap(buffer.at(x, y)), ml::unwrap(expected.at(x, y)));
+                }
+            }
+        }
+    }
+}
+
+/*
+ * hierarchical depth pyramid.
+ */
+
+/** fill a depth buffer with random depths. */
+void fill_random(ml::depth_buffer& buffer, mt19937& engine)
+{
+    uniform_int_distribution<std::uint32_t> dist;
+    for(int y = 0; y < buffer.height(); ++y)
+    {
+        for(int x = 0; x < buffer.width(); ++x)
+        {
+            buffer.at(x, y) = ml::wrap(dist(engine));
+        }
+    }
+}
+
+/** depth range of a rectangle of samples. */
+ml::depth_range reference_range(const ml::depth_buffer& buffer, int x0, int y0, int x1, int y1)
+{
+    ml::depth_range r;
+    for(int y = std::max(y0, 0); y < std::min(y1, buffer.height()); ++y)
+    {
+        for(int x = std::max(x0, 0); x < std::min(x1, buffer.width()); ++x)
+        {
+            r.merge({buffer.at(x, y), buffer.at(x, y)});
+        }
+    }
+    return r;
+}
+
+/** check all cells of a pyramid against the depth buffer. */
+void check_pyramid(const ml::hiz_pyramid& hiz, const ml::depth_buffer& buffer)
+{
+    for(int i = 0; i < hiz.level_count(); ++i)
+    {
+        const auto& l = hiz.get_level(i);
+        const int size = ml::depth_buffer::tile_size << i;
+        for(int y = 0; y < l.height; ++y)
+        {
+            for(int x = 0; x < l.width; ++x)
+            {
+                const ml::depth_range r = reference_range(buffer, x * size, y * size, (x + 1) * size, (y + 1) * size);
+                BOOST_REQUIRE_EQUAL(ml::unwrap(l.at(x, y).min_z), ml::unwrap(r.min_z));
+                BOOST_REQUIRE_EQUAL(ml::unwrap(l.at(x, y).max_z), ml::unwrap(r.max_z));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hiz_pyramid_build)
+{
+    mt19937 engine{42};
+    for(auto [width, height]: {std::pair{64, 64}, std::pair{100, 37}, std::pair{8, 8}, std::pair{3, 70}})
+    {
+        ml::depth_buffer buffer{width, height, ml::fixed_32_t{0.0f}};
+        fill_random(buffer, engine);
+
+        const ml::hiz_pyramid hiz{buffer};
+        BOOST_CHECK_EQUAL(hiz.get_level(hiz.level_count() - 1).width, 1);
+        BOOST_CHECK_EQUAL(hiz.get_level(hiz.level_count() - 1).height, 1);
+        check_pyramid(hiz, buffer);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hiz_pyramid_update)
+{
+    mt19937 engine{42};
+    uniform_int_distribution<int> coordinate{0, 99};
+    uniform_int_distribution<std::uint32_t> dist;
+
+    ml::depth_buffer buffer{100, 75};
+    fill_random(buffer, engine);
+    ml::hiz_pyramid hiz{buffer};
+
+    for(int k = 0; k < 20; ++k)
+    {
+        // write a few samples through the tile test, and a few directly.
+        const int x = coordinate(engine) % buffer.width(), y = coordinate(engine) % buffer.height();
+        std::array<ml::fixed_32_t, 64> z;
+        for(auto& s: z)
+        {
+            s = ml::wrap(dist(engine));
+        }
+        const int tx = x / 8, ty = y / 8;
+        const std::uint64_t mask = (std::uint64_t{dist(engine)} << 32) | dist(engine);
+        if(buffer.test_and_update(tx * 8, ty * 8, z, mask, ml::depth_compare::less) != 0)
+        {
+            hiz.mark_dirty(tx, ty);
+        }
+
+        buffer.at(x, y) = ml::wrap(dist(engine));
+        hiz.mark_dirty(x, y, x + 1, y + 1);
+
+        hiz.update(buffer);
+        check_pyramid(hiz, buffer);
+    }
+
+    buffer.clear(ml::fixed_32_t{0.5f});
+    hiz.mark_all_dirty();
+    hiz.update(buffer);
+    check_pyramid(hiz, buffer);
+}
+
+BOOST_AUTO_TEST_CASE(hiz_pyramid_query)
+{
+    mt19937 engine{42};
+    uniform_int_distribution<int> coordinate{-10, 110};
+    uniform_int_distribution<std::uint32_t> dist;
+
+    ml::depth_buffer buffer{100, 75};
+    fill_random(buffer, engine);
+    const ml::hiz_pyramid hiz{buffer};
+
+    for(int k = 0; k < 1000; ++k)
+    {
+        int x0 = coordinate(engine), x1 = coordinate(engine), y0 = coordinate(engine), y1 = coordinate(engine);
+        if(x0 > x1)
+        {
+            std::swap(x0, x1);
+        }
+        if(y0 > y1)
+        {
+            std::swap(y0, y1);
+        }
+
+        // the queried range contains the exact range.
+        const ml::depth_range exact = reference_range(buffer, x0, y0, x1, y1);
+        const ml::depth_range r = hiz.query(x0, y0, x1, y1);
+        BOOST_REQUIRE_EQUAL(exact.empty(), r.empty());
+        if(exact.empty())
+        {
+            continue;
+        }
+        BOOST_REQUIRE(r.min_z <= exact.min_z);
+        BOOST_REQUIRE(r.max_z >= exact.max_z);
+
+        // rejected rectangles are occluded.
+        const ml::fixed_32_t z = ml::wrap(dist(engine));
+        for(auto f: all_compares)
+        {
+            if(!hiz.maybe_visible(x0, y0, x1, y1, z, f))
+            {
+                BOOST_REQUIRE(!exact.may_pass(f, z));
+            }
+        }
+    }
+
+    // a rectangle behind everything is rejected, and one in front of everything is not.
+    const ml::depth_range all = hiz.query(0, 0, 100, 75);
+    BOOST_CHECK(!hiz.maybe_visible(10, 10, 30, 20, all.max_z));
+    BOOST_CHECK(hiz.maybe_visible(10, 10, 30, 20, ml::wrap(std::uint32_t{0})) || ml::unwrap(all.max_z) == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,925 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * tests for the geometric objects and culling.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+/* boost test framework. */
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#define BOOST_TEST_MODULE geometry test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/tools/floating_point_comparison.hpp>
+
+/* C++ headers */
+#include <array>
+#include <random>
+#include <vector>
+
+// include the bounding volume hierarchy.
+#define ML_INCLUDE_BVH
+
+/* user headers. */
+#include "ml/all.h"
+
+using namespace std;
+
+/*
+ * Helpers.
+ */
+
+/** random points in a box. */
+struct random_points
+{
+    mt19937 engine{42};
+    uniform_real_distribution<float> dist{-60.f, 60.f};
+
+    float coordinate()
+    {
+        return dist(engine);
+    }
+
+    ml::vec3 point()
+    {
+        return {coordinate(), coordinate(), coordinate()};
+    }
+};
+
+/** a camera looking down the negative z axis, rotated and translated. */
+ml::mat4x4 test_view_projection()
+{
+    return ml::matrices::perspective_projection(4.f / 3.f, 1.2f, 0.5f, 50.f)
+           * ml::matrices::rotation_y(0.3f)
+           * ml::matrices::translation(1.f, -2.f, 3.f);
+}
+
+/** whether a point is inside the clip volume of a matrix. */
+bool inside_clip_volume(const ml::mat4x4& m, const ml::vec3& p)
+{
+    const ml::vec4 c = m * ml::vec4{p.x, p.y, p.z, 1.f};
+    return std::abs(c.x) <= c.w && std::abs(c.y) <= c.w && std::abs(c.z) <= c.w;
+}
+
+BOOST_AUTO_TEST_SUITE(geometry)
+
+/*
+ * axis-aligned bounding boxes.
+ */
+
+BOOST_AUTO_TEST_CASE(aabb_operations)
+{
+    const ml::aabb3 empty;
+    BOOST_CHECK(empty.empty());
+
+    const ml::aabb3 a{{0, 0, 0}, {2, 2, 2}}, b{{1, 1, 1}, {3, 4, 5}}, c{{5, 5, 5}, {6, 6, 6}};
+    BOOST_CHECK(!a.empty());
+    BOOST_CHECK(empty.united(a).min == a.min && empty.united(a).max == a.max);
+
+    const ml::aabb3 u = a.united(b);
+    BOOST_CHECK(u.min == ml::vec3(0, 0, 0) && u.max == ml::vec3(3, 4, 5));
+    BOOST_CHECK(u.contains(a) && u.contains(b) && !a.contains(b));
+
+    const ml::aabb3 i = a.intersection(b);
+    BOOST_CHECK(i.min == ml::vec3(1, 1, 1) && i.max == ml::vec3(2, 2, 2));
+    BOOST_CHECK(a.intersects(b) && !a.intersects(c) && a.intersection(c).empty());
+    BOOST_CHECK(a.contains(ml::vec3(2, 0, 1)) && !a.contains(ml::vec3(2, 0, 2.5f)));
+    BOOST_CHECK(a.center() == ml::vec3(1, 1, 1) && b.extent() == ml::vec3(1, 1.5f, 2));
+
+    ml::aabb3 m;
+    m.merge(ml::vec3{1, -1, 0});
+    m.merge(ml::vec3{-1, 1, 0});
+    BOOST_CHECK(m.min == ml::vec3(-1, -1, 0) && m.max == ml::vec3(1, 1, 0));
+
+    // the padded version gives the same results.
+    const ml::aligned_aabb3 pa{a}, pb{b}, pc{c};
+    BOOST_CHECK(pa.united(pb).unpadded().min == u.min && pa.united(pb).unpadded().max == u.max);
+    BOOST_CHECK(pa.intersection(pb).unpadded().min == i.min && pa.intersection(pb).unpadded().max == i.max);
+    BOOST_CHECK(pa.intersects(pb) && !pa.intersects(pc) && pa.intersection(pc).empty());
+    BOOST_CHECK(pa.united(pb).contains(pa) && !pa.contains(pb));
+    BOOST_CHECK(ml::aligned_aabb3{}.empty());
+}
+
+/** check that a transformed box is the bounding box of the transformed corners. */
+void check_transformed(const ml::aabb3& b, const ml::mat4x4& m, const ml::aabb3& t)
+{
+    ml::aabb3 corners;
+    for(int k = 0; k < 8; ++k)
+    {
+        const ml::vec4 p = m * ml::vec4{(k & 1) ? b.max.x : b.min.x, (k & 2) ? b.max.y : b.min.y, (k & 4) ? b.max.z : b.min.z, 1.f};
+        corners.merge(ml::vec3{p.x, p.y, p.z});
+    }
+    for(int i = 0; i < 3; ++i)
+    {
+        BOOST_REQUIRE_SMALL(t.min[i] - corners.min[i], 1e-3f);
+        BOOST_REQUIRE_SMALL(t.max[i] - corners.max[i], 1e-3f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(aabb_transform)
+{
+    random_points points;
+    std::vector<ml::aabb3> boxes(101);
+    std::vector<ml::aligned_aabb3> padded(boxes.size());
+    for(std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        const ml::vec3 c = points.point(), e = points.point() * 0.1f;
+        boxes[i] = ml::aabb3::from_center_extent(c, {std::abs(e.x), std::abs(e.y), std::abs(e.z)});
+        padded[i] = ml::aligned_aabb3{boxes[i]};
+    }
+
+    const ml::mat4x4 m = ml::matrices::translation(1.f, -2.f, 3.f)
+                         * ml::matrices::rotation(ml::vec3{1.f, 2.f, 3.f}.normalized(), 0.7f)
+                         * ml::matrices::diagonal(2.f, 0.5f, -1.f, 1.f);
+
+    std::vector<ml::aabb3> out(boxes.size());
+    ml::transform_aabbs(m, boxes, out);
+    std::vector<ml::aligned_aabb3> padded_out(padded.size());
+    ml::transform_aabbs(m, padded, padded_out);
+
+    for(std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        check_transformed(boxes[i], m, boxes[i].transformed(m));
+        check_transformed(boxes[i], m, out[i]);
+        check_transformed(boxes[i], m, padded_out[i].unpadded());
+        check_transformed(boxes[i], m, ml::transformed(padded[i], m).unpadded());
+    }
+
+    // in place.
+    ml::transform_aabbs(m, boxes, boxes);
+    for(std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        BOOST_CHECK(boxes[i].min == out[i].min && boxes[i].max == out[i].max);
+    }
+
+    // empty boxes stay empty and neutral for merge.
+    const ml::aabb3 empty;
+    const ml::aabb3 empty_y{{0, 1, 0}, {1, -1, 1}};
+    std::vector<ml::aabb3> empties{empty, empty_y, out[0]};
+    std::vector<ml::aligned_aabb3> padded_empties{ml::aligned_aabb3{empty}, ml::aligned_aabb3{empty_y}};
+    ml::transform_aabbs(m, empties, empties);
+    ml::transform_aabbs(m, padded_empties, padded_empties);
+    BOOST_CHECK(empty.transformed(m).empty());
+    BOOST_CHECK(empty_y.transformed(m).empty());
+    BOOST_CHECK(ml::transformed(ml::aligned_aabb3{empty}, m).empty());
+    for(int i = 0; i < 2; ++i)
+    {
+        BOOST_CHECK(empties[i].empty());
+        BOOST_CHECK(padded_empties[i].empty());
+    }
+
+    // non-empty boxes next to empty ones are transformed.
+    check_transformed(out[0], m, empties[2]);
+
+    ml::aabb3 merged = empty.transformed(m);
+    merged.merge(out[0]);
+    BOOST_CHECK(merged.min == out[0].min && merged.max == out[0].max);
+}
+
+/*
+ * frustum.
+ */
+
+BOOST_AUTO_TEST_CASE(frustum_extraction)
+{
+    const float znear = 0.5f, zfar = 50.f;
+    const ml::frustum f{ml::matrices::perspective_projection(1.f, 1.2f, znear, zfar)};
+
+    for(const auto& p: f.planes)
+    {
+        BOOST_CHECK_CLOSE(p.normal.length(), 1.f, 1e-4f);
+    }
+
+    // the near and far planes are at z = -znear and z = -zfar, with normals pointing inside.
+    BOOST_CHECK_SMALL(f.planes[ml::frustum::near_plane].distance({0, 0, -znear}), 1e-4f);
+    BOOST_CHECK_SMALL(f.planes[ml::frustum::far_plane].distance({0, 0, -zfar}), 1e-3f);
+    BOOST_CHECK_CLOSE(f.planes[ml::frustum::near_plane].distance({0, 0, -1}), 0.5f, 1e-2f);
+    for(int i = 0; i < 6; ++i)
+    {
+        BOOST_CHECK_GT(f.planes[i].distance({0, 0, -10}), 0.f);
+    }
+
+    const ml::frustum o{ml::matrices::orthographic_projection(-2.f, 2.f, -1.f, 1.f, 1.f, 10.f)};
+    BOOST_CHECK_SMALL(o.planes[ml::frustum::left_plane].distance({-2.f, 0, -5.f}), 1e-5f);
+    BOOST_CHECK_SMALL(o.planes[ml::frustum::top_plane].distance({0, 1.f, -5.f}), 1e-5f);
+    BOOST_CHECK_CLOSE(o.planes[ml::frustum::right_plane].distance({0, 0, -5.f}), 2.f, 1e-4f);
+}
+
+BOOST_AUTO_TEST_CASE(frustum_points)
+{
+    // points with a margin to the planes are inside the frustum exactly if they are inside the clip volume.
+    const ml::mat4x4 m = test_view_projection();
+    const ml::frustum f{m};
+
+    random_points points;
+    int inside = 0;
+    for(int k = 0; k < 10000; ++k)
+    {
+        const ml::vec3 p = points.point();
+
+        float min_distance = f.planes[0].distance(p);
+        for(int i = 1; i < 6; ++i)
+        {
+            min_distance = std::min(min_distance, f.planes[i].distance(p));
+        }
+        if(std::abs(min_distance) < 1e-3f)
+        {
+            continue;
+        }
+
+        BOOST_REQUIRE_EQUAL(min_distance > 0, inside_clip_volume(m, p));
+        BOOST_REQUIRE_EQUAL(min_distance > 0, f.intersects_sphere(p, 0));
+        BOOST_REQUIRE_EQUAL(min_distance > 0, f.intersects_aabb(p, p));
+        inside += min_distance > 0;
+    }
+    BOOST_CHECK_GT(inside, 100);
+}
+
+BOOST_AUTO_TEST_CASE(frustum_bounding_volumes)
+{
+    const ml::frustum f{test_view_projection()};
+    random_points points;
+    for(int k = 0; k < 10000; ++k)
+    {
+        const ml::vec3 c = points.point();
+        const float r = std::abs(points.coordinate()) * 0.1f;
+
+        // a box around a sphere is accepted if the sphere is, and a sphere around a box if the box is.
+        const ml::vec3 e{r, r, r};
+        if(f.intersects_sphere(c, r))
+        {
+            BOOST_REQUIRE(f.intersects_aabb(c - e, c + e));
+        }
+        if(f.intersects_aabb(c - e, c + e))
+        {
+            BOOST_REQUIRE(f.intersects_sphere(c, r * std::sqrt(3.f) * 1.001f));
+        }
+    }
+}
+
+/*
+ * culling.
+ */
+
+/** check visibility bits against a scalar test, ignoring objects within a tolerance of a plane. */
+template<typename T, typename M>
+void check_visibility(const std::vector<std::uint64_t>& visible, std::size_t n, T&& test, M&& margin)
+{
+    for(std::size_t i = 0; i < (n + 63) / 64 * 64; ++i)
+    {
+        const bool bit = ((visible[i / 64] >> (i % 64)) & 1) != 0;
+        if(i >= n)
+        {
+            BOOST_REQUIRE(!bit);
+        }
+        else if(margin(i) > 1e-4f)
+        {
+            BOOST_REQUIRE_EQUAL(bit, test(i));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(cull_spheres)
+{
+    const ml::frustum f{test_view_projection()};
+
+    // a size that is not a multiple of the packet size.
+    const std::size_t n = 1003;
+    random_points points;
+    std::vector<float> x(n), y(n), z(n), r(n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        x[i] = points.coordinate();
+        y[i] = points.coordinate();
+        z[i] = points.coordinate();
+        r[i] = std::abs(points.coordinate()) * 0.1f;
+    }
+
+    std::vector<std::uint64_t> visible((n + 63) / 64 + 1, ~std::uint64_t{0});
+    ml::cull_spheres(f, {x, y, z, r}, visible);
+    BOOST_CHECK_EQUAL(visible.back(), ~std::uint64_t{0});
+
+    int count = 0;
+    check_visibility(
+      visible, n,
+      [&](std::size_t i) -> bool
+      {
+          count += f.intersects_sphere({x[i], y[i], z[i]}, r[i]);
+          return f.intersects_sphere({x[i], y[i], z[i]}, r[i]);
+      },
+      [&](std::size_t i) -> float
+      {
+          float m = std::numeric_limits<float>::max();
+          for(int k = 0; k < 6; ++k)
+          {
+              m = std::min(m, std::abs(f.planes[k].distance({x[i], y[i], z[i]}) + r[i]));
+          }
+          return m;
+      });
+    BOOST_CHECK_GT(count, 10);
+}
+
+BOOST_AUTO_TEST_CASE(cull_aabbs)
+{
+    const ml::frustum f{test_view_projection()};
+
+    const std::size_t n = 1003;
+    random_points points;
+    std::vector<float> min_x(n), min_y(n), min_z(n), max_x(n), max_y(n), max_z(n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        const ml::vec3 a = points.point(), b = points.point() * 0.1f;
+        min_x[i] = a.x - std::abs(b.x);
+        min_y[i] = a.y - std::abs(b.y);
+        min_z[i] = a.z - std::abs(b.z);
+        max_x[i] = a.x + std::abs(b.x);
+        max_y[i] = a.y + std::abs(b.y);
+        max_z[i] = a.z + std::abs(b.z);
+    }
+
+    std::vector<std::uint64_t> visible((n + 63) / 64 + 1, ~std::uint64_t{0});
+    ml::cull_aabbs(f, {min_x, min_y, min_z, max_x, max_y, max_z}, visible);
+    BOOST_CHECK_EQUAL(visible.back(), ~std::uint64_t{0});
+
+    int count = 0;
+    check_visibility(
+      visible, n,
+      [&](std::size_t i) -> bool
+      {
+          const bool v = f.intersects_aabb({min_x[i], min_y[i], min_z[i]}, {max_x[i], max_y[i], max_z[i]});
+          count += v;
+          return v;
+      },
+      [&](std::size_t i) -> float
+      {
+          float m = std::numeric_limits<float>::max();
+          for(int k = 0; k < 6; ++k)
+          {
+              const ml::normalized_plane& p = f.planes[k];
+              const ml::vec3 v{p.normal.x >= 0 ? max_x[i] : min_x[i], p.normal.y >= 0 ? max_y[i] : min_y[i], p.normal.z >= 0 ? max_z[i] : min_z[i]};
+              m = std::min(m, std::abs(f.planes[k].distance(v)));
+          }
+          return m;
+      });
+    BOOST_CHECK_GT(count, 10);
+}
+
+/*
+ * point classification.
+ */
+
+BOOST_AUTO_TEST_CASE(normalized_plane)
+{
+    const ml::normalized_plane p{ml::plane{0, 0, 2, -4}};
+    BOOST_CHECK_CLOSE(p.normal.length(), 1.f, 1e-4f);
+    BOOST_CHECK_CLOSE(p.distance({1, 2, 3}), 1.f, 1e-4f);
+
+    // plane::distance may use a reciprocal square root estimate.
+    BOOST_CHECK_CLOSE(p.distance({1, 2, 3}), ml::plane(0, 0, 2, -4).distance({1, 2, 3}), 0.1f);
+
+    const ml::normalized_plane q = ml::normalized_plane::from_point_normal({1, 1, 1}, {3, 0, 4});
+    BOOST_CHECK_SMALL(q.distance({1, 1, 1}), 1e-6f);
+    BOOST_CHECK_CLOSE(q.distance({1.6f, 1, 1.8f}), 1.f, 1e-4f);
+    BOOST_CHECK(q.classify({1.6f, 1, 1.8f}, 0.5f) == ml::plane_side::front);
+    BOOST_CHECK(q.classify({1.6f, 1, 1.8f}, 2.f) == ml::plane_side::on);
+    BOOST_CHECK(q.classify({0.4f, 1, 0.2f}, 0.5f) == ml::plane_side::back);
+    BOOST_CHECK(q.classify({1, 1, 1}, 0.f) == ml::plane_side::on);
+
+    const ml::normalized_plane u = ml::normalized_plane::from_unit_normal({0, 1, 0}, 2.f);
+    BOOST_CHECK_EQUAL(u.distance({5, -2, 7}), 0.f);
+}
+
+/** check classification bits against the scalar side, ignoring points within a tolerance of the epsilon boundaries. */
+template<typename S, typename D>
+void check_classification(
+  const std::vector<std::uint64_t>& front, const std::vector<std::uint64_t>& back, const std::vector<std::uint64_t>& on,
+  std::size_t n, S&& side, D&& boundary_distance)
+{
+    for(std::size_t i = 0; i < (n + 63) / 64 * 64; ++i)
+    {
+        const bool f = ((front[i / 64] >> (i % 64)) & 1) != 0;
+        const bool b = ((back[i / 64] >> (i % 64)) & 1) != 0;
+        const bool o = ((on[i / 64] >> (i % 64)) & 1) != 0;
+        if(i >= n)
+        {
+            BOOST_REQUIRE(!f && !b && !o);
+            continue;
+        }
+        BOOST_REQUIRE_EQUAL(f + b + o, 1);
+        if(boundary_distance(i) > 1e-4f)
+        {
+            const ml::plane_side s = side(i);
+            BOOST_REQUIRE_EQUAL(f, s == ml::plane_side::front);
+            BOOST_REQUIRE_EQUAL(b, s == ml::plane_side::back);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(classify_points)
+{
+    const std::size_t n = 1003;
+    random_points points;
+    std::vector<float> x(n), y(n), z(n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        const ml::vec3 p = points.point();
+        x[i] = p.x;
+        y[i] = p.y;
+        z[i] = p.z;
+    }
+    const ml::point_array array{x, y, z};
+    const float epsilon = 5.f;
+
+    std::vector<std::uint64_t> front((n + 63) / 64 + 1, ~std::uint64_t{0}), back(front), on(front);
+
+    // one plane.
+    const ml::normalized_plane p{ml::plane{1, -2, 0.5f, 3}};
+    ml::classify_points(p, array, epsilon, front, back, on);
+    BOOST_CHECK_EQUAL(front.back(), ~std::uint64_t{0});
+
+    int counts[3] = {0, 0, 0};
+    check_classification(
+      front, back, on, n,
+      [&](std::size_t i)
+      {
+          const ml::plane_side s = p.classify({x[i], y[i], z[i]}, epsilon);
+          ++counts[static_cast<int>(s) + 1];
+          return s;
+      },
+      [&](std::size_t i) { return std::abs(std::abs(p.distance({x[i], y[i], z[i]})) - epsilon); });
+    BOOST_CHECK_GT(counts[0], 10);
+    BOOST_CHECK_GT(counts[1], 10);
+    BOOST_CHECK_GT(counts[2], 10);
+
+    // the planes of a frustum.
+    const ml::frustum f{test_view_projection()};
+    const float margin = 0.5f;
+    ml::classify_points(f.planes, array, margin, front, back, on);
+
+    int inside = 0, boundary = 0;
+    check_classification(
+      front, back, on, n,
+      [&](std::size_t i)
+      {
+          bool all_front = true, any_back = false;
+          for(int k = 0; k < 6; ++k)
+          {
+              all_front = all_front && f.planes[k].distance({x[i], y[i], z[i]}) > margin;
+              any_back = any_back || f.planes[k].distance({x[i], y[i], z[i]}) < -margin;
+          }
+          inside += all_front;
+          boundary += !all_front && !any_back;
+          return all_front ? ml::plane_side::front : (any_back ? ml::plane_side::back : ml::plane_side::on);
+      },
+      [&](std::size_t i)
+      {
+          float m = std::numeric_limits<float>::max();
+          for(int k = 0; k < 6; ++k)
+          {
+              m = std::min(m, std::abs(std::abs(f.planes[k].distance({x[i], y[i], z[i]})) - margin));
+          }
+          return m;
+      });
+    BOOST_CHECK_GT(inside, 10);
+    BOOST_CHECK_GT(boundary, 0);
+
+    // an empty set puts all points in front.
+    ml::classify_points(std::span<const ml::normalized_plane>{}, array, margin, front, back, on);
+    BOOST_CHECK_EQUAL(front[0], ~std::uint64_t{0});
+    BOOST_CHECK_EQUAL(front[n / 64], (std::uint64_t{1} << (n % 64)) - 1);
+    BOOST_CHECK_EQUAL(back[0] | on[0], 0);
+}
+
+/*
+ * rays and bounding volume hierarchy.
+ */
+
+BOOST_AUTO_TEST_CASE(ray_triangle)
+{
+    const ml::vec3 v0{0, 0, 0}, v1{1, 0, 0}, v2{0, 1, 0};
+
+    ml::ray_hit hit;
+    BOOST_CHECK(ml::intersect_triangle(ml::line3{{0.25f, 0.5f, 2.f}, {0, 0, -1}}, v0, v1, v2, hit));
+    BOOST_CHECK_CLOSE(hit.t, 2.f, 1e-4f);
+    BOOST_CHECK_CLOSE(hit.u, 0.25f, 1e-4f);
+    BOOST_CHECK_CLOSE(hit.v, 0.5f, 1e-4f);
+
+    // closer hits only, from both sides, not behind the origin.
+    BOOST_CHECK(!ml::intersect_triangle(ml::line3{{0.25f, 0.5f, 3.f}, {0, 0, -1}}, v0, v1, v2, hit));
+    BOOST_CHECK(ml::intersect_triangle(ml::line3{{0.25f, 0.5f, -1.f}, {0, 0, 1}}, v0, v1, v2, hit));
+    BOOST_CHECK_CLOSE(hit.t, 1.f, 1e-4f);
+    BOOST_CHECK(!ml::intersect_triangle(ml::line3{{0.25f, 0.5f, 1.f}, {0, 0, 1}}, v0, v1, v2, hit = ml::ray_hit{}));
+    BOOST_CHECK(!ml::intersect_triangle(ml::line3{{0.75f, 0.5f, 1.f}, {0, 0, -1}}, v0, v1, v2, hit));
+    BOOST_CHECK(!ml::intersect_triangle(ml::line3{{0.25f, 0.5f, 1.f}, {1, 0, 0}}, v0, v1, v2, hit));
+
+    // ray-box.
+    const ml::aabb3 b{{-1, -1, -1}, {1, 1, 1}};
+    const ml::line3 r{{-3, 0, 0}, {2, 0, 0}};
+    const ml::vec3 inv{0.5f, std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()};
+    BOOST_CHECK_CLOSE(ml::intersect_aabb(r, inv, b, 10.f), 1.f, 1e-4f);
+    BOOST_CHECK_EQUAL(ml::intersect_aabb(r, inv, b, 0.5f), std::numeric_limits<float>::infinity());
+    BOOST_CHECK_EQUAL(ml::intersect_aabb(ml::line3{{0, 0, 0}, {1, 0, 0}}, {1.f, inv.y, inv.z}, b, 10.f), 0.f);
+
+    // axis-aligned rays with the origin on a slab plane.
+    const ml::vec3 inv_z{inv.y, inv.z, -1.f};
+    BOOST_CHECK_CLOSE(ml::intersect_aabb(ml::line3{{-1, 1, 3}, {0, 0, -1}}, inv_z, b, 10.f), 2.f, 1e-4f);
+    BOOST_CHECK_CLOSE(ml::intersect_aabb(ml::line3{{1, 0, 3}, {0, -0.f, -1}}, {inv.y, -inv.z, -1.f}, b, 10.f), 2.f, 1e-4f);
+    BOOST_CHECK_EQUAL(ml::intersect_aabb(ml::line3{{1.01f, 0, 3}, {0, 0, -1}}, inv_z, b, 10.f), std::numeric_limits<float>::infinity());
+    const ml::aabb3 flat{{0, 0, 0}, {1, 1, 0}};
+    BOOST_CHECK_CLOSE(ml::intersect_aabb(ml::line3{{0, 0.5f, 1}, {0, 0, -1}}, inv_z, flat, 10.f), 1.f, 1e-4f);
+}
+
+/** random triangles of different sizes in a box. */
+std::vector<ml::vec3> random_triangles(std::size_t n, random_points& points)
+{
+    std::vector<ml::vec3> vertices(3 * n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        const ml::vec3 c = points.point();
+        const float size = (i % 10 == 0) ? 0.2f : 0.02f;
+        for(int k = 0; k < 3; ++k)
+        {
+            vertices[3 * i + k] = c + points.point() * size;
+        }
+    }
+    return vertices;
+}
+
+/** check the structure of a hierarchy. returns the depth. */
+int check_bvh(const ml::bvh& h, std::uint32_t node, std::vector<int>& referenced, std::uint32_t max_leaf_size)
+{
+    const auto nodes = h.get_nodes();
+    const ml::bvh_node& n = nodes[node];
+    if(n.is_leaf())
+    {
+        BOOST_REQUIRE_LE(n.count, max_leaf_size);
+        for(std::uint32_t i = n.offset; i < n.offset + n.count; ++i)
+        {
+            ++referenced[i];
+            for(int k = 0; k < 3; ++k)
+            {
+                BOOST_REQUIRE(n.bounds.contains(h.get_vertices()[3 * i + k]));
+            }
+        }
+        return 1;
+    }
+
+    // depth-first order.
+    BOOST_REQUIRE_LT(node + 1, n.offset);
+    BOOST_REQUIRE_LT(n.offset, nodes.size());
+    BOOST_REQUIRE(n.bounds.contains(nodes[node + 1].bounds));
+    BOOST_REQUIRE(n.bounds.contains(nodes[n.offset].bounds));
+    return 1 + std::max(check_bvh(h, node + 1, referenced, max_leaf_size), check_bvh(h, n.offset, referenced, max_leaf_size));
+}
+
+BOOST_AUTO_TEST_CASE(bvh_construction)
+{
+    random_points points;
+    const std::vector<ml::vec3> vertices = random_triangles(20000, points);
+
+    ml::bvh_build_options options;
+    options.threads = 1;
+    const ml::bvh serial{vertices, options};
+    options.threads = 4;
+    const ml::bvh parallel{vertices, options};
+
+    // all triangles are referenced once, and the vertices are permuted consistently.
+    std::vector<int> referenced(vertices.size() / 3, 0);
+    BOOST_CHECK_LT(check_bvh(serial, 0, referenced, options.max_leaf_size), ml::bvh::max_depth);
+    BOOST_CHECK(std::all_of(referenced.begin(), referenced.end(), [](int r) { return r == 1; }));
+    for(std::uint32_t i = 0; i < referenced.size(); ++i)
+    {
+        BOOST_REQUIRE(serial.get_vertices()[3 * i] == vertices[3 * serial.triangle_index(i)]);
+    }
+
+    // the parallel construction gives the same tree.
+    BOOST_REQUIRE_EQUAL(serial.get_nodes().size(), parallel.get_nodes().size());
+    for(std::size_t i = 0; i < serial.get_nodes().size(); ++i)
+    {
+        const ml::bvh_node &a = serial.get_nodes()[i], &b = parallel.get_nodes()[i];
+        BOOST_REQUIRE(a.bounds.min == b.bounds.min && a.bounds.max == b.bounds.max);
+        BOOST_REQUIRE_EQUAL(a.offset, b.offset);
+        BOOST_REQUIRE_EQUAL(a.count, b.count);
+    }
+
+    // degenerate input: all triangles at the same place.
+    const std::vector<ml::vec3> same(3 * 100, ml::vec3{1, 2, 3});
+    const ml::bvh degenerate{same};
+    std::vector<int> degenerate_referenced(100, 0);
+    check_bvh(degenerate, 0, degenerate_referenced, 4);
+    BOOST_CHECK(std::all_of(degenerate_referenced.begin(), degenerate_referenced.end(), [](int r) { return r == 1; }));
+
+    BOOST_CHECK(ml::bvh{}.empty());
+    ml::ray_hit hit;
+    BOOST_CHECK(!ml::bvh{}.intersect(ml::line3{{0, 0, 0}, {1, 0, 0}}, hit));
+}
+
+BOOST_AUTO_TEST_CASE(bvh_traversal)
+{
+    random_points points;
+    const std::vector<ml::vec3> vertices = random_triangles(2000, points);
+    const ml::bvh h{vertices};
+
+    int hits = 0;
+    for(int k = 0; k < 2000; ++k)
+    {
+        const ml::line3 ray{points.point(), points.point()};
+
+        // brute force.
+        ml::ray_hit expected;
+        for(std::uint32_t i = 0; i < vertices.size() / 3; ++i)
+        {
+            if(ml::intersect_triangle(ray, vertices[3 * i], vertices[3 * i + 1], vertices[3 * i + 2], expected))
+            {
+                expected.triangle = i;
+            }
+        }
+
+        ml::ray_hit hit;
+        BOOST_REQUIRE_EQUAL(h.intersect(ray, hit), expected.valid());
+        BOOST_REQUIRE_EQUAL(h.occluded(ray), expected.valid());
+        if(expected.valid())
+        {
+            ++hits;
+            BOOST_REQUIRE_EQUAL(hit.t, expected.t);
+            BOOST_REQUIRE(hit.triangle == expected.triangle || hit.t == expected.t);
+            BOOST_REQUIRE(!h.occluded(ray, expected.t));
+            BOOST_REQUIRE(h.occluded(ray, expected.t * 1.01f));
+        }
+    }
+    BOOST_CHECK_GT(hits, 100);
+}
+
+BOOST_AUTO_TEST_CASE(bvh_axis_aligned_rays)
+{
+    // a grid of quads in the plane z = 0, hit by axis-aligned rays on the grid coordinates.
+    std::vector<ml::vec3> vertices;
+    for(int y = 0; y < 8; ++y)
+    {
+        for(int x = 0; x < 8; ++x)
+        {
+            const ml::vec3 a{float(x), float(y), 0}, b{float(x + 1), float(y), 0}, c{float(x + 1), float(y + 1), 0}, d{float(x), float(y + 1), 0};
+            vertices.insert(vertices.end(), {a, b, c, a, c, d});
+        }
+    }
+    const ml::bvh h{vertices};
+
+    ml::ray_hit hit;
+    BOOST_CHECK(h.intersect(ml::line3{{0, 0.5f, 1}, {0, 0, -1}}, hit));
+    BOOST_CHECK_CLOSE(hit.t, 1.f, 1e-4f);
+    BOOST_CHECK(h.occluded(ml::line3{{0, 0.5f, 1}, {0, 0, -1}}));
+
+    int hits = 0;
+    for(int y = 0; y <= 16; ++y)
+    {
+        for(int x = 0; x <= 16; ++x)
+        {
+            for(const float dz: {-1.f, 1.f})
+            {
+                const ml::line3 ray{{x * 0.5f, y * 0.5f, -dz}, {0, 0, dz}};
+
+                ml::ray_hit expected;
+                for(std::size_t i = 0; i < vertices.size(); i += 3)
+                {
+                    if(ml::intersect_triangle(ray, vertices[i], vertices[i + 1], vertices[i + 2], expected))
+                    {
+                        expected.triangle = static_cast<std::uint32_t>(i / 3);
+                    }
+                }
+
+                ml::ray_hit hit;
+                BOOST_REQUIRE_EQUAL(h.intersect(ray, hit), expected.valid());
+                BOOST_REQUIRE_EQUAL(h.occluded(ray), expected.valid());
+                if(expected.valid())
+                {
+                    ++hits;
+                    BOOST_REQUIRE_EQUAL(hit.t, expected.t);
+                }
+            }
+        }
+    }
+    BOOST_CHECK_GT(hits, 500);
+}
+
+#if defined(ML_SIMD_X86)
+
+/**
+ * tolerances of the packet intersection: relative for t, in percent, and absolute for the barycentric
+ * coordinates, which suffer from cancellation. The relative error of 1/det is up to 1.5*2^-12 with
+ * ML_FAST_RCP_ESTIMATE.
+ */
+#    if defined(ML_FAST_RCP_ESTIMATE)
+constexpr float packet_tolerance = 0.1f;
+constexpr float barycentric_tolerance = 1e-3f;
+#    else
+constexpr float packet_tolerance = 1e-3f;
+constexpr float barycentric_tolerance = 1e-4f;
+#    endif
+
+/** whether a ray passes close to an edge of a triangle or starts close to its plane, so that rounding may decide a hit. */
+bool near_edge(const ml::line3& ray, const ml::vec3& v0, const ml::vec3& v1, const ml::vec3& v2)
+{
+    const auto d = [](const ml::vec3& a) { return std::array<double, 3>{a.x, a.y, a.z}; };
+    const auto cross = [](const std::array<double, 3>& a, const std::array<double, 3>& b)
+    { return std::array<double, 3>{a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]}; };
+    const auto dot = [](const std::array<double, 3>& a, const std::array<double, 3>& b)
+    { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; };
+
+    const auto e1 = d(v1 - v0), e2 = d(v2 - v0), s = d(ray.pos - v0), dir = d(ray.dir);
+    const auto p = cross(dir, e2), q = cross(s, e1);
+    const double det = dot(e1, p);
+    if(std::abs(det) < 1e-6)
+    {
+        return true;
+    }
+    const double u = dot(s, p) / det, v = dot(dir, q) / det, t = dot(e2, q) / det;
+    const double eps = 1e-3;
+    return std::abs(u) < eps || std::abs(v) < eps || std::abs(1 - u - v) < eps || std::abs(t) < eps;
+}
+
+/** rays from random points towards random triangles. */
+std::vector<ml::line3> random_rays(std::size_t n, const std::vector<ml::vec3>& vertices, random_points& points)
+{
+    std::vector<ml::line3> rays;
+    for(std::size_t k = 0; k < n; ++k)
+    {
+        const std::size_t i = k % (vertices.size() / 3);
+        const ml::vec3 target = (vertices[3 * i] + vertices[3 * i + 1] + vertices[3 * i + 2]) * (1.f / 3.f);
+        const ml::vec3 pos = points.point();
+        rays.emplace_back(pos, target - pos + points.point() * 0.01f);
+    }
+    return rays;
+}
+
+/** compare a packet result to the scalar test of a triangle. */
+void check_packet_lane(const ml::line3& ray, const ml::vec3* v, float t, float u, float w, bool packet_hit)
+{
+    ml::ray_hit expected;
+    const bool scalar_hit = ml::intersect_triangle(ray, v[0], v[1], v[2], expected);
+    if(near_edge(ray, v[0], v[1], v[2]))
+    {
+        return;
+    }
+    BOOST_REQUIRE_EQUAL(packet_hit, scalar_hit);
+    if(scalar_hit)
+    {
+        BOOST_REQUIRE_CLOSE(t, expected.t, packet_tolerance);
+        BOOST_REQUIRE_SMALL(u - expected.u, barycentric_tolerance);
+        BOOST_REQUIRE_SMALL(w - expected.v, barycentric_tolerance);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(packet_ray_triangle)
+{
+    random_points points;
+    const std::vector<ml::vec3> vertices = random_triangles(37, points);
+    const std::size_t n = vertices.size() / 3;
+    const std::vector<ml::line3> rays = random_rays(512, vertices, points);
+
+    const auto blocks = ml::simd::pack_triangles<4>(vertices);
+    BOOST_REQUIRE_EQUAL(blocks.size(), (n + 3) / 4);
+    BOOST_CHECK_EQUAL(blocks[1].v0[1][2], vertices[3 * 6].y);
+    BOOST_CHECK_EQUAL(blocks[1].e2[0][2], vertices[3 * 6 + 2].x - vertices[3 * 6].x);
+    BOOST_CHECK_EQUAL(blocks.back().e1[0][3], 0.f);
+
+    // one ray against four triangles.
+    int hits = 0;
+    for(const ml::line3& ray: rays)
+    {
+        const ml::simd::ray_x4 r{ray};
+        ml::ray_hit closest, expected;
+        for(std::size_t b = 0; b < blocks.size(); ++b)
+        {
+            const ml::simd::packet_hits_x4 h = ml::simd::intersect(r, blocks[b]);
+            alignas(16) float t[4], u[4], v[4];
+            _mm_store_ps(t, h.t);
+            _mm_store_ps(u, h.u);
+            _mm_store_ps(v, h.v);
+            for(std::size_t lane = 0; lane < 4; ++lane)
+            {
+                const std::size_t i = 4 * b + lane;
+                if(i >= n)
+                {
+                    BOOST_REQUIRE((h.mask & (1 << lane)) == 0);
+                    continue;
+                }
+                check_packet_lane(ray, &vertices[3 * i], t[lane], u[lane], v[lane], (h.mask & (1 << lane)) != 0);
+                if(ml::intersect_triangle(ray, vertices[3 * i], vertices[3 * i + 1], vertices[3 * i + 2], expected))
+                {
+                    expected.triangle = static_cast<std::uint32_t>(i);
+                }
+            }
+            ml::simd::closest_hit(h, closest, static_cast<std::uint32_t>(4 * b));
+        }
+
+        BOOST_REQUIRE_EQUAL(closest.valid(), expected.valid());
+        if(expected.valid())
+        {
+            ++hits;
+            BOOST_REQUIRE_CLOSE(closest.t, expected.t, packet_tolerance);
+            BOOST_REQUIRE(closest.triangle == expected.triangle || std::abs(closest.t - expected.t) <= expected.t * packet_tolerance * 1e-2f);
+        }
+
+        // the maximum ray parameter excludes hits.
+        if(closest.valid())
+        {
+            const std::uint32_t b = closest.triangle / 4;
+            BOOST_REQUIRE_EQUAL(ml::simd::intersect(r, blocks[b], closest.t * 0.5f).mask & (1 << (closest.triangle % 4)), 0);
+        }
+    }
+    BOOST_CHECK_GT(hits, 100);
+
+    // four rays against one triangle.
+    for(std::size_t k = 0; k + 4 <= rays.size(); k += 4)
+    {
+        const ml::simd::rays_x4 r{std::span<const ml::line3, 4>{&rays[k], 4}};
+        const __m128 t_max = _mm_set_ps1(std::numeric_limits<float>::infinity());
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            const ml::simd::packet_hits_x4 h = ml::simd::intersect(r, blocks[i / 4], i % 4, t_max);
+            alignas(16) float t[4], u[4], v[4];
+            _mm_store_ps(t, h.t);
+            _mm_store_ps(u, h.u);
+            _mm_store_ps(v, h.v);
+            for(std::size_t lane = 0; lane < 4; ++lane)
+            {
+                check_packet_lane(rays[k + lane], &vertices[3 * i], t[lane], u[lane], v[lane], (h.mask & (1 << lane)) != 0);
+            }
+        }
+    }
+}
+
+#    if defined(ML_USE_AVX)
+BOOST_AUTO_TEST_CASE(packet_ray_triangle_x8)
+{
+    random_points points;
+    const std::vector<ml::vec3> vertices = random_triangles(37, points);
+    const std::size_t n = vertices.size() / 3;
+    const std::vector<ml::line3> rays = random_rays(512, vertices, points);
+
+    const auto blocks = ml::simd::pack_triangles<8>(vertices);
+    BOOST_REQUIRE_EQUAL(blocks.size(), (n + 7) / 8);
+
+    // one ray against eight triangles.
+    for(const ml::line3& ray: rays)
+    {
+        const ml::simd::ray_x8 r{ray};
+        ml::ray_hit closest, expected;
+        for(std::size_t b = 0; b < blocks.size(); ++b)
+        {
+            const ml::simd::packet_hits_x8 h = ml::simd::intersect(r, blocks[b]);
+            alignas(32) float t[8], u[8], v[8];
+            _mm256_store_ps(t, h.t);
+            _mm256_store_ps(u, h.u);
+            _mm256_store_ps(v, h.v);
+            for(std::size_t lane = 0; lane < 8; ++lane)
+            {
+                const std::size_t i = 8 * b + lane;
+                if(i >= n)
+                {
+                    BOOST_REQUIRE((h.mask & (1 << lane)) == 0);
+                    continue;
+                }
+                check_packet_lane(ray, &vertices[3 * i], t[lane], u[lane], v[lane], (h.mask & (1 << lane)) != 0);
+                if(ml::intersect_triangle(ray, vertices[3 * i], vertices[3 * i + 1], vertices[3 * i + 2], expected))
+                {
+                    expected.triangle = static_cast<std::uint32_t>(i);
+                }
+            }
+            ml::simd::closest_hit(h, closest, static_cast<std::uint32_t>(8 * b));
+        }
+
+        BOOST_REQUIRE_EQUAL(closest.valid(), expected.valid());
+        if(expected.valid())
+        {
+            BOOST_REQUIRE_CLOSE(closest.t, expected.t, packet_tolerance);
+        }
+    }
+
+    // eight rays against one triangle.
+    for(std::size_t k = 0; k + 8 <= rays.size(); k += 8)
+    {
+        const ml::simd::rays_x8 r{std::span<const ml::line3, 8>{&rays[k], 8}};
+        const __m256 t_max = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            const ml::simd::packet_hits_x8 h = ml::simd::intersect(r, blocks[i / 8], i % 8, t_max);
+            alignas(32) float t[8], u[8], v[8];
+            _mm256_store_ps(t, h.t);
+            _mm256_store_ps(u, h.u);
+            _mm256_store_ps(v, h.v);
+            for(std::size_t lane = 0; lane < 8; ++lane)
+            {
+                check_packet_lane(rays[k + lane], &vertices[3 * i], t[lane], u[lane], v[lane], (h.mask & (1 << lane)) != 0);
+            }
+        }
+    }
+}
+#    endif /* defined(ML_USE_AVX) */
+
+#endif /* defined(ML_SIMD_X86) */
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -32,6 +32,34 @@ void random_initialize_real_std_vector(std::size_t n, std::vector<ml::vec4>& v)
     generate(std::begin(v), std::end(v), gen);
 }
 
+/*
+ * Results of different code paths are compared bitwise by default. With FMA, products
+ * and sums are rounded differently (and the compiler may contract expressions), so
+ * the results are compared up to a tolerance instead. Define ML_TEST_TOLERANCE to
+ * select this mode explicitly.
+ */
+#if defined(__FMA__) && !defined(ML_TEST_TOLERANCE)
+#    define ML_TEST_TOLERANCE
+#endif
+
+// compare the first n components of two vectors.
+template<typename V1, typename V2>
+bool same_components(const V1& v1, const V2& v2, int n = 4)
+{
+    for(int c = 0; c < n; ++c)
+    {
+#ifdef ML_TEST_TOLERANCE
+        if(std::abs(v1[c] - v2[c]) > 1e-5f * std::max(1.0f, std::abs(v2[c])))
+#else
+        if(v1[c] != v2[c])
+#endif
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 /*
  * memory alignment.
  */
@@ -288,13 +316,833 @@ BOOST_AUTO_TEST_CASE(mat4x4_randomized_multiplication)
         ml::mat4x4 res = rm1 * rm2;
         ml::simd::mat4x4 res_simd = rm1_simd * rm2_simd;
 
-        BOOST_REQUIRE(res.rows[0] == res_simd.rows[0]);
-        BOOST_REQUIRE(res.rows[1] == res_simd.rows[1]);
-        BOOST_REQUIRE(res.rows[2] == res_simd.rows[2]);
-        BOOST_REQUIRE(res.rows[3] == res_simd.rows[3]);
+        BOOST_REQUIRE(same_components(res.rows[0], res_simd.rows[0]));
+        BOOST_REQUIRE(same_components(res.rows[1], res_simd.rows[1]));
+        BOOST_REQUIRE(same_components(res.rows[2], res_simd.rows[2]));
+        BOOST_REQUIRE(same_components(res.rows[3], res_simd.rows[3]));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mat4x4_column_major)
+{
+    std::vector<ml::vec4> r;
+    random_initialize_real_std_vector(1000, r);
+
+    for(std::size_t i = 0; i + 8 < r.size(); i += 9)
+    {
+        const ml::simd::mat4x4 a{vec_simd_init(r[i]), vec_simd_init(r[i + 1]), vec_simd_init(r[i + 2]), vec_simd_init(r[i + 3])};
+        const ml::simd::mat4x4 b{vec_simd_init(r[i + 4]), vec_simd_init(r[i + 5]), vec_simd_init(r[i + 6]), vec_simd_init(r[i + 7])};
+        const ml::simd::vec4 v = vec_simd_init(r[i + 8]);
+
+        const ml::simd::mat4x4_cm a_cm{a}, b_cm{b};
+
+        // conversions.
+        BOOST_TEST((a_cm.to_row_major() == a));
+        BOOST_TEST((a_cm.transposed().to_row_major() == a.transposed()));
+        for(int c = 0; c < 4; ++c)
+        {
+            BOOST_TEST((a_cm[c] == a.transposed()[c]));
+        }
+
+        // products.
+        BOOST_TEST(same_components(a_cm * v, a * v));
+
+        const ml::simd::mat4x4 p = (a_cm * b_cm).to_row_major(), p_expected = a * b;
+        for(int k = 0; k < 4; ++k)
+        {
+            BOOST_TEST(same_components(p.rows[k], p_expected.rows[k]));
+        }
+
+        BOOST_TEST(((a_cm + b_cm).to_row_major() == a + b));
+        BOOST_TEST(((a_cm - b_cm).to_row_major() == a - b));
+        BOOST_TEST(((a_cm * 2.0f).to_row_major() == a * 2.0f));
+    }
+
+    BOOST_TEST((ml::simd::mat4x4_cm::identity().to_row_major() == ml::simd::mat4x4::identity()));
+
+    // the factories generate the same entries.
+    const ml::vec3 axis = ml::vec3{1, 2, 3}.normalized();
+    BOOST_TEST((ml::matrices::column_major::rotation(axis, 0.7f).to_row_major() == mat_simd_init(ml::matrices::rotation(axis, 0.7f))));
+    BOOST_TEST((ml::matrices::column_major::perspective_projection(1.5f, 1.2f, 0.1f, 100.f).to_row_major()
+                == mat_simd_init(ml::matrices::perspective_projection(1.5f, 1.2f, 0.1f, 100.f))));
+    BOOST_TEST((ml::matrices::column_major::look_at({1, 2, 3}, {0, 0, 0}, {0, 1, 0}).to_row_major()
+                == mat_simd_init(ml::matrices::look_at({1, 2, 3}, {0, 0, 0}, {0, 1, 0}))));
+
+    const ml::simd::vec4 p{1, 2, 3};
+    BOOST_TEST((ml::matrices::column_major::translation(4, 5, 6) * p == ml::simd::vec4{5, 7, 9}));
+    BOOST_TEST((ml::matrices::column_major::scaling(2) * p == ml::simd::vec4{2, 4, 6}));
+}
+
+#    ifdef ML_USE_FMA
+
+BOOST_AUTO_TEST_CASE(fma_products)
+{
+    std::vector<ml::vec4> r;
+    random_initialize_real_std_vector(1000, r);
+
+    for(std::size_t i = 0; i + 4 < r.size(); i += 5)
+    {
+        const ml::simd::vec4 a = vec_simd_init(r[i]), b = vec_simd_init(r[i + 1]);
+
+        // pairwise sums with one rounding each.
+        const float expected_dot = std::fmaf(a.x, b.x, a.y * b.y) + std::fmaf(a.z, b.z, a.w * b.w);
+        BOOST_TEST(a.dot_product(b) == expected_dot);
+
+        // the matrix-vector and matrix products round the same way as the dot product.
+        const ml::simd::mat4x4 m{a, b, vec_simd_init(r[i + 2]), vec_simd_init(r[i + 3])};
+        const ml::simd::vec4 v = vec_simd_init(r[i + 4]);
+        const ml::simd::mat4x4 m_t = m.transposed(), p = m * m;
+        const ml::simd::vec4 mv = m * v;
+        for(int k = 0; k < 4; ++k)
+        {
+            BOOST_TEST(mv[k] == m.rows[k].dot_product(v));
+            for(int c = 0; c < 4; ++c)
+            {
+                BOOST_TEST(p.rows[k][c] == m.rows[k].dot_product(m_t.rows[c]));
+            }
+        }
+
+        // lerp matches the scalar version exactly.
+        const float t = static_cast<float>(i) / static_cast<float>(r.size());
+        const ml::simd::vec4 l = ml::simd::lerp(t, a, b);
+        for(int c = 0; c < 4; ++c)
+        {
+            BOOST_TEST(l[c] == ml::lerp(t, a[c], b[c]));
+        }
+
+#        ifdef ML_SIMD_AVX2
+        const ml::avx::mat4x4 m_avx{m};
+        BOOST_TEST((m_avx * v == mv));
+        BOOST_TEST((ml::simd::mat4x4(m_avx * m_avx) == p));
+#        endif /* ML_SIMD_AVX2 */
+    }
+}
+
+#    endif /* ML_USE_FMA */
+
+#    ifdef ML_SIMD_AVX2
+
+BOOST_AUTO_TEST_CASE(mat4x4_avx_randomized_multiplication)
+{
+    // random multiplication tests against the scalar implementation.
+    for(int i = 0; i < 1000; ++i)
+    {
+        ml::mat4x4 rm1 = get_random_mat<ml::mat4x4, ml::vec4>();
+        ml::mat4x4 rm2 = get_random_mat<ml::mat4x4, ml::vec4>();
+        ml::vec4 rv = get_random_vec4<ml::vec4>();
+
+        ml::avx::mat4x4 rm1_avx{mat_simd_init(rm1)}, rm2_avx{mat_simd_init(rm2)};
+
+        ml::mat4x4 res = rm1 * rm2;
+        ml::avx::mat4x4 res_avx = rm1_avx * rm2_avx;
+
+        BOOST_REQUIRE(res.rows[0] == res_avx.rows[0]);
+        BOOST_REQUIRE(res.rows[1] == res_avx.rows[1]);
+        BOOST_REQUIRE(res.rows[2] == res_avx.rows[2]);
+        BOOST_REQUIRE(res.rows[3] == res_avx.rows[3]);
+
+        BOOST_REQUIRE(rm1 * rv == rm1_avx * vec_simd_init(rv));
+
+        res = rm1 + rm2;
+        res_avx = rm1_avx + rm2_avx;
+        BOOST_REQUIRE(res.rows[0] == res_avx.rows[0]);
+        BOOST_REQUIRE(res.rows[3] == res_avx.rows[3]);
+
+        res = rm1.transposed() - rm2 * 2.f;
+        res_avx = rm1_avx.transposed() - rm2_avx * 2.f;
+        BOOST_REQUIRE(res.rows[1] == res_avx.rows[1]);
+        BOOST_REQUIRE(res.rows[2] == res_avx.rows[2]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mat4x4_avx_batch_transform)
+{
+    std::vector<ml::vec4> v;
+    random_initialize_real_std_vector(101, v);
+
+    std::vector<ml::simd::vec4> v_simd(v.size());
+    std::vector<ml::vec3> p(v.size());
+    for(std::size_t i = 0; i < v.size(); ++i)
+    {
+        v_simd[i] = vec_simd_init(v[i]);
+        p[i] = {v[i].x, v[i].y, v[i].z};
+    }
+
+    const ml::mat4x4 m = get_random_mat<ml::mat4x4, ml::vec4>();
+    const ml::avx::mat4x4 m_avx{mat_simd_init(m)};
+
+    std::vector<ml::vec4> out(v.size()), out_points(v.size());
+    std::vector<ml::simd::vec4> out_avx(v.size()), out_points_avx(v.size());
+    std::vector<ml::vec3> out_dirs(v.size()), out_dirs_avx(v.size());
+
+    ml::transform(m, v, out);
+    ml::transform_points(m, p, out_points);
+    ml::transform_directions(m, p, out_dirs);
+
+    ml::avx::transform(m_avx, v_simd, out_avx);
+    ml::avx::transform_points(m_avx, p, out_points_avx);
+    ml::avx::transform_directions(m_avx, p, out_dirs_avx);
+
+    // FMA rounds differently, so only compare up to an (absolute) tolerance.
+    for(std::size_t i = 0; i < v.size(); ++i)
+    {
+        for(int c = 0; c < 4; ++c)
+        {
+            BOOST_TEST(std::abs(out_avx[i][c] - out[i][c]) <= 1e-5f);
+            BOOST_TEST(std::abs(out_points_avx[i][c] - out_points[i][c]) <= 1e-5f);
+        }
+        for(int c = 0; c < 3; ++c)
+        {
+            BOOST_TEST(std::abs(out_dirs_avx[i][c] - out_dirs[i][c]) <= 1e-5f);
+        }
+    }
+}
+
+#    endif /* ML_SIMD_AVX2 */
+
+/*
+ * batch kernel tests.
+ */
+
+BOOST_AUTO_TEST_CASE(mat4x4_batch_transform)
+{
+    std::vector<ml::vec4> v;
+    random_initialize_real_std_vector(103, v);
+
+    std::vector<ml::simd::vec4> v_simd(v.size());
+    std::vector<ml::vec3> p(v.size());
+    for(std::size_t i = 0; i < v.size(); ++i)
+    {
+        v_simd[i] = vec_simd_init(v[i]);
+        p[i] = {v[i].x, v[i].y, v[i].z};
+    }
+
+    const ml::mat4x4 m = get_random_mat<ml::mat4x4, ml::vec4>();
+    const ml::simd::mat4x4 m_simd = mat_simd_init(m);
+
+    std::vector<ml::vec4> out(v.size()), out_points(v.size());
+    std::vector<ml::simd::vec4> out_simd(v.size()), out_points_simd(v.size());
+    std::vector<ml::vec3> out_dirs(v.size()), out_dirs_simd(v.size());
+
+    ml::transform(m, v, out);
+    ml::transform_points(m, p, out_points);
+    ml::transform_directions(m, p, out_dirs);
+
+    ml::simd::transform(m_simd, v_simd, out_simd);
+    ml::simd::transform_points(m_simd, p, out_points_simd);
+    ml::simd::transform_directions(m_simd, p, out_dirs_simd);
+
+    for(std::size_t i = 0; i < v.size(); ++i)
+    {
+        // the batch kernels match the per-vector path.
+        BOOST_TEST(same_components(out[i], m * v[i]));
+        BOOST_TEST(same_components(out_simd[i], m_simd * v_simd[i]));
+        BOOST_TEST(same_components(out_points_simd[i], m_simd * ml::simd::vec4{p[i]}));
+        BOOST_TEST(same_components(out_dirs_simd[i], m_simd * ml::simd::vec4{p[i], 0}, 3));
+
+        // the SSE and scalar paths sum in different orders.
+        BOOST_TEST(std::abs(out_simd[i].x - out[i].x) <= 1e-5f);
+        BOOST_TEST(std::abs(out_simd[i].w - out[i].w) <= 1e-5f);
+        BOOST_TEST(std::abs(out_points_simd[i].y - out_points[i].y) <= 1e-5f);
+        BOOST_TEST(std::abs(out_dirs_simd[i].z - out_dirs[i].z) <= 1e-5f);
+    }
+
+    // in-place transformation.
+    ml::simd::transform(m_simd, v_simd, v_simd);
+    BOOST_TEST((v_simd == out_simd));
+}
+
+// the batch kernels estimate 1/length (see ml::simd::rsqrt_newton). the relative error is
+// below 2^-21, and the reference values add another rounding error. with a fast precision
+// policy, the reference values are estimated, too.
+constexpr float rsqrt_tolerance =
+  std::is_same_v<ml::precision::default_policy, ml::precision::exact>
+    ? 6e-7f
+    : (std::is_same_v<ml::precision::default_policy, ml::precision::refined> ? 1e-6f : 8e-4f);
+
+// divide_by_w uses ml::rcp. with a fast precision policy, the batch kernels may use different
+// (e.g. 8- or 16-wide) estimates than the per-vector implementation.
+bool divided_close(const ml::simd::vec4& a, const ml::simd::vec4& b)
+{
+    if constexpr(std::is_same_v<ml::precision::default_policy, ml::precision::exact>)
+    {
+        return a == b;
+    }
+    else
+    {
+        for(int c = 0; c < 4; ++c)
+        {
+            if(std::abs(a[c] - b[c]) > rsqrt_tolerance * std::max(std::abs(b[c]), 1.0f))
+            {
+                return false;
+            }
+        }
+        return true;
     }
 }
 
+// check in-place batch kernels against the per-vector implementation for all array lengths up to n.
+void check_vector_kernels(
+  std::size_t n,
+  void (*normalize)(std::span<ml::simd::vec4>),
+  void (*divide_by_w)(std::span<ml::simd::vec4>),
+  void (*clamp)(std::span<ml::simd::vec4>))
+{
+    for(std::size_t k = 0; k <= n; ++k)
+    {
+        std::vector<ml::vec4> v;
+        random_initialize_real_std_vector(k, v);
+
+        std::vector<ml::simd::vec4> v_simd(k);
+        std::transform(v.begin(), v.end(), v_simd.begin(), vec_simd_init);
+        if(k > 2)
+        {
+            v_simd[k / 2] = ml::simd::vec4::zero();
+        }
+
+        auto normalized = v_simd, divided = v_simd, clamped = v_simd;
+        normalize(normalized);
+        divide_by_w(divided);
+        clamp(clamped);
+
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            ml::simd::vec4 expected_divided = v_simd[i];
+            if(expected_divided.w != 0)
+            {
+                expected_divided.divide_by_w();
+                BOOST_TEST(divided_close(divided[i], expected_divided));
+            }
+
+            const ml::simd::vec4 expected_normalized = v_simd[i].normalized();
+            for(int c = 0; c < 4; ++c)
+            {
+                BOOST_TEST(std::abs(normalized[i][c] - expected_normalized[c]) <= rsqrt_tolerance);
+            }
+            BOOST_TEST((clamped[i] == ml::simd::vec4{_mm_min_ps(_mm_max_ps(v_simd[i].data, _mm_setzero_ps()), _mm_set_ps1(1.0f))}));
+        }
+    }
+}
+
+// check the length kernels and the normalization of 3d vectors for all array lengths up to n.
+void check_length_kernels(
+  std::size_t n,
+  void (*lengths)(std::span<const ml::simd::vec4>, std::span<float>),
+  void (*lengths3)(std::span<const ml::vec3>, std::span<float>),
+  void (*normalize3)(std::span<ml::vec3>))
+{
+    for(std::size_t k = 0; k <= n; ++k)
+    {
+        std::vector<ml::vec4> v;
+        random_initialize_real_std_vector(k, v);
+
+        std::vector<ml::simd::vec4> v_simd(k);
+        std::vector<ml::vec3> v3(k);
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            // vary the magnitudes.
+            const float s = std::ldexp(1.0f, static_cast<int>(i % 41) - 20);
+            v_simd[i] = vec_simd_init(v[i]) * s;
+            v3[i] = ml::vec3{v[i].x, v[i].y, v[i].z} * s;
+        }
+        if(k > 2)
+        {
+            v_simd[k / 2] = ml::simd::vec4::zero();
+            v3[k / 2] = ml::vec3::zero();
+
+            // squared lengths below FLT_MIN are treated as zero.
+            v_simd[k / 3] = ml::simd::vec4{1e-30f, 0, 0, 0};
+            v3[k / 3] = ml::vec3{0, 1e-30f, 0};
+        }
+
+        // guard elements behind the output.
+        std::vector<float> out(k + 1, -1.0f), out3(k + 1, -1.0f);
+        lengths(v_simd, out);
+        lengths3(v3, out3);
+
+        auto normalized3 = v3;
+        normalize3(normalized3);
+
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            const float len = v_simd[i].length(), len3 = v3[i].length();
+            const bool tiny = k > 2 && i == k / 3, tiny3 = k > 2 && (i == k / 3 || i == k / 2);
+
+            BOOST_TEST(std::abs(out[i] - (tiny ? 0.0f : len)) <= rsqrt_tolerance * len);
+            BOOST_TEST(std::abs(out3[i] - (tiny3 ? 0.0f : len3)) <= rsqrt_tolerance * len3);
+
+            const ml::vec3 expected3 = tiny3 ? v3[i] : v3[i].normalized();
+            for(int c = 0; c < 3; ++c)
+            {
+                BOOST_TEST(std::abs(normalized3[i][c] - expected3[c]) <= rsqrt_tolerance);
+            }
+        }
+
+        BOOST_TEST(out[k] == -1.0f);
+        BOOST_TEST(out3[k] == -1.0f);
+    }
+}
+
+// check the clip-to-screen kernel against divide_by_w and the viewport transformation for all array lengths up to n.
+void check_clip_to_screen(
+  std::size_t n,
+  void (*clip_to_screen)(std::span<ml::simd::vec4>, const ml::vec3&, const ml::vec3&))
+{
+    const ml::vec3 scale{320.0f, -240.0f, 0.5f}, bias{320.0f, 240.0f, 0.5f};
+
+    for(std::size_t k = 0; k <= n; ++k)
+    {
+        std::vector<ml::vec4> v;
+        random_initialize_real_std_vector(k, v);
+
+        // w has to be non-zero. the last element is a guard.
+        std::vector<ml::simd::vec4> v_simd(k + 1, ml::simd::vec4{-1, -1, -1, -1});
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            v_simd[i] = {v[i].x, v[i].y, v[i].z, 0.5f + std::abs(v[i].w)};
+        }
+
+        auto screen = v_simd;
+        clip_to_screen(std::span{screen}.first(k), scale, bias);
+
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            ml::simd::vec4 expected = v_simd[i];
+            expected.divide_by_w();
+
+            // the kernels may round the viewport transformation differently (e.g. with FMA).
+            for(int c = 0; c < 3; ++c)
+            {
+                const float projected = expected[c] * scale[c];
+                BOOST_TEST(std::abs(screen[i][c] - (projected + bias[c])) <= rsqrt_tolerance * (std::abs(projected) + std::abs(bias[c])));
+            }
+            BOOST_TEST(std::abs(screen[i].w - expected.w) <= rsqrt_tolerance * expected.w);
+        }
+        BOOST_TEST((screen[k] == ml::simd::vec4{-1, -1, -1, -1}));
+    }
+}
+
+// check the color packing kernels against the per-color functions for all array lengths up to n.
+template<typename V>
+void check_color_kernels(
+  std::size_t n,
+  void (*pack_rgba8)(std::span<const V>, std::span<std::uint32_t>),
+  void (*pack_bgra8)(std::span<const V>, std::span<std::uint32_t>),
+  void (*unpack_rgba8)(std::span<const std::uint32_t>, std::span<V>),
+  void (*unpack_bgra8)(std::span<const std::uint32_t>, std::span<V>))
+{
+    std::mt19937 engine{123};
+    std::uniform_real_distribution<float> dist{-0.25f, 1.25f};
+    std::uniform_int_distribution<std::uint32_t> color_dist;
+
+    for(std::size_t k = 0; k <= n; ++k)
+    {
+        // include out-of-range components and (rounded) midpoints between two byte values.
+        std::vector<V> colors(k);
+        std::vector<std::uint32_t> packed(k);
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            colors[i] = i % 3 == 0
+                          ? V{(static_cast<float>(i) + 0.5f) / 255.0f, 2.0f, -1.0f, 0.5f}
+                          : V{dist(engine), dist(engine), dist(engine), dist(engine)};
+            packed[i] = color_dist(engine);
+        }
+
+        // the last element is a guard.
+        std::vector<std::uint32_t> rgba(k + 1, 0xdeadbeef), bgra(k + 1, 0xdeadbeef);
+        pack_rgba8(colors, std::span{rgba}.first(k));
+        pack_bgra8(colors, std::span{bgra}.first(k));
+
+        std::vector<V> unpacked_rgba(k + 1, V{-1, -1, -1, -1}), unpacked_bgra(k + 1, V{-1, -1, -1, -1});
+        unpack_rgba8(packed, std::span{unpacked_rgba}.first(k));
+        unpack_bgra8(packed, std::span{unpacked_bgra}.first(k));
+
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            const ml::vec4 c{colors[i].x, colors[i].y, colors[i].z, colors[i].w};
+            BOOST_TEST(rgba[i] == ml::pack_rgba8(c));
+            BOOST_TEST(bgra[i] == ml::pack_bgra8(c));
+
+            const ml::vec4 expected_rgba = ml::unpack_rgba8(packed[i]), expected_bgra = ml::unpack_bgra8(packed[i]);
+            for(int j = 0; j < 4; ++j)
+            {
+                BOOST_TEST(unpacked_rgba[i][j] == expected_rgba[j]);
+                BOOST_TEST(unpacked_bgra[i][j] == expected_bgra[j]);
+            }
+        }
+        BOOST_TEST(rgba[k] == 0xdeadbeef);
+        BOOST_TEST(bgra[k] == 0xdeadbeef);
+        BOOST_TEST(unpacked_rgba[k][0] == -1.0f);
+        BOOST_TEST(unpacked_bgra[k][3] == -1.0f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(vec4_batch_kernels)
+{
+    check_vector_kernels(37, ml::simd::normalize, ml::simd::divide_by_w, ml::simd::clamp_to_unit_interval);
+    check_length_kernels(37, ml::simd::lengths, ml::simd::lengths, ml::simd::normalize);
+    check_clip_to_screen(37, ml::simd::clip_to_screen);
+
+    // the packed squared lengths are rounded like vec4::length_squared.
+    std::vector<ml::vec4> v;
+    random_initialize_real_std_vector(64, v);
+    for(std::size_t i = 0; i < v.size(); i += 4)
+    {
+        const ml::simd::vec4 a = vec_simd_init(v[i]), b = vec_simd_init(v[i + 1]), c = vec_simd_init(v[i + 2]), d = vec_simd_init(v[i + 3]);
+
+        alignas(16) float len_sqr[4];
+        _mm_store_ps(len_sqr, ml::simd::length_squared_vec4x4(a.data, b.data, c.data, d.data));
+        BOOST_TEST(len_sqr[0] == a.length_squared());
+        BOOST_TEST(len_sqr[1] == b.length_squared());
+        BOOST_TEST(len_sqr[2] == c.length_squared());
+        BOOST_TEST(len_sqr[3] == d.length_squared());
+    }
+    check_color_kernels(37, ml::simd::pack_rgba8, ml::simd::pack_bgra8, ml::simd::unpack_rgba8, ml::simd::unpack_bgra8);
+
+#    ifdef ML_SIMD_AVX2
+    check_vector_kernels(37, ml::avx::normalize, ml::avx::divide_by_w, ml::avx::clamp_to_unit_interval);
+    check_length_kernels(37, ml::avx::lengths, ml::avx::lengths, ml::avx::normalize);
+    check_clip_to_screen(37, ml::avx::clip_to_screen);
+    check_color_kernels(37, ml::avx::pack_rgba8, ml::avx::pack_bgra8, ml::avx::unpack_rgba8, ml::avx::unpack_bgra8);
+#    endif /* ML_SIMD_AVX2 */
+}
+
+#    ifdef ML_SIMD_AVX512
+
+BOOST_AUTO_TEST_CASE(avx512_batch_kernels)
+{
+    check_vector_kernels(37, ml::avx512::normalize, ml::avx512::divide_by_w, ml::avx512::clamp_to_unit_interval);
+    check_length_kernels(37, ml::avx512::lengths, ml::avx512::lengths, ml::avx512::normalize);
+    check_clip_to_screen(37, ml::avx512::clip_to_screen);
+    check_color_kernels(37, ml::avx512::pack_rgba8, ml::avx512::pack_bgra8, ml::avx512::unpack_rgba8, ml::avx512::unpack_bgra8);
+
+    const ml::simd::mat4x4 m = mat_simd_init(get_random_mat<ml::mat4x4, ml::vec4>());
+
+    // check all tail lengths.
+    for(std::size_t k = 0; k <= 21; ++k)
+    {
+        std::vector<ml::vec4> v;
+        random_initialize_real_std_vector(k, v);
+
+        std::vector<ml::simd::vec4> v_simd(k);
+        std::vector<ml::vec3> p(k);
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            v_simd[i] = vec_simd_init(v[i]);
+            p[i] = {v[i].x, v[i].y, v[i].z};
+        }
+
+        // guard elements behind the output to check the tail masks.
+        std::vector<ml::simd::vec4> out(k + 1, ml::simd::vec4::one()), out_points(k + 1, ml::simd::vec4::one());
+        std::vector<ml::vec3> out_dirs(k + 1, ml::vec3::one());
+
+        ml::avx512::transform(m, v_simd, out);
+        ml::avx512::transform_points(m, p, out_points);
+        ml::avx512::transform_directions(m, p, out_dirs);
+
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            const ml::simd::vec4 r = m * v_simd[i], r_points = m * ml::simd::vec4{p[i]}, r_dirs = m * ml::simd::vec4{p[i], 0};
+            for(int c = 0; c < 4; ++c)
+            {
+                BOOST_TEST(std::abs(out[i][c] - r[c]) <= 1e-5f);
+                BOOST_TEST(std::abs(out_points[i][c] - r_points[c]) <= 1e-5f);
+            }
+            for(int c = 0; c < 3; ++c)
+            {
+                BOOST_TEST(std::abs(out_dirs[i][c] - r_dirs[c]) <= 1e-5f);
+            }
+        }
+
+        BOOST_TEST((out[k] == ml::simd::vec4::one()));
+        BOOST_TEST((out_points[k] == ml::simd::vec4::one()));
+        BOOST_TEST((out_dirs[k] == ml::vec3::one()));
+    }
+}
+
+#    endif /* ML_SIMD_AVX512 */
+
+#    ifdef ML_SIMD_DISPATCH
+
+BOOST_AUTO_TEST_CASE(dispatch_batch_kernels)
+{
+    namespace dispatch = ml::dispatch;
+
+    BOOST_TEST((dispatch::active() == dispatch::supported()));
+
+    std::vector<ml::vec4> v;
+    random_initialize_real_std_vector(29, v);
+
+    std::vector<ml::simd::vec4> v_simd(v.size());
+    std::transform(v.begin(), v.end(), v_simd.begin(), vec_simd_init);
+
+    const ml::simd::mat4x4 m = mat_simd_init(get_random_mat<ml::mat4x4, ml::vec4>());
+
+    std::vector<ml::simd::vec4> expected(v.size());
+    ml::simd::transform(m, v_simd, expected);
+
+    // run the kernels of all instruction sets supported by this CPU.
+    for(auto level: {dispatch::isa::sse41, dispatch::isa::avx2, dispatch::isa::avx512})
+    {
+        if(!dispatch::force(level))
+        {
+            BOOST_TEST((level > dispatch::supported()));
+            continue;
+        }
+        BOOST_TEST((dispatch::active() == level));
+
+        check_vector_kernels(37, dispatch::normalize, dispatch::divide_by_w, dispatch::clamp_to_unit_interval);
+        check_length_kernels(37, dispatch::lengths, dispatch::lengths, dispatch::normalize);
+        check_clip_to_screen(37, dispatch::clip_to_screen);
+        check_color_kernels(37, dispatch::pack_rgba8, dispatch::pack_bgra8, dispatch::unpack_rgba8, dispatch::unpack_bgra8);
+
+        std::vector<ml::simd::vec4> out(v.size());
+        dispatch::transform(m, v_simd, out);
+        for(std::size_t i = 0; i < v.size(); ++i)
+        {
+            for(int c = 0; c < 4; ++c)
+            {
+                BOOST_TEST(std::abs(out[i][c] - expected[i][c]) <= 1e-5f);
+            }
+        }
+    }
+
+    dispatch::reset();
+    BOOST_TEST((dispatch::active() == dispatch::supported()));
+}
+
+#    endif /* ML_SIMD_DISPATCH */
+
+/*
+ * vector packet tests.
+ */
+
+BOOST_AUTO_TEST_CASE(vec4x4_load_store)
+{
+    std::vector<ml::vec4> v, w(4);
+    random_initialize_real_std_vector(4, v);
+
+    ml::simd::vec4x4 p = ml::simd::vec4x4::load(v);
+    p.store(w);
+
+    for(int i = 0; i < 4; ++i)
+    {
+        BOOST_TEST((v[i] == w[i]));
+        BOOST_TEST((v[i] == p[i]));
+    }
+
+    std::vector<ml::simd::vec4> v_simd{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}};
+    p = ml::simd::vec4x4::load(v_simd);
+    BOOST_TEST((p == ml::simd::vec4x4{v_simd[0], v_simd[1], v_simd[2], v_simd[3]}));
+    BOOST_TEST((p[2] == ml::simd::vec4(9, 10, 11, 12)));
+}
+
+BOOST_AUTO_TEST_CASE(vec4x4_operations)
+{
+    std::vector<ml::simd::vec4> a{{1, -1, 1, -1}, {1, 2, 3, 4}, {1, 2, 3, 4}, {0, 0, 0, 0}};
+    std::vector<ml::simd::vec4> b{{1, -1, 1, -1}, {4, 3, 2, 1}, {-2, 1, -4, 3}, {1, 2, 3, 4}};
+    const ml::simd::vec4x4 pa = ml::simd::vec4x4::load(a), pb = ml::simd::vec4x4::load(b);
+
+    alignas(16) float d[4];
+    _mm_store_ps(d, ml::simd::dot(pa, pb));
+    BOOST_TEST(d[0] == 4);
+    BOOST_TEST(d[1] == 20);
+    BOOST_TEST(d[2] == 0);
+    BOOST_TEST(d[3] == 0);
+
+    const ml::simd::vec4x4 sum = pa + pb, prod = pa * pb, l = ml::simd::lerp(0.25f, pa, pb);
+    ml::simd::vec4x4 n = pb;
+    n.normalize();
+
+    for(int i = 0; i < 4; ++i)
+    {
+        BOOST_TEST((sum[i] == a[i] + b[i]));
+        BOOST_TEST((prod[i] == a[i] * b[i]));
+        BOOST_TEST(same_components(l[i], ml::lerp(0.25f, a[i], b[i])));
+        BOOST_TEST((n[i] == b[i].normalized()));
+        BOOST_TEST((pa.normalized()[i] == a[i].normalized()));
+    }
+}
+
+#    ifdef ML_USE_AVX
+
+BOOST_AUTO_TEST_CASE(vec4x8_operations)
+{
+    std::vector<ml::vec4> a, b, w(8);
+    random_initialize_real_std_vector(8, a);
+    random_initialize_real_std_vector(8, b);
+
+    const ml::simd::vec4x8 pa = ml::simd::vec4x8::load(a), pb = ml::simd::vec4x8::load(b);
+    pa.store(w);
+
+    alignas(32) float d[8];
+    _mm256_store_ps(d, ml::simd::dot(pa, pb));
+
+    const ml::simd::vec4x8 sum = pa + pb, l = ml::simd::lerp(0.75f, pa, pb), n = pb.normalized();
+    for(int i = 0; i < 8; ++i)
+    {
+        BOOST_TEST((w[i] == a[i]));
+        BOOST_TEST(std::abs(d[i] - ml::dot(a[i], b[i])) <= 1e-6f);
+        BOOST_TEST((a[i] + b[i] == sum[i]));
+        BOOST_TEST(std::abs(l[i].x - ml::lerp(0.75f, a[i], b[i]).x) <= 1e-6f);
+        BOOST_TEST(n[i].length() == 1.0f, boost::test_tools::tolerance(std::max(1e-6f, rsqrt_tolerance)));
+    }
+
+    BOOST_TEST((pa.lo()[3] == pa[3]));
+    BOOST_TEST((pa.hi()[0] == pa[4]));
+}
+
+#    endif /* ML_USE_AVX */
+
+/*
+ * portable backend tests.
+ */
+
+#    ifdef ML_SIMD_PORTABLE
+
+// initialize portable vec4 from simd vec4
+ml::portable::vec4 vec_portable_init(const ml::simd::vec4& v)
+{
+    return {v.x, v.y, v.z, v.w};
+}
+
+// compare portable and simd vec4. FMA contraction may change the last bits of the portable results,
+// and the normalized vectors depend on the precision policy.
+bool portable_close(const ml::portable::vec4& v1, const ml::simd::vec4& v2)
+{
+    for(int c = 0; c < 4; ++c)
+    {
+        if(std::abs(v1[c] - v2[c]) > std::max(1e-5f, rsqrt_tolerance))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(portable_vec4_mat4x4)
+{
+    for(int i = 0; i < 1000; ++i)
+    {
+        const ml::simd::mat4x4 m1 = mat_simd_init(get_random_mat<ml::mat4x4, ml::vec4>());
+        const ml::simd::mat4x4 m2 = mat_simd_init(get_random_mat<ml::mat4x4, ml::vec4>());
+        const ml::simd::vec4 v = vec_simd_init(get_random_vec4<ml::vec4>());
+
+        const ml::portable::mat4x4 pm1{
+          vec_portable_init(m1.rows[0]), vec_portable_init(m1.rows[1]), vec_portable_init(m1.rows[2]), vec_portable_init(m1.rows[3])};
+        const ml::portable::mat4x4 pm2{
+          vec_portable_init(m2.rows[0]), vec_portable_init(m2.rows[1]), vec_portable_init(m2.rows[2]), vec_portable_init(m2.rows[3])};
+        const ml::portable::vec4 pv = vec_portable_init(v);
+
+        // the random entries are small integers, so the products are exact.
+        const ml::simd::mat4x4 prod = m1 * m2, prod_t = prod.transposed();
+        const ml::portable::mat4x4 pprod = pm1 * pm2, pprod_t = pprod.transposed();
+        for(int r = 0; r < 4; ++r)
+        {
+            BOOST_REQUIRE((pprod.rows[r] == vec_portable_init(prod.rows[r])));
+            BOOST_REQUIRE((pprod_t.rows[r] == vec_portable_init(prod_t.rows[r])));
+        }
+
+        BOOST_REQUIRE((pm1 * pv == vec_portable_init(m1 * v)));
+        BOOST_REQUIRE(pv.dot_product(pv) == v.dot_product(v));
+        BOOST_REQUIRE(portable_close(pv.normalized(), v.normalized()));
+        BOOST_REQUIRE((pv + pv * 2.0f - pv / 4.0f == vec_portable_init(v + v * 2.0f - v / 4.0f)));
+    }
+
+    BOOST_TEST(ml::portable::vec4::zero().is_zero());
+    BOOST_TEST(!ml::portable::vec4{}.is_zero());
+    BOOST_TEST((ml::portable::vec4{1, 2, 3, 4} != ml::portable::vec4{1, 2, 3, 0}));
+    BOOST_TEST((ml::portable::mat4x4::identity() * ml::portable::vec4{1, 2, 3, 4} == ml::portable::vec4{1, 2, 3, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(portable_batch_kernels)
+{
+    check_color_kernels(37, ml::portable::pack_rgba8, ml::portable::pack_bgra8, ml::portable::unpack_rgba8, ml::portable::unpack_bgra8);
+
+    const ml::simd::mat4x4 m = mat_simd_init(get_random_mat<ml::mat4x4, ml::vec4>());
+    const ml::portable::mat4x4 pm{
+      vec_portable_init(m.rows[0]), vec_portable_init(m.rows[1]), vec_portable_init(m.rows[2]), vec_portable_init(m.rows[3])};
+
+    // check all tail lengths of the native register width.
+    for(std::size_t k = 0; k <= 37; ++k)
+    {
+        std::vector<ml::vec4> v;
+        random_initialize_real_std_vector(k, v);
+
+        std::vector<ml::simd::vec4> v_simd(k);
+        std::vector<ml::portable::vec4> v_portable(k);
+        std::vector<ml::vec3> p(k);
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            v_simd[i] = vec_simd_init(v[i]);
+            v_portable[i] = vec_portable_init(v_simd[i]);
+            p[i] = {v[i].x, v[i].y, v[i].z};
+        }
+        if(k > 2)
+        {
+            v_simd[k / 2] = ml::simd::vec4::zero();
+            v_portable[k / 2] = ml::portable::vec4::zero();
+        }
+
+        std::vector<ml::simd::vec4> out(k), out_points(k);
+        std::vector<ml::portable::vec4> pout(k), pout_points(k);
+        std::vector<ml::vec3> out_dirs(k), pout_dirs(k);
+
+        ml::simd::transform(m, v_simd, out);
+        ml::simd::transform_points(m, p, out_points);
+        ml::simd::transform_directions(m, p, out_dirs);
+        ml::portable::transform(pm, v_portable, pout);
+        ml::portable::transform_points(pm, p, pout_points);
+        ml::portable::transform_directions(pm, p, pout_dirs);
+
+        auto normalized = v_simd, clamped = v_simd;
+        auto pnormalized = v_portable, pclamped = v_portable;
+        ml::simd::normalize(normalized);
+        ml::simd::clamp_to_unit_interval(clamped);
+        ml::portable::normalize(pnormalized);
+        ml::portable::clamp_to_unit_interval(pclamped);
+
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            BOOST_TEST(portable_close(pout[i], out[i]));
+            BOOST_TEST(portable_close(pout_points[i], out_points[i]));
+            BOOST_TEST(portable_close(ml::portable::vec4{pout_dirs[i], 0}, ml::simd::vec4{out_dirs[i], 0}));
+
+            BOOST_TEST(portable_close(pnormalized[i], normalized[i]));
+            BOOST_TEST((pclamped[i] == vec_portable_init(clamped[i])));
+
+            // the portable normalization is exact, both in full registers and in the tail.
+            const float len_sqr = v_portable[i].length_squared();
+            BOOST_TEST((pnormalized[i] == (len_sqr != 0.0f ? v_portable[i].scale(1.0f / std::sqrt(len_sqr)) : v_portable[i])));
+        }
+
+        // divide_by_w needs non-zero w components.
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            v_simd[i].w = v_portable[i].w = 2.0f + v[i].w;
+        }
+
+        const ml::vec3 scale{320.0f, -240.0f, 0.5f}, bias{320.0f, 240.0f, 0.5f};
+        auto screen = v_simd;
+        auto pscreen = v_portable;
+        ml::simd::clip_to_screen(screen, scale, bias);
+        ml::portable::clip_to_screen(pscreen, scale, bias);
+
+        ml::simd::divide_by_w(v_simd);
+        ml::portable::divide_by_w(v_portable);
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            BOOST_TEST(divided_close(ml::simd::vec4{v_portable[i].x, v_portable[i].y, v_portable[i].z, v_portable[i].w}, v_simd[i]));
+            for(int c = 0; c < 4; ++c)
+            {
+                BOOST_TEST(std::abs(pscreen[i][c] - screen[i][c]) <= std::max(1e-6f, rsqrt_tolerance) * std::max(std::abs(screen[i][c]), 320.0f));
+            }
+        }
+    }
+}
+
+#    endif /* ML_SIMD_PORTABLE */
+
 #endif /* ML_SIMD_X86 */
 
 /*
@@ -326,6 +1174,35 @@ BOOST_AUTO_TEST_CASE(lerp)
     }
 }
 
+BOOST_AUTO_TEST_CASE(color_packing)
+{
+    // RGBA8 stores red in the least significant byte.
+    BOOST_TEST(ml::pack_rgba8({1.0f, 0.0f, 0.5f, 0.2f}) == 0x338000ffu);
+    BOOST_TEST(ml::pack_bgra8({1.0f, 0.0f, 0.5f, 0.2f}) == 0x33ff0080u);
+    BOOST_TEST(ml::pack_rgba8({-1.0f, 2.0f, 0.0f, 1.0f}) == 0xff00ff00u);
+
+    for(std::uint32_t c: {0x00000000u, 0xffffffffu, 0x12345678u, 0x80ff7f01u})
+    {
+        BOOST_TEST(ml::pack_rgba8(ml::unpack_rgba8(c)) == c);
+        BOOST_TEST(ml::pack_bgra8(ml::unpack_bgra8(c)) == c);
+        BOOST_TEST(ml::pack_rgba8(ml::unpack_bgra8(c)) == ((c & 0xff00ff00u) | ((c >> 16) & 0xffu) | ((c & 0xffu) << 16)));
+    }
+
+    // the batch kernels of the default backend.
+    std::vector<ml::vec4> colors;
+    random_initialize_real_std_vector(13, colors);
+    std::vector<std::uint32_t> packed(colors.size());
+    ml::pack_bgra8(colors, packed);
+
+    std::vector<ml::vec4> unpacked(colors.size());
+    ml::unpack_bgra8(packed, unpacked);
+    for(std::size_t i = 0; i < colors.size(); ++i)
+    {
+        BOOST_TEST(packed[i] == ml::pack_bgra8(colors[i]));
+        BOOST_TEST((unpacked[i] == ml::unpack_bgra8(packed[i])));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(radians_degrees)
 {
     /* these are just linear transformations.... */
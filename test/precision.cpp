@@ -0,0 +1,199 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * measure the errors of the precision policies for reciprocals and reciprocal square roots.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+/* boost test framework. */
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#define BOOST_TEST_MODULE precision policy test
+#include <boost/test/unit_test.hpp>
+
+/* C++ headers */
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+/* user headers. */
+#include "ml/all.h"
+
+/*
+ * Helpers.
+ */
+
+/** distance of x to the exact result, in units in the last place of the (correctly rounded) result. */
+double ulp_error(float x, double exact)
+{
+    const float rounded = static_cast<float>(exact);
+    const double ulp = static_cast<double>(std::nextafter(rounded, std::numeric_limits<float>::infinity()) - rounded);
+    return std::abs(static_cast<double>(x) - exact) / ulp;
+}
+
+/** maximum errors of a function. */
+struct error_stats
+{
+    double max_ulp{0};
+    double max_relative{0};
+
+    void add(float x, double exact)
+    {
+        max_ulp = std::max(max_ulp, ulp_error(x, exact));
+        max_relative = std::max(max_relative, std::abs(static_cast<double>(x) - exact) / exact);
+    }
+};
+
+/**
+ * call f(x) for all floats in [1,4), which covers the mantissas for both rcp and rsqrt
+ * (the estimates of rsqrt depend on the parity of the exponent), and for a sample of
+ * the other normal exponents.
+ */
+template<typename F>
+void for_each_input(F&& f)
+{
+    const std::uint32_t begin = std::bit_cast<std::uint32_t>(1.0f);
+    const std::uint32_t end = std::bit_cast<std::uint32_t>(4.0f);
+    for(std::uint32_t i = begin; i < end; ++i)
+    {
+        f(std::bit_cast<float>(i));
+    }
+
+    // stay away from the range limits, where 1/x is denormal.
+    for(int e = -120; e <= 120; ++e)
+    {
+        for(std::uint32_t m = 0; m < (1u << 23); m += 4099)
+        {
+            f(std::ldexp(std::bit_cast<float>(begin | m), e));
+        }
+    }
+}
+
+template<typename P>
+error_stats measure_rcp()
+{
+    error_stats stats;
+    for_each_input([&stats](float x)
+                   { stats.add(ml::rcp<P>(x), 1.0 / static_cast<double>(x)); });
+    return stats;
+}
+
+template<typename P>
+error_stats measure_rsqrt()
+{
+    error_stats stats;
+    for_each_input([&stats](float x)
+                   { stats.add(ml::rsqrt<P>(x), 1.0 / std::sqrt(static_cast<double>(x))); });
+    return stats;
+}
+
+void report(const char* name, const error_stats& stats)
+{
+    BOOST_TEST_MESSAGE(name << ": max error " << stats.max_ulp << " ulp, max relative error " << stats.max_relative);
+}
+
+BOOST_AUTO_TEST_SUITE(precision)
+
+/*
+ * scalar functions.
+ */
+
+BOOST_AUTO_TEST_CASE(exact)
+{
+    const auto rcp = measure_rcp<ml::precision::exact>();
+    const auto rsqrt = measure_rsqrt<ml::precision::exact>();
+    report("rcp<exact>", rcp);
+    report("rsqrt<exact>", rsqrt);
+
+    // 1/x is correctly rounded. 1/sqrtf(x) is rounded twice.
+    BOOST_TEST(rcp.max_ulp <= 0.5);
+    BOOST_TEST(rsqrt.max_ulp <= 1.5);
+}
+
+#ifdef ML_SIMD_X86
+
+BOOST_AUTO_TEST_CASE(refined)
+{
+    const auto rcp = measure_rcp<ml::precision::refined>();
+    const auto rsqrt = measure_rsqrt<ml::precision::refined>();
+    report("rcp<refined>", rcp);
+    report("rsqrt<refined>", rsqrt);
+
+    BOOST_TEST(rcp.max_relative < std::ldexp(1.0, -21));
+    BOOST_TEST(rsqrt.max_relative < std::ldexp(1.0, -21));
+}
+
+BOOST_AUTO_TEST_CASE(estimate)
+{
+    const auto rcp = measure_rcp<ml::precision::estimate>();
+    const auto rsqrt = measure_rsqrt<ml::precision::estimate>();
+    report("rcp<estimate>", rcp);
+    report("rsqrt<estimate>", rsqrt);
+
+    BOOST_TEST(rcp.max_relative <= 1.5 * std::ldexp(1.0, -12));
+    BOOST_TEST(rsqrt.max_relative <= 1.5 * std::ldexp(1.0, -12));
+}
+
+/*
+ * packed functions.
+ */
+
+template<typename P>
+void check_packed()
+{
+    for(float x = 0.01f; x < 1000.0f; x *= 1.37f)
+    {
+        const __m128 v = _mm_setr_ps(x, 2.0f * x, 3.0f * x, 5.0f * x);
+
+        alignas(16) float r[4], s[4];
+        _mm_store_ps(r, ml::simd::rcp<P>(v));
+        _mm_store_ps(s, ml::simd::rsqrt<P>(v));
+
+        const float factors[4] = {1.0f, 2.0f, 3.0f, 5.0f};
+        for(int i = 0; i < 4; ++i)
+        {
+            BOOST_TEST(r[i] == ml::rcp<P>(factors[i] * x));
+            BOOST_TEST(s[i] == ml::rsqrt<P>(factors[i] * x));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(packed)
+{
+    check_packed<ml::precision::exact>();
+    check_packed<ml::precision::refined>();
+    check_packed<ml::precision::estimate>();
+}
+
+#endif /* ML_SIMD_X86 */
+
+/*
+ * library functions.
+ */
+
+BOOST_AUTO_TEST_CASE(vec4_policy)
+{
+    const ml::vec4 v{3, 4, 12, 2};
+
+    // the default policy is exact unless ML_FAST_RCP or ML_FAST_RCP_ESTIMATE is defined.
+    const float tolerance =
+      std::is_same_v<ml::precision::default_policy, ml::precision::estimate>
+        ? 1.5f * std::ldexp(1.0f, -12)
+        : std::ldexp(1.0f, -21);
+
+    BOOST_TEST(v.normalized().length() == 1.0f, boost::test_tools::tolerance(2 * tolerance));
+    BOOST_TEST(v.one_over_length() == 1.0f / std::sqrt(173.0f), boost::test_tools::tolerance(tolerance));
+
+    ml::vec4 d = v;
+    d.divide_by_w();
+    BOOST_TEST(d.x == 1.5f, boost::test_tools::tolerance(tolerance));
+    BOOST_TEST(d.w == 0.5f, boost::test_tools::tolerance(tolerance));
+
+    const ml::plane p{0, 0, 2, -4};
+    BOOST_TEST(p.distance({1, 2, 3}) == 1.0f, boost::test_tools::tolerance(tolerance));
+}
+
+BOOST_AUTO_TEST_SUITE_END();
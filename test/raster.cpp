@@ -0,0 +1,645 @@
+/**
+ * ml - simple header-only mathematics library
+ *
+ * tests for the rasterization helpers.
+ *
+ * \author Felix Lubbe
+ * \copyright Copyright (c) 2026
+ * \license Distributed under the MIT software license (see accompanying LICENSE.txt).
+ */
+
+/* boost test framework. */
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#define BOOST_TEST_MODULE rasterization test
+#include <boost/test/unit_test.hpp>
+
+/* C++ headers */
+#include <random>
+#include <vector>
+
+/* user headers. */
+#include "ml/all.h"
+
+using namespace std;
+
+/*
+ * Helpers.
+ */
+
+/** a triangle in the raw representation of vec2_fixed<4>. */
+struct raw_triangle
+{
+    std::int32_t x[3], y[3];
+};
+
+/** scalar reference for the edge function of the edge from vertex i to vertex i+1. */
+std::int64_t reference_edge(const raw_triangle& t, int i, std::int32_t px, std::int32_t py)
+{
+    const int j = (i + 1) % 3;
+    return std::int64_t(t.x[j] - t.x[i]) * (py - t.y[i]) - std::int64_t(t.y[j] - t.y[i]) * (px - t.x[i]);
+}
+
+/** random triangles and pixels with coordinates in [-1024,1024) and 4 fractional bits. */
+struct random_input
+{
+    mt19937 engine{42};
+    uniform_int_distribution<std::int32_t> dist{-1024 * 16, 1024 * 16 - 1};
+
+    std::int32_t coordinate()
+    {
+        return dist(engine);
+    }
+
+    raw_triangle triangle()
+    {
+        return {{coordinate(), coordinate(), coordinate()}, {coordinate(), coordinate(), coordinate()}};
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(raster)
+
+/*
+ * edge functions.
+ */
+
+BOOST_AUTO_TEST_CASE(edge_function_orientation)
+{
+    // the edge functions use the orientation of vec2::area.
+    const raw_triangle t{{0, 4, 0}, {0, 0, 4}};
+    BOOST_CHECK(ml::vec2(4, 0).area(ml::vec2(0, 4)) > 0);
+    BOOST_CHECK_EQUAL(reference_edge(t, 0, 1, 1), 4);
+    BOOST_CHECK_EQUAL(reference_edge(t, 1, 1, 1), 8);
+    BOOST_CHECK_EQUAL(reference_edge(t, 2, 1, 1), 4);
+    BOOST_CHECK_EQUAL(reference_edge(t, 0, 1, -1), -4);
+}
+
+/*
+ * triangle setup.
+ */
+
+/** count the covered pixels using the edge walker, and compare with the direct evaluation. */
+std::vector<int> rasterize(const ml::triangle_setup& setup, int width, int height)
+{
+    std::vector<int> counts(width * height, 0);
+    if(setup.empty())
+    {
+        return counts;
+    }
+
+    for(ml::edge_walker w{setup}; !w.done(); w.next())
+    {
+        for(int i = 0; i < 3; ++i)
+        {
+            BOOST_REQUIRE_EQUAL(w.value(i), setup.evaluate(i, w.x(), w.y()));
+        }
+        BOOST_REQUIRE_EQUAL(w.inside(), setup.covers(w.x(), w.y()));
+        counts[w.y() * width + w.x()] += w.inside();
+    }
+    return counts;
+}
+
+BOOST_AUTO_TEST_CASE(triangle_setup_walker)
+{
+    const int width = 64, height = 48;
+
+    mt19937 engine{42};
+    uniform_int_distribution<std::int32_t> dist{-8 * 16, 72 * 16};
+    for(int k = 0; k < 200; ++k)
+    {
+        std::int32_t x[3], y[3];
+        for(int i = 0; i < 3; ++i)
+        {
+            x[i] = dist(engine);
+            y[i] = dist(engine);
+        }
+
+        const ml::triangle_setup setup{x, y, width, height};
+        const raw_triangle t{{x[0], x[1], x[2]}, {y[0], y[1], y[2]}};
+        BOOST_CHECK_EQUAL(setup.area, reference_edge(t, 0, x[2], y[2]));
+
+        const auto counts = rasterize(setup, width, height);
+
+        // brute force, including the pixels outside of the bounding box.
+        for(int py = 0; py < height; ++py)
+        {
+            for(int px = 0; px < width; ++px)
+            {
+                const std::int32_t cx = ml::triangle_setup::pixel_center(px), cy = ml::triangle_setup::pixel_center(py);
+                bool inside = setup.area > 0;
+                for(int e = 0; e < 3; ++e)
+                {
+                    inside = inside && reference_edge(t, e, cx, cy) + setup.edges[e].bias >= 0;
+                }
+                BOOST_CHECK_EQUAL(counts[py * width + px], inside ? 1 : 0);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(triangle_setup_fill_rule)
+{
+    const int width = 16, height = 16;
+
+    // the top edge y=0.5 and the left edge x=0.5 pass through the pixel centers of the
+    // first row and column, the bottom edge y=4.5 through the centers of row 4.
+    const std::int32_t x[3] = {8, 8 + 4 * 16, 8}, y[3] = {8, 8, 8 + 4 * 16};
+    const ml::triangle_setup setup{x, y, width, height};
+    BOOST_CHECK(setup.edges[0].is_top_left());
+    BOOST_CHECK(!setup.edges[1].is_top_left());
+    BOOST_CHECK(setup.edges[2].is_top_left());
+
+    const auto counts = rasterize(setup, width, height);
+    for(int py = 0; py < height; ++py)
+    {
+        for(int px = 0; px < width; ++px)
+        {
+            // the diagonal x+y=4 is neither a top nor a left edge.
+            BOOST_CHECK_EQUAL(counts[py * width + px], px + py < 4 ? 1 : 0);
+        }
+    }
+
+    // the other orientation is empty.
+    const std::int32_t x_ccw[3] = {x[0], x[2], x[1]}, y_ccw[3] = {y[0], y[2], y[1]};
+    BOOST_CHECK(ml::triangle_setup(x_ccw, y_ccw, width, height).empty());
+}
+
+BOOST_AUTO_TEST_CASE(triangle_setup_shared_edges)
+{
+    // split a rectangle into four triangles around an inner vertex. each pixel has to be
+    // covered exactly once, also if the inner edges pass through pixel centers.
+    const int width = 24, height = 20;
+    const std::int32_t x0 = 2 * 16, y0 = 3 * 16, x1 = 21 * 16, y1 = 17 * 16;
+    const std::int32_t corners_x[4] = {x0, x1, x1, x0}, corners_y[4] = {y0, y0, y1, y1};
+
+    mt19937 engine{42};
+    uniform_int_distribution<std::int32_t> dist_x{x0 + 1, x1 - 1}, dist_y{y0 + 1, y1 - 1};
+    for(int k = 0; k < 200; ++k)
+    {
+        std::int32_t cx = dist_x(engine), cy = dist_y(engine);
+        if(k % 2 == 0)
+        {
+            // snap to a pixel center.
+            cx = (cx & ~15) | 8;
+            cy = (cy & ~15) | 8;
+        }
+
+        std::vector<int> counts(width * height, 0);
+        for(int i = 0; i < 4; ++i)
+        {
+            const int j = (i + 1) % 4;
+            const std::int32_t x[3] = {corners_x[i], corners_x[j], cx}, y[3] = {corners_y[i], corners_y[j], cy};
+            const auto c = rasterize(ml::triangle_setup{x, y, width, height}, width, height);
+            for(std::size_t p = 0; p < counts.size(); ++p)
+            {
+                counts[p] += c[p];
+            }
+        }
+
+        for(int py = 0; py < height; ++py)
+        {
+            for(int px = 0; px < width; ++px)
+            {
+                const bool in_rect = px >= 2 && px < 21 && py >= 3 && py < 17;
+                BOOST_CHECK_EQUAL(counts[py * width + px], in_rect ? 1 : 0);
+            }
+        }
+    }
+}
+
+#ifndef ML_NO_CNL
+BOOST_AUTO_TEST_CASE(triangle_setup_vec2_fixed)
+{
+    const ml::vec2_fixed<4> v0{1.25f, 2.5f}, v1{10.0f, 3.0f}, v2{4.0f, 9.75f};
+    const ml::triangle_setup setup{v0, v1, v2, 16, 16};
+    BOOST_CHECK_EQUAL(setup.area, cnl::unwrap((v1 - v0).area(v2 - v0)));
+
+    int count = 0;
+    ml::for_each_covered_pixel(setup, [&count](int, int)
+                               { ++count; });
+    BOOST_CHECK(count > 0);
+}
+#endif /* ML_NO_CNL */
+
+/*
+ * tile coverage.
+ */
+
+BOOST_AUTO_TEST_CASE(tile_classification)
+{
+    const int width = 64, height = 48;
+
+    mt19937 engine{7};
+    uniform_int_distribution<std::int32_t> dist{-8 * 16, 72 * 16};
+    for(int k = 0; k < 200; ++k)
+    {
+        std::int32_t x[3], y[3];
+        for(int i = 0; i < 3; ++i)
+        {
+            x[i] = dist(engine);
+            y[i] = dist(engine);
+        }
+        const ml::triangle_setup setup{x, y, width, height};
+
+        for(int size: {4, 8})
+        {
+            for(int ty = 0; ty < height; ty += size)
+            {
+                for(int tx = 0; tx < width; tx += size)
+                {
+                    const std::uint64_t mask = ml::coverage_mask(setup, tx, ty, size);
+                    const std::uint64_t all = size == 8 ? ~std::uint64_t(0) : 0xffff;
+                    switch(ml::classify_tile(setup, tx, ty, size))
+                    {
+                    case ml::tile_coverage::none:
+                        BOOST_CHECK_EQUAL(mask, 0);
+                        break;
+                    case ml::tile_coverage::full:
+                        BOOST_CHECK_EQUAL(mask, all);
+                        break;
+                    case ml::tile_coverage::partial:
+                        break;
+                    }
+
+                    for(int r = 0; r < size; ++r)
+                    {
+                        for(int c = 0; c < size; ++c)
+                        {
+                            BOOST_CHECK_EQUAL((mask >> (r * size + c)) & 1, setup.covers(tx + c, ty + r) ? 1 : 0);
+                        }
+                    }
+
+#ifdef ML_SIMD_X86
+                    if(size == 4)
+                    {
+                        BOOST_CHECK_EQUAL(ml::simd::coverage_mask_4x4(setup, tx, ty), mask);
+                    }
+                    else
+                    {
+                        BOOST_CHECK_EQUAL(ml::simd::coverage_mask_8x8(setup, tx, ty), mask);
+                    }
+#endif
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(tile_traversal)
+{
+    const int width = 61, height = 45;
+
+    mt19937 engine{11};
+    uniform_int_distribution<std::int32_t> dist{-8 * 16, 72 * 16};
+    for(int k = 0; k < 200; ++k)
+    {
+        std::int32_t x[3], y[3];
+        for(int i = 0; i < 3; ++i)
+        {
+            x[i] = dist(engine);
+            y[i] = dist(engine);
+        }
+        const ml::triangle_setup setup{x, y, width, height};
+
+        std::vector<int> counts(width * height, 0);
+        ml::for_each_tile(setup, [&](int tx, int ty, std::uint64_t mask)
+                          {
+                              BOOST_CHECK(tx % 8 == 0 && ty % 8 == 0);
+                              BOOST_CHECK(mask != 0);
+                              for(int bit = 0; bit < 64; ++bit)
+                              {
+                                  if((mask >> bit) & 1)
+                                  {
+                                      const int px = tx + bit % 8, py = ty + bit / 8;
+                                      BOOST_REQUIRE(px < width && py < height);
+                                      ++counts[py * width + px];
+                                  }
+                              }
+                          });
+
+        BOOST_CHECK(counts == rasterize(setup, width, height));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(large_triangles)
+{
+    // the edge values of viewport-sized triangles and of triangles reaching far outside of
+    // the viewport do not fit into 32 bits.
+    const int width = 2560, height = 2048;
+    const raw_triangle triangles[] = {
+      {{-37, width * 16 + 21, 101}, {-13, 29, height * 16 + 5}},
+      {{width * 16 - 3, width * 16 + 40, 7}, {-20, height * 16 + 3, height * 16 - 11}},
+      {{-8000 * 16, 9000 * 16 + 5, 1000 * 16 + 9}, {-6000 * 16 - 3, 500 * 16, 9000 * 16 + 1}},
+      {{-60000 * 16, 60000 * 16 + 7, 1280 * 16 + 3}, {1020 * 16 + 9, 1030 * 16 + 1, 1036 * 16 + 8}}};
+
+    for(const auto& t: triangles)
+    {
+        const ml::triangle_setup setup{t.x, t.y, width, height};
+        BOOST_REQUIRE(!setup.empty());
+        BOOST_CHECK_EQUAL(setup.area, reference_edge(t, 0, t.x[2], t.y[2]));
+
+        // brute force.
+        std::vector<int> expected(width * height, 0);
+        for(int py = 0; py < height; ++py)
+        {
+            for(int px = 0; px < width; ++px)
+            {
+                const std::int32_t cx = ml::triangle_setup::pixel_center(px), cy = ml::triangle_setup::pixel_center(py);
+                bool inside = true;
+                for(int e = 0; e < 3; ++e)
+                {
+                    inside = inside && reference_edge(t, e, cx, cy) + setup.edges[e].bias >= 0;
+                }
+                expected[py * width + px] = inside;
+            }
+        }
+
+        std::vector<int> counts(width * height, 0);
+        ml::for_each_covered_pixel(setup, [&](int px, int py)
+                                   { ++counts[py * width + px]; });
+        BOOST_CHECK(counts == expected);
+
+        std::vector<int> tile_counts(width * height, 0);
+        ml::for_each_tile(setup, [&](int tx, int ty, std::uint64_t mask)
+                          {
+                              for(int bit = 0; bit < 64; ++bit)
+                              {
+                                  if((mask >> bit) & 1)
+                                  {
+                                      ++tile_counts[(ty + bit / 8) * width + tx + bit % 8];
+                                  }
+                              }
+                          });
+        BOOST_CHECK(tile_counts == expected);
+
+        // tiles far from the triangle have edge values beyond the range of the clamped values.
+        for(int ty = 0; ty < height; ty += 8)
+        {
+            for(int tx = 0; tx < width; tx += 8)
+            {
+                const std::uint64_t mask = ml::coverage_mask(setup, tx, ty, 8);
+                const ml::tile_coverage c = ml::classify_tile(setup, tx, ty, 8);
+                BOOST_CHECK(c != ml::tile_coverage::none || mask == 0);
+                BOOST_CHECK(c != ml::tile_coverage::full || mask == ~std::uint64_t(0));
+
+#ifdef ML_SIMD_X86
+                BOOST_CHECK_EQUAL(ml::simd::coverage_mask_8x8(setup, tx, ty), mask);
+                BOOST_CHECK_EQUAL(ml::simd::coverage_mask_4x4(setup, tx, ty), ml::coverage_mask(setup, tx, ty, 4));
+#endif
+            }
+        }
+    }
+}
+
+/*
+ * attribute interpolation.
+ */
+
+/** vertices after the perspective divide, with w = 1/w, and two attributes per vertex. */
+struct interpolation_input
+{
+    ml::vec4 v[3];
+    float attributes[3][2];
+    float clip_w[3];
+
+    interpolation_input()
+    {
+        // clip-space w and screen positions.
+        const float w[3] = {1.5f, 4.0f, 10.0f};
+        const float x[3] = {10.0f, 100.0f, 30.0f}, y[3] = {5.0f, 40.0f, 90.0f};
+        for(int i = 0; i < 3; ++i)
+        {
+            clip_w[i] = w[i];
+            v[i] = ml::vec4{x[i], y[i], 0.1f * static_cast<float>(i + 1), 1.0f / w[i]};
+            attributes[i][0] = static_cast<float>(i == 1);
+            attributes[i][1] = 2.0f * static_cast<float>(i) - 1.0f;
+        }
+    }
+
+    /** reference: perspective-correct interpolation using the screen-space barycentrics. */
+    void reference(double px, double py, double out[2]) const
+    {
+        const auto edge = [this](int i, double x, double y)
+        {
+            const int j = (i + 1) % 3;
+            const double dx = static_cast<double>(v[j].x) - static_cast<double>(v[i].x);
+            const double dy = static_cast<double>(v[j].y) - static_cast<double>(v[i].y);
+            return dx * (y - static_cast<double>(v[i].y)) - dy * (x - static_cast<double>(v[i].x));
+        };
+        const double area = edge(0, static_cast<double>(v[2].x), static_cast<double>(v[2].y));
+        const double b[3] = {edge(1, px, py) / area, edge(2, px, py) / area, edge(0, px, py) / area};
+
+        double one_over_w = 0;
+        for(int i = 0; i < 3; ++i)
+        {
+            one_over_w += b[i] / static_cast<double>(clip_w[i]);
+        }
+        for(int k = 0; k < 2; ++k)
+        {
+            double sum = 0;
+            for(int i = 0; i < 3; ++i)
+            {
+                sum += b[i] * static_cast<double>(attributes[i][k]) / static_cast<double>(clip_w[i]);
+            }
+            out[k] = sum / one_over_w;
+        }
+    }
+
+    ml::triangle_interpolator<2> setup() const
+    {
+        return {v[0], v[1], v[2], attributes[0], attributes[1], attributes[2]};
+    }
+};
+
+/** tolerance of the interpolated attributes. The relative error of 1/w is up to 1.5*2^-12 with ML_FAST_RCP_ESTIMATE. */
+const double interpolation_tolerance = std::is_same_v<ml::precision::default_policy, ml::precision::estimate> ? 2e-3 : 1e-4;
+
+BOOST_AUTO_TEST_CASE(perspective_interpolation)
+{
+    const interpolation_input input;
+    const auto t = input.setup();
+    const double tolerance = interpolation_tolerance;
+
+    // the vertices reproduce their attributes.
+    for(int i = 0; i < 3; ++i)
+    {
+        float out[2];
+        t.interpolate(input.v[i].x, input.v[i].y, out);
+        BOOST_TEST(std::abs(static_cast<double>(out[0] - input.attributes[i][0])) < tolerance);
+        BOOST_TEST(std::abs(static_cast<double>(out[1] - input.attributes[i][1])) < tolerance);
+        BOOST_TEST(t.depth_at(input.v[i].x, input.v[i].y) == input.v[i].z, boost::test_tools::tolerance(1e-4f));
+    }
+
+    for(float y = 10.5f; y < 80.0f; y += 7.0f)
+    {
+        for(float x = 20.5f; x < 90.0f; x += 7.0f)
+        {
+            float out[2];
+            double expected[2];
+            t.interpolate(x, y, out);
+            input.reference(static_cast<double>(x), static_cast<double>(y), expected);
+
+            BOOST_TEST(std::abs(static_cast<double>(out[0]) - expected[0]) < tolerance);
+            BOOST_TEST(std::abs(static_cast<double>(out[1]) - expected[1]) < tolerance);
+        }
+    }
+}
+
+#ifdef ML_SIMD_X86
+BOOST_AUTO_TEST_CASE(perspective_interpolation_simd)
+{
+    const interpolation_input input;
+    const auto t = input.setup();
+
+    const float tolerance = static_cast<float>(interpolation_tolerance) / 10;
+
+    for(float y = 10.5f; y < 80.0f; y += 1.0f)
+    {
+        const __m128 py = _mm_set_ps1(y);
+        const __m128 px = _mm_setr_ps(30.5f, 31.5f, 32.5f, 33.5f);
+
+        __m128 out[2];
+        ml::simd::interpolate(t, px, py, out);
+
+        alignas(16) float a[2][4], depth[4];
+        _mm_store_ps(a[0], out[0]);
+        _mm_store_ps(a[1], out[1]);
+        _mm_store_ps(depth, ml::simd::interpolate_depth(t, px, py));
+
+        for(int i = 0; i < 4; ++i)
+        {
+            float expected[2];
+            t.interpolate(30.5f + static_cast<float>(i), y, expected);
+            BOOST_TEST(std::abs(a[0][i] - expected[0]) <= tolerance);
+            BOOST_TEST(std::abs(a[1][i] - expected[1]) <= tolerance);
+            BOOST_TEST(depth[i] == t.depth_at(30.5f + static_cast<float>(i), y), boost::test_tools::tolerance(1e-5f));
+        }
+
+#    ifdef ML_USE_AVX
+        const __m256 px8 = _mm256_setr_ps(30.5f, 31.5f, 32.5f, 33.5f, 34.5f, 35.5f, 36.5f, 37.5f);
+        __m256 out8[2];
+        ml::simd::interpolate(t, px8, _mm256_set1_ps(y), out8);
+
+        alignas(32) float b[8];
+        _mm256_store_ps(b, out8[1]);
+        for(int i = 0; i < 8; ++i)
+        {
+            float expected[2];
+            t.interpolate(30.5f + static_cast<float>(i), y, expected);
+            BOOST_TEST(std::abs(b[i] - expected[1]) <= tolerance);
+        }
+#    endif
+    }
+}
+#endif
+
+#ifdef ML_SIMD_X86
+
+BOOST_AUTO_TEST_CASE(edge_functions_x4)
+{
+    random_input input;
+    for(int k = 0; k < 1000; ++k)
+    {
+        const raw_triangle t = input.triangle();
+        const ml::simd::edge_functions_x4 edges{t.x, t.y};
+
+        alignas(16) std::int32_t px[4], py[4];
+        for(int i = 0; i < 4; ++i)
+        {
+            px[i] = input.coordinate();
+            py[i] = input.coordinate();
+        }
+        // also hit the vertices, where the edge functions are zero.
+        px[k % 4] = t.x[k % 3];
+        py[k % 4] = t.y[k % 3];
+
+        const __m128i x = _mm_load_si128(reinterpret_cast<const __m128i*>(px));
+        const __m128i y = _mm_load_si128(reinterpret_cast<const __m128i*>(py));
+
+        int expected_mask = 0;
+        for(int i = 0; i < 4; ++i)
+        {
+            bool inside = true;
+            for(int e = 0; e < 3; ++e)
+            {
+                alignas(16) std::int32_t values[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(values), edges.evaluate(e, x, y));
+
+                const std::int64_t expected = reference_edge(t, e, px[i], py[i]);
+                BOOST_CHECK_EQUAL(values[i], expected);
+                inside = inside && expected >= 0;
+            }
+            expected_mask |= inside << i;
+        }
+        BOOST_CHECK_EQUAL(edges.coverage(x, y), expected_mask);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(edge_functions_coverage)
+{
+    // counter-clockwise (in a y-up coordinate system) triangle (0,0), (4,0), (0,4).
+    const std::int32_t x[3] = {0, 4 * 16, 0}, y[3] = {0, 0, 4 * 16};
+    const ml::simd::edge_functions_x4 edges{x, y};
+
+    // pixel centers of the first rows.
+    for(int row = 0; row < 4; ++row)
+    {
+        const __m128i px = _mm_setr_epi32(8, 24, 40, 56);
+        const __m128i py = _mm_set1_epi32(row * 16 + 8);
+
+        // pixel (i,row) is covered if i + row < 4, i.e. the center is strictly below the diagonal.
+        BOOST_CHECK_EQUAL(edges.coverage(px, py), (1 << (4 - row)) - 1);
+    }
+}
+
+#    ifdef ML_SIMD_AVX2
+BOOST_AUTO_TEST_CASE(edge_functions_x8)
+{
+    random_input input;
+    for(int k = 0; k < 1000; ++k)
+    {
+        const raw_triangle t = input.triangle();
+        const ml::simd::edge_functions_x4 edges4{t.x, t.y};
+        const ml::simd::edge_functions_x8 edges8{t.x, t.y};
+
+        alignas(32) std::int32_t px[8], py[8];
+        for(int i = 0; i < 8; ++i)
+        {
+            px[i] = input.coordinate();
+            py[i] = input.coordinate();
+        }
+
+        const __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(px));
+        const __m256i y = _mm256_load_si256(reinterpret_cast<const __m256i*>(py));
+        const int expected =
+          edges4.coverage(_mm256_castsi256_si128(x), _mm256_castsi256_si128(y))
+          | edges4.coverage(_mm256_extracti128_si256(x, 1), _mm256_extracti128_si256(y, 1)) << 4;
+        BOOST_CHECK_EQUAL(edges8.coverage(x, y), expected);
+    }
+}
+#    endif /* ML_SIMD_AVX2 */
+
+#    ifndef ML_NO_CNL
+BOOST_AUTO_TEST_CASE(edge_functions_vec2_fixed)
+{
+    const ml::vec2_fixed<4> v0{1.25f, 2.5f}, v1{10.0f, 3.0f}, v2{4.0f, 9.75f};
+    const ml::simd::edge_functions_x4 edges{v0, v1, v2};
+
+    const ml::vec2_fixed<4> p{5.5f, 4.5f};
+    const __m128i px = _mm_set1_epi32(cnl::unwrap(p.x));
+    const __m128i py = _mm_set1_epi32(cnl::unwrap(p.y));
+
+    const ml::vec2_fixed<4> vertices[3] = {v0, v1, v2};
+    for(int e = 0; e < 3; ++e)
+    {
+        const auto& a = vertices[e];
+        const auto& b = vertices[(e + 1) % 3];
+        BOOST_CHECK_EQUAL(_mm_cvtsi128_si32(edges.evaluate(e, px, py)), cnl::unwrap((b - a).area(p - a)));
+    }
+    BOOST_CHECK_EQUAL(edges.coverage(px, py), 0xf);
+}
+#    endif /* ML_NO_CNL */
+
+#endif /* ML_SIMD_X86 */
+
+BOOST_AUTO_TEST_SUITE_END();